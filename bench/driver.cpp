@@ -0,0 +1,59 @@
+#include <chrono>
+#include <thread>
+#include <boost/asio.hpp>
+
+#include "ai/driver.hpp"
+#include "ai/model/updater/world.hpp"
+#include "util/measure.hpp"
+
+using namespace ai;
+using namespace std::chrono_literals;
+
+namespace {
+
+// 時間を[us]で表す
+double us(std::chrono::nanoseconds _ns) {
+  return std::chrono::duration<double, std::micro>(_ns).count();
+}
+
+void print(const std::string& _name, const util::histogram& _h) {
+  std::cout << boost::format("  %-12s p50 %9.1f us  p99 %9.1f us  p99.9 %9.1f us  "
+                             "max %9.1f us") %
+                   _name % us(_h.percentile(0.5)) % us(_h.percentile(0.99)) %
+                   us(_h.percentile(0.999)) % us(_h.max())
+            << std::endl;
+}
+
+} // namespace
+
+int main() {
+  // ロボットが検出されていない状態で制御周期だけを回し, 起床の遅れを測る
+  // SCHED_FIFOは権限があるときだけ有効になる
+  for (auto hz : {60, 120, 200}) {
+    for (auto rt : {false, true}) {
+      boost::asio::io_service ioService{};
+      model::updater::world world{};
+      const auto cycle = std::chrono::duration_cast<util::DurationType>(1s) / hz;
+      driver d{ioService, cycle, world, model::teamColor::Blue};
+      if (rt) d.realtime(50, 0);
+
+      std::thread t{[&ioService] { ioService.run(); }};
+      std::this_thread::sleep_for(3s);
+      ioService.stop();
+      t.join();
+
+      const auto s = d.statistics();
+      std::cout << boost::format("--- %3d Hz %-8s cycles %5d  overruns %3d  skipped %3d  "
+                                 "%s ---") %
+                       hz % (rt ? "realtime" : "normal") % s.cycles % s.overruns % s.skipped %
+                       (s.realtime ? s.realtime.message() : "ok")
+                << std::endl;
+      print("wakeup", s.wakeup);
+      print("snapshot", s.snapshot);
+      print("controller", s.controller);
+      print("send", s.send);
+      print("signal", s.signal);
+      print("total", s.total);
+    }
+  }
+}
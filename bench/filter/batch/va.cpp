@@ -0,0 +1,58 @@
+#include <array>
+#include <random>
+
+#include "ai/filter/batch/va.hpp"
+#include "ai/filter/va.hpp"
+#include "ai/model/robotStates.hpp"
+#include "ai/util/math/affine.hpp"
+#include "../../util/measure.hpp"
+
+using namespace ai;
+using namespace std::chrono_literals;
+
+constexpr auto capacity = model::robotStates::capacity;
+
+int main() {
+  std::mt19937 mt{0};
+  std::uniform_real_distribution<double> pos(-6000, 6000);
+  std::uniform_real_distribution<double> angle(-4, 4);
+
+  std::array<model::robot, capacity> robots{};
+  model::robotStates states{};
+  for (auto i = 0u; i < capacity; ++i) {
+    robots[i] = model::robot{i, pos(mt), pos(mt), angle(mt)};
+    states.set(i, robots[i]);
+  }
+  model::robotStates::MaskType all;
+  all.setConstant(true);
+
+  const auto mat = util::math::makeTransformationMatrix(1000.0, -500.0, 0.7);
+
+  {
+    std::array<filter::va<model::robot>, capacity> filters{};
+    auto t = util::TimePointType{};
+    report("scalar va x32", measure(100000, [&] {
+             t += 16ms;
+             for (auto i = 0u; i < capacity; ++i) robots[i] = filters[i].update(robots[i], t);
+             keep(robots);
+           }));
+  }
+  {
+    filter::batch::va filter{};
+    auto t = util::TimePointType{};
+    report("batch va", measure(100000, [&] {
+             t += 16ms;
+             filter.update(states, all, t);
+             keep(states);
+           }));
+  }
+
+  report("scalar transform x32", measure(100000, [&] {
+           for (auto& r : robots) r = util::math::transform(mat, r);
+           keep(robots);
+         }));
+  report("batch transform", measure(100000, [&] {
+           util::math::transform(mat, states);
+           keep(states);
+         }));
+}
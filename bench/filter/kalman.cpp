@@ -0,0 +1,135 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "ai/filter/kalman/ball.hpp"
+#include "ai/filter/kalman/robot.hpp"
+#include "ai/filter/observer/ball.hpp"
+#include "ai/filter/va.hpp"
+#include "../util/measure.hpp"
+
+using namespace ai;
+
+// 60Hzで観測したときの周期
+const auto period =
+    std::chrono::duration_cast<util::DurationType>(std::chrono::seconds{1}) / 60;
+
+// 記録したログの代わりに使う, 雑音を含む観測値と真値の組
+template <class T>
+struct sample {
+  T observed;
+  T truth;
+};
+
+// 8の字を描きながら回転するロボット
+std::vector<sample<model::robot>> makeRobotSamples(std::size_t _num) {
+  std::mt19937 mt{0};
+  std::normal_distribution<double> pos(0, 2.0);
+  std::normal_distribution<double> angle(0, 0.01);
+
+  std::vector<sample<model::robot>> samples(_num);
+  for (auto i = 0u; i < _num; ++i) {
+    const auto t = i / 60.0;
+    model::robot r{0, 2000 * std::sin(0.8 * t), 1000 * std::sin(1.6 * t), 2.0 * t};
+    r.theta(std::remainder(r.theta(), 2 * M_PI));
+    r.vx(1600 * std::cos(0.8 * t));
+    r.vy(1600 * std::cos(1.6 * t));
+    r.ax(-1280 * std::sin(0.8 * t));
+    r.ay(-2560 * std::sin(1.6 * t));
+    r.omega(2.0);
+
+    auto o = r;
+    o.x(r.x() + pos(mt));
+    o.y(r.y() + pos(mt));
+    o.theta(r.theta() + angle(mt));
+    samples[i] = {o, r};
+  }
+  return samples;
+}
+
+// 3秒ごとに向きを変えて蹴られ, 滑ったあと転がって止まるボール
+std::vector<sample<model::ball>> makeBallSamples(std::size_t _num) {
+  std::mt19937 mt{0};
+  std::normal_distribution<double> pos(0, 3.0);
+  std::uniform_real_distribution<double> dir(-M_PI, M_PI);
+
+  std::vector<sample<model::ball>> samples(_num);
+  double x = 0, y = 0, vx = 0, vy = 0, peak = 0;
+  for (auto i = 0u; i < _num; ++i) {
+    if (i % 180 == 0) {
+      const auto d = dir(mt);
+      vx           = 4000 * std::cos(d);
+      vy           = 4000 * std::sin(d);
+      peak         = 4000;
+    }
+    const auto speed = std::hypot(vx, vy);
+    const auto decel = speed > peak * 5 / 7 ? 3500.0 : 350.0;
+    const auto dv    = std::min(speed, decel / 60);
+    const auto ratio = speed > 0 ? (speed - dv) / speed : 0;
+    x += (vx + vx * ratio) / 120;
+    y += (vy + vy * ratio) / 120;
+    vx *= ratio;
+    vy *= ratio;
+
+    model::ball b{x, y};
+    b.vx(vx);
+    b.vy(vy);
+    b.ax(ratio > 0 ? -decel * vx / (speed - dv) : 0);
+    b.ay(ratio > 0 ? -decel * vy / (speed - dv) : 0);
+    samples[i] = {model::ball{x + pos(mt), y + pos(mt)}, b};
+  }
+  return samples;
+}
+
+template <class T>
+struct error {
+  double v;
+  double a;
+};
+
+// 最初の1秒を除いた速度, 加速度の二乗平均平方根誤差
+template <class Filter, class T>
+error<T> evaluate(Filter& _filter, const std::vector<sample<T>>& _samples) {
+  auto t     = util::TimePointType{};
+  double ev  = 0;
+  double ea  = 0;
+  auto count = 0u;
+  for (auto i = 0u; i < _samples.size(); ++i) {
+    const auto e = _filter.update(_samples[i].observed, t);
+    t += period;
+    if (i < 60) continue;
+    const auto& r = _samples[i].truth;
+    ev += std::pow(e.vx() - r.vx(), 2) + std::pow(e.vy() - r.vy(), 2);
+    ea += std::pow(e.ax() - r.ax(), 2) + std::pow(e.ay() - r.ay(), 2);
+    ++count;
+  }
+  return {std::sqrt(ev / count), std::sqrt(ea / count)};
+}
+
+template <class Filter, class T>
+void run(const std::string& _name, Filter _filter, const std::vector<sample<T>>& _samples) {
+  auto f = _filter;
+  auto t = util::TimePointType{};
+  auto i = 0u;
+  report(_name, measure(100000, [&] {
+           keep(f.update(_samples[i].observed, t));
+           t += period;
+           if (++i == _samples.size()) i = 0;
+         }));
+
+  auto g       = _filter;
+  const auto e = evaluate(g, _samples);
+  std::cout << boost::format("%-40s velocity RMSE %8.1f mm/s  acceleration RMSE %8.1f mm/s^2") %
+                   "" % e.v % e.a
+            << std::endl;
+}
+
+int main() {
+  const auto robots = makeRobotSamples(60 * 30);
+  run("va<robot>", filter::va<model::robot>{}, robots);
+  run("kalman::robot", filter::kalman::robot{}, robots);
+
+  const auto balls = makeBallSamples(60 * 30);
+  run("observer::ball", filter::observer::ball{balls.front().observed, {}}, balls);
+  run("kalman::ball", filter::kalman::ball{}, balls);
+}
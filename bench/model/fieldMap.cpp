@@ -0,0 +1,56 @@
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "ai/model/fieldMap.hpp"
+#include "ai/model/world.hpp"
+#include "../util/measure.hpp"
+
+using namespace ai;
+
+int main() {
+  model::world world{};
+
+  std::mt19937 mt{0};
+  std::uniform_real_distribution<double> x(-6500, 6500);
+  std::uniform_real_distribution<double> y(-5000, 5000);
+  std::vector<std::array<double, 2>> points(1024);
+  for (auto& p : points) p = {x(mt), y(mt)};
+
+  // 従来のように, 判定のたびにWorldModelからフィールドの情報を取り出す
+  report("world.field() x1024", measure(10000, [&] {
+           std::size_t count = 0;
+           for (const auto& p : points) {
+             count += std::abs(p[0]) > world.field().xMax() - world.field().penaltyLength() &&
+                      std::abs(p[1]) < world.field().penaltyWidth() / 2.0;
+             count += std::abs(p[0]) > world.field().xMax() ||
+                      std::abs(p[1]) > world.field().yMax();
+           }
+           keep(count);
+         }));
+
+  // マップは1度だけ取り出して使い回す
+  report("fieldMap x1024", measure(10000, [&] {
+           const auto map    = world.fieldMap();
+           std::size_t count = 0;
+           for (const auto& p : points) {
+             count += map->penalty(p[0], p[1]) < 0.0;
+             count += map->boundary(p[0], p[1]) < 0.0;
+           }
+           keep(count);
+         }));
+
+  report("fieldMap gradient x1024", measure(10000, [&] {
+           const auto map = world.fieldMap();
+           double sum     = 0.0;
+           for (const auto& p : points) sum += map->gradient(p[0], p[1]).x();
+           keep(sum);
+         }));
+
+  model::field field{};
+  report("fieldMap build", measure(100, [&] {
+           field.length(field.length() == 12000 ? 9000 : 12000);
+           keep(model::fieldMap{field});
+         }));
+}
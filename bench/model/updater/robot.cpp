@@ -0,0 +1,79 @@
+#include <random>
+#include <vector>
+
+#include "ai/model/updater/robot.hpp"
+#include "ssl-protos/vision/detection.pb.h"
+#include "../../util/measure.hpp"
+
+using namespace ai;
+
+constexpr auto numCameras = 8u;
+
+/// @brief   各カメラが両チームのロボットを全て検出しているDetectionパケットを作る
+std::vector<ssl_protos::vision::DetectionFrame> makeFrames() {
+  std::mt19937 mt{0};
+  std::uniform_real_distribution<double> pos(-6000, 6000);
+  std::uniform_real_distribution<double> angle(-3, 3);
+  std::uniform_real_distribution<double> confidence(0.5, 1.0);
+
+  std::vector<ssl_protos::vision::DetectionFrame> frames(numCameras);
+  for (auto c = 0u; c < numCameras; ++c) {
+    auto& f = frames[c];
+    f.set_frame_number(0);
+    f.set_t_capture(0.0);
+    f.set_t_sent(0.0);
+    f.set_camera_id(c);
+    for (auto id = 0u; id < model::world::maxRobots; ++id) {
+      for (auto r : {f.add_robots_blue(), f.add_robots_yellow()}) {
+        r->set_robot_id(id);
+        r->set_x(pos(mt));
+        r->set_y(pos(mt));
+        r->set_orientation(angle(mt));
+        r->set_confidence(confidence(mt));
+        r->set_pixel_x(0);
+        r->set_pixel_y(0);
+      }
+    }
+  }
+  return frames;
+}
+
+void run(const std::string& _name, model::updater::fusionMode _mode) {
+  auto frames = makeFrames();
+
+  model::updater::robot<model::teamColor::Blue> blue{};
+  model::updater::robot<model::teamColor::Yellow> yellow{};
+  blue.fusion(_mode);
+  yellow.fusion(_mode);
+
+  // 全てのカメラのパケットを一度ずつ処理しておく
+  for (const auto& f : frames) {
+    blue.update(f);
+    yellow.update(f);
+  }
+
+  auto camera = 0u;
+  report(_name + " update (1 frame)", measure(100000, [&] {
+           auto& f = frames[camera];
+           f.set_t_capture(f.t_capture() + 1.0 / 60);
+           blue.update(f);
+           yellow.update(f);
+           camera = (camera + 1) % numCameras;
+         }));
+
+  report(_name + " update (all cameras)", measure(10000, [&] {
+           for (auto& f : frames) {
+             f.set_t_capture(f.t_capture() + 1.0 / 60);
+             blue.update(f);
+             yellow.update(f);
+           }
+         }));
+}
+
+int main() {
+  std::cout << boost::format("--- %1% cameras x %2% robots ---") % numCameras %
+                   (2 * model::world::maxRobots)
+            << std::endl;
+  run("maxConfidence", model::updater::fusionMode::maxConfidence);
+  run("weighted", model::updater::fusionMode::weighted);
+}
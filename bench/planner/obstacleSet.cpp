@@ -0,0 +1,61 @@
+#include <array>
+#include <random>
+#include <vector>
+
+#include "ai/planner/obstacleSet.hpp"
+#include "../util/measure.hpp"
+
+using namespace ai;
+
+int main() {
+  std::mt19937 mt{0};
+  std::uniform_real_distribution<double> x(-4500, 4500);
+  std::uniform_real_distribution<double> y(-3000, 3000);
+  std::uniform_real_distribution<double> v(-2000, 2000);
+
+  // 1回の計測で判定する線分
+  std::vector<std::array<double, 4>> segments(1024);
+  for (auto& s : segments) s = {x(mt), y(mt), x(mt), y(mt)};
+
+  // 両チームのロボットとペナルティエリアを想定した数まで障害物を増やす
+  for (auto num : {2u, 8u, 16u, 24u}) {
+    planner::obstacleSet obstacles{};
+    for (auto i = 0u; i < num; ++i) obstacles.add(x(mt), y(mt), 90.0, v(mt), v(mt));
+
+    report(boost::str(boost::format("reference %2d obstacles x1024") % num),
+           measure(10000, [&] {
+             std::size_t count = 0;
+             for (const auto& s : segments) {
+               count += obstacles.obstructedReference(s[0], s[1], s[2], s[3], 150.0);
+             }
+             keep(count);
+           }));
+    report(boost::str(boost::format("simd      %2d obstacles x1024") % num),
+           measure(10000, [&] {
+             std::size_t count = 0;
+             for (const auto& s : segments) {
+               count += obstacles.obstructed(s[0], s[1], s[2], s[3], 150.0);
+             }
+             keep(count);
+           }));
+
+    // 障害物の移動を考慮する判定 (1本の枝を1秒で辿るとする)
+    report(boost::str(boost::format("swept reference %2d obstacles x1024") % num),
+           measure(10000, [&] {
+             std::size_t count = 0;
+             for (const auto& s : segments) {
+               count += obstacles.sweptObstructedReference(s[0], s[1], 0.5, s[2], s[3], 1.5,
+                                                           150.0);
+             }
+             keep(count);
+           }));
+    report(boost::str(boost::format("swept simd      %2d obstacles x1024") % num),
+           measure(10000, [&] {
+             std::size_t count = 0;
+             for (const auto& s : segments) {
+               count += obstacles.sweptObstructed(s[0], s[1], 0.5, s[2], s[3], 1.5, 150.0);
+             }
+             keep(count);
+           }));
+  }
+}
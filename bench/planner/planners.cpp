@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ai/model/world.hpp"
+#include "ai/planner/astar.hpp"
+#include "ai/planner/rrt.hpp"
+#include "../util/measure.hpp"
+
+using namespace ai;
+
+namespace {
+
+// 1つの経路計画問題
+struct scene {
+  std::vector<planner::obstacle> obstacles;
+  planner::position start;
+  planner::position goal;
+};
+
+// 11台対11台のロボットをランダムに置いた場面
+std::vector<scene> randomScenes(std::size_t _num) {
+  std::mt19937 mt{0};
+  std::uniform_real_distribution<double> x(-4500.0, 4500.0);
+  std::uniform_real_distribution<double> y(-3000.0, 3000.0);
+  std::vector<scene> scenes(_num);
+  for (auto& s : scenes) {
+    for (auto i = 0; i < 21; ++i) s.obstacles.push_back({{x(mt), y(mt), 0.0}, 90.0});
+    s.start = {x(mt), y(mt), 0.0};
+    s.goal  = {x(mt), y(mt), 0.0};
+  }
+  return scenes;
+}
+
+// 試合でよく見る配置を模した場面
+std::vector<scene> typicalScenes() {
+  std::vector<scene> scenes;
+
+  // キックオフ: 両チームが自陣に並び, 相手陣地の奥へ向かう
+  {
+    scene s;
+    for (auto i = 0; i < 5; ++i) {
+      s.obstacles.push_back({{-500.0 - 600 * (i % 2), -2000.0 + 1000 * i, 0.0}, 90.0});
+      s.obstacles.push_back({{500.0 + 600 * (i % 2), -2000.0 + 1000 * i, 0.0}, 90.0});
+    }
+    s.obstacles.push_back({{0.0, 0.0, 0.0}, 500.0}); // センターサークル
+    s.start = {-4000.0, 0.0, 0.0};
+    s.goal  = {3500.0, 1500.0, 0.0};
+    scenes.push_back(s);
+  }
+  // 壁: 敵がフリーキックの前に並んでいる
+  {
+    scene s;
+    for (auto i = 0; i < 6; ++i) s.obstacles.push_back({{2500.0, -450.0 + 180 * i, 0.0}, 90.0});
+    s.start = {1000.0, 0.0, 0.0};
+    s.goal  = {4000.0, 0.0, 0.0};
+    scenes.push_back(s);
+  }
+  // 密集: ボールの周りに敵味方が集まっている所を抜ける
+  {
+    scene s;
+    for (auto i = 0; i < 10; ++i) {
+      const auto a = i * M_PI / 5;
+      s.obstacles.push_back({{400.0 * std::cos(a), 400.0 * std::sin(a), 0.0}, 90.0});
+    }
+    s.start = {-3000.0, -2000.0, 0.0};
+    s.goal  = {3000.0, 2000.0, 0.0};
+    scenes.push_back(s);
+  }
+  // 守備: 自陣ペナルティエリアの前に並んだロボットの裏へ回り込む
+  {
+    scene s;
+    for (auto i = 0; i < 8; ++i) {
+      s.obstacles.push_back({{-4500.0 + 200 * (i % 2), -1400.0 + 400 * i, 0.0}, 90.0});
+    }
+    s.start = {-2000.0, -3000.0, 0.0};
+    s.goal  = {-5500.0, 2800.0, 0.0};
+    scenes.push_back(s);
+  }
+  return scenes;
+}
+
+// 経路の長さ
+double lengthOf(const std::vector<planner::position>& _path) {
+  auto l = 0.0;
+  for (auto i = 1u; i < _path.size(); ++i) {
+    l += std::hypot(_path[i].x - _path[i - 1].x, _path[i].y - _path[i - 1].y);
+  }
+  return l;
+}
+
+// 全ての場面で計画を行い, 時間と経路の長さ, 目標位置に着いた割合を表示する
+template <class Planner, class Plan>
+void run(const std::string& _name, const std::vector<scene>& _scenes, Planner& _planner,
+         Plan&& _plan) {
+  auto length  = 0.0;
+  auto reached = 0u;
+  for (const auto& s : _scenes) {
+    _planner.obstacles(s.obstacles);
+    _plan(s);
+    const auto& path = _planner.path();
+    length += lengthOf(path);
+    if (!path.empty() && std::hypot(path.back().x - s.goal.x, path.back().y - s.goal.y) < 1.0) {
+      ++reached;
+    }
+  }
+
+  // 場面を順番に切り替えながら計測する
+  auto i = 0u;
+  report(_name, measure(std::max<std::size_t>(_scenes.size() * 5, 100), [&] {
+           const auto& s = _scenes[i++ % _scenes.size()];
+           _planner.obstacles(s.obstacles);
+           _plan(s);
+           keep(_planner.target());
+         }));
+  std::cout << boost::format("%-40s length %8.1f mm  reached %5.1f %%") % "" %
+                   (length / _scenes.size()) % (100.0 * reached / _scenes.size())
+            << std::endl;
+}
+
+} // namespace
+
+int main() {
+  model::world world{};
+  planner::rrt rrt{world};
+
+  for (const auto& [name, scenes] : {std::make_pair(std::string{"random"}, randomScenes(50)),
+                                     std::make_pair(std::string{"typical"}, typicalScenes())}) {
+    std::cout << "--- " << name << " scenes ---" << std::endl;
+    for (auto num : {300u, 1000u}) {
+      run(boost::str(boost::format("rrt      %4d nodes") % num), scenes, rrt,
+          [&](const scene& _s) { rrt.search(_s.start, _s.goal, num); });
+    }
+    for (auto cellSize : {100.0, 50.0}) {
+      planner::astar grid{world, cellSize};
+      for (auto jps : {false, true}) {
+        grid.jumpPointSearch(jps);
+        run(boost::str(boost::format("%-8s %4d mm") % (jps ? "jps" : "astar") % cellSize),
+            scenes, grid, [&](const scene& _s) { grid.search(_s.start, _s.goal); });
+      }
+    }
+  }
+}
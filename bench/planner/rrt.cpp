@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "ai/model/world.hpp"
+#include "ai/planner/rrt.hpp"
+#include "ai/planner/spatialGrid.hpp"
+#include "ai/util/time.hpp"
+#include "../util/measure.hpp"
+
+using namespace ai;
+
+// 全ノードを走査する最近傍探索 (以前のrrt::searchで行っていたもの)
+uint32_t linearNearest(const std::vector<std::pair<double, double>>& _points, double _x,
+                       double _y) {
+  auto minDist = std::numeric_limits<double>::max();
+  auto result  = 0u;
+  for (auto i = 0u; i < _points.size(); ++i) {
+    const auto d = std::hypot(_points[i].first - _x, _points[i].second - _y);
+    if (d < minDist) {
+      minDist = d;
+      result  = i;
+    }
+  }
+  return result;
+}
+
+int main() {
+  std::mt19937 mt{0};
+  std::uniform_real_distribution<double> x(-4650, 4650);
+  std::uniform_real_distribution<double> y(-3150, 3150);
+
+  std::cout << "--- nearest query ---" << std::endl;
+  for (auto num : {100u, 1000u, 3000u, 10000u}) {
+    std::vector<std::pair<double, double>> points(num);
+    planner::spatialGrid grid{-4650, -3150, 4650, 3150, 300};
+    for (auto i = 0u; i < num; ++i) {
+      points[i] = {x(mt), y(mt)};
+      grid.insert(i, points[i].first, points[i].second);
+    }
+
+    report(boost::str(boost::format("linear  %5d nodes") % num), measure(10000, [&] {
+             keep(linearNearest(points, x(mt), y(mt)));
+           }));
+    report(boost::str(boost::format("grid    %5d nodes") % num), measure(10000, [&] {
+             keep(grid.nearest(x(mt), y(mt)));
+           }));
+  }
+
+  // ロボットが並んでいるフィールドで経路を探索する
+  std::cout << "--- rrt::search ---" << std::endl;
+  model::world world{};
+  planner::rrt rrt{world};
+  std::vector<planner::rrt::obstacle> obstacles;
+  for (auto i = 0; i < 11; ++i) {
+    obstacles.push_back({{-2500.0 + 500 * i, 300.0 * (i % 3 - 1), 0.0}, 300.0});
+  }
+  rrt.obstacles(obstacles);
+
+  for (auto num : {100u, 300u, 1000u, 3000u}) {
+    report(boost::str(boost::format("search  %5d nodes") % num),
+           measure(std::max(20000u / num, 5u), [&] {
+             rrt.search({-4000.0, 0.0, 0.0}, {4000.0, 0.0, 0.0}, num);
+             keep(rrt.target());
+           }));
+  }
+
+  // 1周期に100[mm]ずつ目標へ進むロボットを, 目標位置に着くまで動かす
+  // 周期ごとの計画時間, 木を伸ばした回数, 到着までの周期数(経路の良さ)を比べる
+  std::cout << "--- moving robot ---" << std::endl;
+  auto simulate = [&rrt](const std::string& _name, auto&& _plan) {
+    const planner::position goal{4000.0, 0.0, 0.0};
+    std::vector<double> times;
+    double iterations = 0;
+    std::size_t cycles = 0;
+    constexpr auto runs = 10;
+    for (auto run = 0; run < runs; ++run) {
+      planner::position pos{-4000.0, 0.0, 0.0};
+      for (auto i = 0; i < 300 && std::hypot(goal.x - pos.x, goal.y - pos.y) > 150.0; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        _plan(pos, goal);
+        times.push_back(
+            std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+                .count());
+        iterations += rrt.iterations();
+        const auto t = rrt.target();
+        const auto d = std::hypot(t.x - pos.x, t.y - pos.y);
+        if (d > 0.0) {
+          pos.x += std::min(d, 100.0) * (t.x - pos.x) / d;
+          pos.y += std::min(d, 100.0) * (t.y - pos.y) / d;
+        }
+        ++cycles;
+      }
+    }
+    std::sort(times.begin(), times.end());
+    std::cout << boost::format("%-24s p50 %8.1f us  p99 %8.1f us  iterations %7.1f  "
+                               "cycles %6.1f") %
+                     _name % times.at(times.size() / 2) % times.at(times.size() * 99 / 100) %
+                     (iterations / times.size()) % (static_cast<double>(cycles) / runs)
+              << std::endl;
+  };
+
+  for (auto num : {300u, 1000u}) {
+    simulate(boost::str(boost::format("fixed %d nodes") % num),
+             [&](const auto& _pos, const auto& _goal) { rrt.search(_pos, _goal, num); });
+  }
+  for (auto budget : {1, 2, 5}) {
+    simulate(boost::str(boost::format("anytime %d ms") % budget),
+             [&](const auto& _pos, const auto& _goal) {
+               const auto deadline = util::ClockType::now() + std::chrono::milliseconds(budget);
+               rrt.search(_pos, _goal, deadline);
+             });
+  }
+}
@@ -0,0 +1,60 @@
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "ai/model/world.hpp"
+#include "ai/planner/rrt.hpp"
+#include "ai/planner/service.hpp"
+#include "../util/measure.hpp"
+
+using namespace ai;
+using namespace std::chrono_literals;
+
+int main() {
+  model::world world{};
+
+  // 11台のロボットが互いを避けながらフィールドを横切る
+  std::vector<planner::service::request> requests;
+  for (auto id = 0u; id < 11; ++id) {
+    planner::service::request r{};
+    r.id    = id;
+    r.start = {-4000.0, -2500.0 + 500.0 * id, 0.0};
+    r.goal  = {4000.0, 2500.0 - 500.0 * id, 0.0};
+    for (auto j = 0u; j < 11; ++j) {
+      if (j == id) continue;
+      r.obstacles.push_back({{-2500.0 + 500.0 * j, 300.0 * (j % 3 - 1.0), 0.0}, 300.0});
+    }
+    r.searchNum = 300;
+    requests.push_back(r);
+  }
+
+  // 従来の実装と同じく, 1台ずつ順に計画する
+  std::vector<std::unique_ptr<planner::rrt>> rrts;
+  for (auto i = 0u; i < requests.size(); ++i) {
+    rrts.push_back(std::make_unique<planner::rrt>(world));
+  }
+  report("sequential 11 robots", measure(200, [&] {
+           for (auto i = 0u; i < requests.size(); ++i) {
+             const auto& r = requests[i];
+             rrts[i]->obstacles(r.obstacles);
+             rrts[i]->search(r.start, r.goal, r.searchNum, r.maxBranchLength, r.margin);
+             keep(rrts[i]->target());
+           }
+         }));
+
+  const auto cores = std::max(std::thread::hardware_concurrency(), 1u);
+  for (auto threads : {1u, 2u, 4u, cores}) {
+    planner::service s{world, threads};
+    report(boost::str(boost::format("service %2d threads") % threads), measure(200, [&] {
+             keep(s.plan(requests, util::ClockType::now() + 1s));
+           }));
+  }
+
+  // 期限を設けると, 計画が終わっていなくても期限で結果が返る
+  planner::service s{world, cores};
+  report("service deadline 5ms", measure(200, [&] {
+           keep(s.plan(requests, util::ClockType::now() + 5ms));
+         }));
+  std::cout << boost::format("timeouts: %1%") % s.timeouts() << std::endl;
+}
@@ -0,0 +1,42 @@
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <boost/asio.hpp>
+
+#include "ai/model/command.hpp"
+#include "ai/sender/async.hpp"
+#include "ai/sender/grsim.hpp"
+#include "../util/measure.hpp"
+
+using namespace ai;
+using boost::asio::ip::udp;
+
+int main() {
+  // ループバックに開いたソケットへ送る (受け取らないので, 溢れた分は捨てられる)
+  boost::asio::io_service ioService;
+  udp::socket socket{ioService, udp::endpoint{boost::asio::ip::address_v4::loopback(), 0}};
+  auto grsim =
+      std::make_shared<sender::grsim>(ioService, "127.0.0.1", socket.local_endpoint().port());
+
+  std::vector<model::command> commands;
+  for (auto id = 0u; id < 11; ++id) {
+    model::command command{id};
+    command.vel({1000.0, -500.0, 0.5});
+    commands.push_back(command);
+  }
+
+  // 制御周期のスレッドが1周期分の命令を渡して戻るまでの時間
+  // (続けて呼ぶので, asyncでは送信が追いつかずにまとめたり捨てたりした周期も含まれる)
+  report("grsim", measure(20000, [&] { grsim->sendCommands(commands); }));
+  sender::async async{grsim};
+  report("async(grsim)", measure(20000, [&] { async.sendCommands(commands); }));
+
+  const auto m = async.statistics();
+  std::cout << boost::format("async: batches %d  transmissions %d  dropped %d  coalesced %d") %
+                   m.batches % m.transmissions % m.dropped % m.coalesced
+            << std::endl;
+  std::cout << boost::format("async latency: p50 %d ns  p99 %d ns  max %d ns") %
+                   m.latency.percentile(0.5).count() % m.latency.percentile(0.99).count() %
+                   m.latency.max().count()
+            << std::endl;
+}
@@ -0,0 +1,29 @@
+#include <vector>
+#include <boost/asio.hpp>
+
+#include "ai/model/command.hpp"
+#include "ai/sender/grsim.hpp"
+#include "../util/measure.hpp"
+
+using namespace ai;
+using boost::asio::ip::udp;
+
+int main() {
+  // ループバックに開いたソケットへ送る (受け取らないので, 溢れた分は捨てられる)
+  boost::asio::io_service ioService;
+  udp::socket socket{ioService, udp::endpoint{boost::asio::ip::address_v4::loopback(), 0}};
+  sender::grsim s{ioService, "127.0.0.1", socket.local_endpoint().port()};
+
+  std::vector<model::command> commands;
+  for (auto id = 0u; id < 11; ++id) {
+    model::command command{id};
+    command.vel({1000.0, -500.0, 0.5});
+    commands.push_back(command);
+  }
+
+  // 1周期分(11台)の命令を送るのにかかる時間
+  report("sendCommand x 11", measure(20000, [&] {
+           for (const auto& command : commands) s.sendCommand(command);
+         }));
+  report("sendCommands", measure(20000, [&] { s.sendCommands(commands); }));
+}
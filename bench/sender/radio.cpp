@@ -0,0 +1,25 @@
+#include <vector>
+
+#include "ai/model/command.hpp"
+#include "ai/sender/radio.hpp"
+#include "../util/measure.hpp"
+
+using namespace ai;
+
+int main() {
+  std::vector<model::command> commands;
+  for (auto id = 0u; id < 11; ++id) {
+    model::command command{id};
+    command.vel({1000.0, -500.0, 0.5});
+    command.kick({model::command::kickType::Straight, 6.5});
+    commands.push_back(command);
+  }
+
+  // 1周期分(11台)の命令をフレームに変換するのにかかる時間
+  sender::radio::FrameType frame;
+  auto sequence = 0u;
+  report("radio::encode", measure(100000, [&] {
+           keep(sender::radio::encode(commands.data(), commands.data() + commands.size(),
+                                      sequence++, frame));
+         }));
+}
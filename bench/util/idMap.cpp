@@ -0,0 +1,56 @@
+#include <random>
+#include <unordered_map>
+
+#include "ai/model/world.hpp"
+#include "ai/util/idMap.hpp"
+#include "measure.hpp"
+
+using namespace ai;
+
+// 従来のWorldModelで使われていたロボットのテーブル
+using hashMapType = std::unordered_map<uint32_t, model::robot>;
+using idMapType   = model::world::RobotsList;
+
+template <class Map>
+Map makeRobots(std::size_t _num) {
+  Map robots{};
+  for (auto i = 0u; i < _num; ++i) robots[i] = model::robot{i, 100.0 * i, -100.0 * i, 0.1 * i};
+  return robots;
+}
+
+template <class Map>
+void run(const std::string& _name, std::size_t _num) {
+  const auto robots = makeRobots<Map>(_num);
+
+  report(_name + " copy", measure(100000, [&robots] {
+           auto copy = robots;
+           keep(copy);
+         }));
+
+  std::mt19937 mt{0};
+  std::uniform_int_distribution<uint32_t> id(0, model::world::maxRobots - 1);
+  std::vector<uint32_t> ids(1024);
+  for (auto& i : ids) i = id(mt);
+
+  report(_name + " lookup x1024", measure(10000, [&robots, &ids] {
+           double sum = 0;
+           for (auto i : ids) {
+             if (robots.count(i)) sum += robots.at(i).x();
+           }
+           keep(sum);
+         }));
+
+  report(_name + " iterate", measure(100000, [&robots] {
+           double sum = 0;
+           for (const auto& r : robots) sum += r.second.x();
+           keep(sum);
+         }));
+}
+
+int main() {
+  for (auto num : {8u, 11u, 16u}) {
+    std::cout << boost::format("--- %1% robots ---") % num << std::endl;
+    run<hashMapType>("unordered_map", num);
+    run<idMapType>("idMap", num);
+  }
+}
@@ -0,0 +1,65 @@
+#ifndef AI_BENCH_UTIL_MEASURE_HPP_
+#define AI_BENCH_UTIL_MEASURE_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/format.hpp>
+
+/// @brief   計測結果 (時間の単位はすべて[ns])
+struct measureResult {
+  std::size_t samples;
+  double mean;
+  double p50;
+  double p90;
+  double p99;
+  double max;
+};
+
+/// @brief   値が最適化で消されないようにする
+template <class T>
+inline void keep(T&& _value) {
+  asm volatile("" : : "g"(&_value) : "memory");
+}
+
+/// @brief          関数オブジェクトを繰り返し実行し, 1回あたりの実行時間を計測する
+/// @param _samples 計測する回数
+/// @param _f       計測したい処理
+/// @return         実行時間の統計
+///
+/// 計測前に_samples / 10回(最低1回)の慣らし運転を行う
+template <class Func>
+measureResult measure(std::size_t _samples, Func&& _f) {
+  using clock = std::chrono::steady_clock;
+
+  for (auto i = 0u; i < std::max<std::size_t>(_samples / 10, 1); ++i) _f();
+
+  std::vector<double> times(_samples);
+  for (auto& t : times) {
+    const auto start = clock::now();
+    _f();
+    t = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+  }
+
+  std::sort(times.begin(), times.end());
+  auto percentile = [&times](double _p) {
+    return times.at(static_cast<std::size_t>(_p * (times.size() - 1)));
+  };
+
+  double sum = 0;
+  for (auto t : times) sum += t;
+  return {_samples, sum / _samples, percentile(0.5), percentile(0.9), percentile(0.99),
+          times.back()};
+}
+
+/// @brief          計測結果を表示する
+inline void report(const std::string& _name, const measureResult& _r) {
+  std::cout << boost::format("%-40s mean %10.1f ns  p50 %10.1f  p90 %10.1f  p99 %10.1f  max "
+                             "%10.1f") %
+                   _name % _r.mean % _r.p50 % _r.p90 % _r.p99 % _r.max
+            << std::endl;
+}
+
+#endif // AI_BENCH_UTIL_MEASURE_HPP_
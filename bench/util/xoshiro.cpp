@@ -0,0 +1,32 @@
+#include <random>
+
+#include "ai/util/xoshiro.hpp"
+#include "measure.hpp"
+
+using namespace ai;
+
+int main() {
+  // 以前のrrt::searchのように, 探索のたびに生成器を作ってから探索点を引く
+  for (auto draws : {0u, 200u, 2000u}) {
+    report(boost::str(boost::format("random_device+mt19937 %4d draws") % draws),
+           measure(10000, [draws] {
+             std::random_device rnd;
+             std::mt19937 mt(rnd());
+             std::uniform_real_distribution<> randX(-4650.0, 4650.0);
+             double sum = 0;
+             for (auto i = 0u; i < draws; ++i) sum += randX(mt);
+             keep(sum);
+           }));
+  }
+
+  // 生成器は一度だけ作っておく
+  util::xoshiro x{0};
+  for (auto draws : {0u, 200u, 2000u}) {
+    report(boost::str(boost::format("xoshiro               %4d draws") % draws),
+           measure(10000, [&x, draws] {
+             double sum = 0;
+             for (auto i = 0u; i < draws; ++i) sum += x.uniform(-4650.0, 4650.0);
+             keep(sum);
+           }));
+  }
+}
@@ -19,6 +19,14 @@ velGen::velGen(double _cycle) : cycle_(_cycle) {
   vTarget_ = {0.0, 0.0, 0.0};
 }
 
+double velGen::vMax() {
+  return vMax_;
+}
+
+double velGen::aMax() {
+  return aMax_;
+}
+
 double velGen::fromPos(const double _pos, double _target, const bool _stable) {
   if (std::abs(_pos) > 1000.0) {
     auto sign = boost::math::sign(-_pos);
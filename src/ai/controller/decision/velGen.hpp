@@ -30,6 +30,12 @@ public:
   /// @param  cycle 制御周期
   velGen(double _cycle);
 
+  /// @brief  生成する速度の上限[mm/s]
+  static double vMax();
+
+  /// @brief  生成する速度の変化に使う加速度の上限[mm/s^2]
+  static double aMax();
+
   /// @brief  位置制御計算関数
   /// @param  delta_p  位置偏差(現在位置-目標位置)
   /// @param  stable   安定制御用(true->安定,false->通常)
@@ -20,8 +20,7 @@ feedback::feedback(double _cycle, const model::world& _world)
     : base(vMax_),
       cycle_(_cycle),
       world_(_world),
-      generator_(cycle_),
-      predictor_(cycle_, zeta_, omega_) {
+      generator_(cycle_) {
   // 状態フィードバックゲイン
   // (s+k)^2=s^2+2ks+k^2=0
   // |sI-A|=s^2+(2ζω-k2ω^2)s+ω^2-k1ω^2
@@ -82,12 +81,10 @@ velocity feedback::update(const model::robot& _robot, const velocity& _setpoint)
 }
 
 void feedback::calcRegulator(const model::robot& _robot) {
-  // 前回制御入力をフィールド基準に座標変換
-  double uDirection    = std::atan2(u_[1].y(), u_[1].x());
-  Eigen::Vector3d preU = Eigen::AngleAxisd(uDirection, Eigen::Vector3d::UnitZ()) * u_[1];
-
-  // smith_predictorでvisionの遅れ時間の補間
-  estimatedRobot_ = predictor_.interpolate(_robot, preU);
+  // visionの遅れ時間はdriverでWorldModelを予測するときに補償されているので,
+  // 受け取ったロボットの状態をそのまま使う
+  estimatedRobot_ << _robot.x(), _robot.vx(), _robot.ax(), _robot.y(), _robot.vy(),
+      _robot.ay(), _robot.theta(), _robot.omega(), 0.0;
 
   // ロボット速度を座標変換
   e_[0] = convert(estimatedRobot_.col(1), estimatedRobot_(2, 0));
@@ -124,6 +121,10 @@ void feedback::calcOutput(Eigen::Vector3d _target, double _targetAngle) {
     u_[0] = u_[1];
   }
 
+  // フィールドの情報はここで1度だけ取得する
+  const auto map    = world_.fieldMap();
+  const auto& field = map->field();
+
   double vxMax         = velocityLimit_;
   double vxMin         = velocityLimit_;
   double vyMax         = velocityLimit_;
@@ -133,23 +134,23 @@ void feedback::calcOutput(Eigen::Vector3d _target, double _targetAngle) {
   double width         = marginOutside + marginInside;
   bool flag            = false;
   // フィールドに対して外に出そうなやつは速度制限を強める
-  if (estimatedRobot_(0, 0) > world_.field().xMax() - marginInside) {
-    vxMax *= (world_.field().xMax() + marginOutside - estimatedRobot_(0, 0)) / width;
+  if (estimatedRobot_(0, 0) > field.xMax() - marginInside) {
+    vxMax *= (field.xMax() + marginOutside - estimatedRobot_(0, 0)) / width;
     flag  = true;
     vxMax = std::clamp(vxMax, 0.0, vxMax);
   }
-  if (estimatedRobot_(0, 0) < world_.field().xMin() + marginInside) {
-    vxMin *= (world_.field().xMin() - marginOutside - estimatedRobot_(0, 0)) / width;
+  if (estimatedRobot_(0, 0) < field.xMin() + marginInside) {
+    vxMin *= (field.xMin() - marginOutside - estimatedRobot_(0, 0)) / width;
     flag  = true;
     vxMin = std::clamp(vxMin, vxMin, 0.0);
   }
-  if (estimatedRobot_(1, 0) > world_.field().yMax() - marginInside) {
-    vyMax *= (world_.field().yMax() + marginOutside - estimatedRobot_(1, 0)) / width;
+  if (estimatedRobot_(1, 0) > field.yMax() - marginInside) {
+    vyMax *= (field.yMax() + marginOutside - estimatedRobot_(1, 0)) / width;
     flag  = true;
     vyMax = std::clamp(vyMax, 0.0, vyMax);
   }
-  if (estimatedRobot_(1, 0) < world_.field().yMin() + marginInside) {
-    vyMin *= (world_.field().yMin() - marginOutside - estimatedRobot_(1, 0)) / width;
+  if (estimatedRobot_(1, 0) < field.yMin() + marginInside) {
+    vyMin *= (field.yMin() - marginOutside - estimatedRobot_(1, 0)) / width;
     flag  = true;
     vyMin = std::clamp(vyMin, vyMin, 0.0);
     if (vyMin > 0) {
@@ -194,8 +195,7 @@ void feedback::calcOutput(Eigen::Vector3d _target, double _targetAngle) {
   u_[0].x() = std::clamp(u_[0].x(), -velocityLimit_, velocityLimit_);
   u_[0].y() = std::clamp(u_[0].y(), -velocityLimit_, velocityLimit_);
 
-  if (std::abs(estimatedRobot_(0, 0)) > world_.field().xMax() + marginOutside ||
-      std::abs(estimatedRobot_(1, 0)) > world_.field().yMax() + marginOutside) {
+  if (map->outside(estimatedRobot_(0, 0), estimatedRobot_(1, 0), marginOutside)) {
     double toCenterAngle = std::atan2(-estimatedRobot_(1, 0), -estimatedRobot_(0, 0));
     if (std::abs(util::math::wrapToPi(toCenterAngle - (_targetAngle + estimatedRobot_(2, 0)))) >
         half_pi<double>()) {
@@ -6,7 +6,6 @@
 #include <memory>
 #include <vector>
 
-#include "ai/controller/decision/predictor.hpp"
 #include "ai/controller/decision/velGen.hpp"
 #include "ai/model/world.hpp"
 #include "base.hpp"
@@ -40,7 +39,6 @@ private:
   Eigen::Vector3d u_[2];           // 操作量(1フレーム前まで)
   Eigen::Vector3d e_[2];           // 偏差(1フレーム前まで)
   decision::velGen generator_;
-  decision::predictor predictor_;
 
   // レギュレータ部
   void calcRegulator(const model::robot& _robot);
@@ -3,12 +3,20 @@
 #include <variant>
 #include <boost/format.hpp>
 #include "driver.hpp"
+#include "ai/util/realtime.hpp"
 
 namespace ai {
 
 driver::driver(boost::asio::io_service& _ioService, util::DurationType _cycle,
-               const model::updater::world& _world, model::teamColor _color)
-    : timer_(_ioService), cycle_(_cycle), world_(_world), teamColor_(_color) {
+               const model::updater::world& _world, model::teamColor _color,
+               std::size_t _threads)
+    : timer_(_ioService),
+      cycle_(_cycle),
+      world_(_world),
+      teamColor_(_color),
+      predicted_(_world.snapshot()),
+      pending_(0),
+      pool_(_threads > 0 ? std::make_unique<util::threadPool>(_threads) : nullptr) {
   // タイマが開始されたらdriver::main_loop()が呼び出されるように設定
   timer_.async_wait(
       [this](auto&& _error) { mainLoop(std::forward<decltype(_error)>(_error)); });
@@ -30,7 +38,7 @@ boost::signals2::connection driver::onCommandUpdated(
 }
 
 void driver::velocityLimit(double _limit) {
-  std::lock_guard<std::mutex> lock(mutex_);
+  std::scoped_lock lock(mutex_, controllerMutex_);
   for (auto&& _meta : robotsMetadata_) std::get<1>(_meta.second)->velocityLimit(_limit);
 }
 
@@ -44,6 +52,7 @@ void driver::registerRobot(uint32_t _id, ControllerType _controller, SenderType
 void driver::unregisterRobot(uint32_t _id) {
   std::lock_guard<std::mutex> lock(mutex_);
   robotsMetadata_.erase(_id);
+  predictor_.clear(_id);
 }
 
 bool driver::registered(uint32_t _id) const {
@@ -65,47 +74,186 @@ void driver::updateCommand(const model::command& _command) {
   std::get<0>(robotsMetadata_.at(id)) = _command;
 }
 
+std::shared_ptr<const model::world> driver::predicted() const {
+  return std::atomic_load(&predicted_);
+}
+
+void driver::realtime(int _priority, int _cpu) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  realtime_ = std::make_pair(_priority, _cpu);
+}
+
+driver::cycleStatistics driver::statistics() const {
+  std::lock_guard<std::mutex> lock(statisticsMutex_);
+  return statistics_;
+}
+
+void driver::resetStatistics() {
+  std::lock_guard<std::mutex> lock(statisticsMutex_);
+  statistics_ = cycleStatistics{};
+}
+
 void driver::mainLoop(const boost::system::error_code& _error) {
   // TODO: エラーが発生したことを上の階層に伝える仕組みを実装する
   if (_error) return;
 
   // 処理の開始時刻を記録
-  const auto startTime = util::ClockType::now();
+  const auto startTime = SteadyClockType::now();
 
-  std::lock_guard<std::mutex> lock(mutex_);
+  // 最初の周期は, 開始時刻を今の時刻とする
+  if (deadline_ == SteadyClockType::time_point{}) deadline_ = startTime;
+
+  // この周期で使う値はここでまとめて写し, 以降の処理はmutex_を持たずに行う
+  // こうすればControllerの計算や送信の間も, 戦略側から命令を更新できる
+  std::optional<std::pair<int, int>> realtime;
+  model::teamColor color;
+  std::shared_ptr<const model::world> world;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    realtime = std::exchange(realtime_, std::nullopt);
+    color    = teamColor_;
+    work_.clear();
+    for (const auto& meta : robotsMetadata_) work_.push_back(meta.second);
+
+    // このループでのWorldModelを取得し, この周期の送信期限(次の周期の開始時刻)まで進める
+    // Visionの遅れ時間の補償はここでまとめて行い, 各Controllerでは行わない
+    // 予測器はプロジェクト共通の時計で時刻を扱うので, 送信期限をその時計での時刻に直す
+    const auto sendDeadline = util::ClockType::now() + (deadline_ + cycle_ - startTime);
+    world                   = std::make_shared<const model::world>(
+        predictor_.predict(*world_.snapshot(), color, sendDeadline));
+  }
+  std::atomic_store(&predicted_, world);
+
+  // スケジューリングの設定はタイマを待っているスレッド自身で行う
+  if (realtime) {
+    std::error_code result{};
+    try {
+      if (realtime->first > 0) util::realtimePriority(realtime->first);
+      if (realtime->second >= 0) util::cpuAffinity(realtime->second);
+    } catch (const std::system_error& e) {
+      result = e.code();
+    }
+    std::lock_guard<std::mutex> statisticsLock(statisticsMutex_);
+    statistics_.realtime = result;
+  }
+  const auto snapshotTime = SteadyClockType::now();
+
+  // 登録されたロボットの命令をControllerに通す
+  // ロボットごとの計算はスナップショット以外を共有しないので, ワーカースレッドで並列に行う
+  results_.assign(work_.size(), std::nullopt);
+  {
+    std::lock_guard<std::mutex> controllerLock(controllerMutex_);
+    if (pool_) {
+      {
+        std::lock_guard<std::mutex> workerLock(workerMutex_);
+        pending_ = work_.size();
+      }
+      for (auto i = 0u; i < work_.size(); ++i) {
+        pool_->post([this, &world = *world, color, i] { run(world, color, i); });
+      }
+      // 結果はworldを参照しているので, 周期の期限を過ぎても全て終わるまで待つ
+      std::unique_lock<std::mutex> workerLock(workerMutex_);
+      done_.wait(workerLock, [this] { return pending_ == 0; });
+      if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+    } else {
+      for (auto i = 0u; i < work_.size(); ++i) results_[i] = control(*world, color, work_[i]);
+    }
+  }
+  commands_.clear();
+  for (auto i = 0u; i < work_.size(); ++i) {
+    if (!results_[i]) continue;
+    commands_.emplace_back(std::move(*results_[i]), std::get<2>(work_[i]).get());
+  }
+  const auto controllerTime = SteadyClockType::now();
 
-  // このループでのWorldModelを生成
-  const auto world = world_.value();
+  // Senderごとにまとめて送信し, 次の周期の予測に使うために記録しておく
+  // Senderは普通1つか2つしかないので, 線形探索で振り分ける
+  for (auto& batch : batches_) batch.second.clear();
+  for (const auto& [command, sender] : commands_) {
+    auto it = std::find_if(batches_.begin(), batches_.end(),
+                           [sender = sender](const auto& _b) { return _b.first == sender; });
+    if (it == batches_.end()) {
+      it = batches_.emplace(batches_.end(), sender, std::vector<model::command>{});
+    }
+    it->second.push_back(command);
+  }
+  for (const auto& [sender, commands] : batches_) {
+    if (commands.empty()) continue;
+    sender->sendCommands(commands);
+    const auto sent = util::ClockType::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& command : commands) predictor_.record(command, sent);
+  }
+  const auto sendTime = SteadyClockType::now();
+
+  // 登録された関数があればそれを呼び出す
+  for (const auto& it : commands_) commandUpdated_(it.first);
+  const auto endTime = SteadyClockType::now();
 
-  // 登録されたロボットの命令をControllerを通してから送信する
-  for (auto&& meta : robotsMetadata_) process(world, meta.second);
+  // 登録を解除されたロボットのControllerやSenderを次の周期まで残さない
+  work_.clear();
 
-  // 処理の開始時刻からcycle_経過した後に再度main_loop()が呼び出されるように設定
-  timer_.expires_at(startTime + cycle_);
+  // 次の周期の開始時刻は処理の終わった時刻ではなく, 今の周期の開始時刻から決める
+  // こうすれば処理時間や起床の遅れが周期に蓄積しない
+  const auto scheduled = deadline_;
+  deadline_ += cycle_;
+  const auto overrun = endTime > deadline_;
+  auto skipped       = 0l;
+  if (endTime >= deadline_ + cycle_) {
+    // 1周期以上遅れたときは, 遅れを取り戻そうと続けて処理せずに過ぎた周期を飛ばす
+    skipped = (endTime - deadline_) / cycle_;
+    deadline_ += skipped * cycle_;
+  }
+
+  {
+    std::lock_guard<std::mutex> statisticsLock(statisticsMutex_);
+    ++statistics_.cycles;
+    statistics_.overruns += overrun;
+    statistics_.skipped += skipped;
+    statistics_.wakeup.record(startTime - scheduled);
+    statistics_.snapshot.record(snapshotTime - startTime);
+    statistics_.controller.record(controllerTime - snapshotTime);
+    statistics_.send.record(sendTime - controllerTime);
+    statistics_.signal.record(endTime - sendTime);
+    statistics_.total.record(endTime - startTime);
+  }
+
+  // 次の周期の開始時刻にmain_loop()が呼び出されるように設定
+  timer_.expires_at(deadline_);
   timer_.async_wait(
       [this](auto&& _error) { mainLoop(std::forward<decltype(_error)>(_error)); });
 }
 
-void driver::process(const model::world& _world, MetadataType& _metadata) {
-  auto command  = std::get<0>(_metadata);
-  const auto id = command.id();
-  const auto robots =
-      static_cast<bool>(teamColor_) ? _world.robotsYellow() : _world.robotsBlue();
+std::optional<model::command> driver::control(const model::world& _world,
+                                              model::teamColor _color,
+                                              const MetadataType& _metadata) const {
+  auto command      = std::get<0>(_metadata);
+  const auto id     = command.id();
+  const auto robots = static_cast<bool>(_color) ? _world.robotsYellow() : _world.robotsBlue();
 
   // ロボットが検出されていないときは何もしない
-  if (robots.count(id) == 0) return;
+  if (robots.count(id) == 0) return std::nullopt;
 
   // commandの指令値をControllerに通す
   auto controller = [id, &c = *std::get<1>(_metadata), &r = robots.at(id)](auto&& _s) {
     return c(r, std::forward<decltype(_s)>(_s));
   };
   command.vel(std::visit(controller, command.setpoint()));
+  return command;
+}
 
-  // Senderで送信
-  std::get<2>(_metadata)->sendCommand(command);
+void driver::run(const model::world& _world, model::teamColor _color, std::size_t _index) {
+  // threadPoolの処理は例外を投げてはならないので, 捕まえてメインループで投げ直す
+  std::exception_ptr error{};
+  try {
+    results_[_index] = control(_world, _color, work_[_index]);
+  } catch (...) {
+    error = std::current_exception();
+  }
 
-  // 登録された関数があればそれを呼び出す
-  commandUpdated_(command);
+  std::lock_guard<std::mutex> lock(workerMutex_);
+  if (error && !error_) error_ = error;
+  if (--pending_ == 0) done_.notify_all();
 }
 
 } // namespace ai
@@ -2,10 +2,16 @@
 #define AI_DRIVER_HPP_
 
 #include <chrono>
+#include <condition_variable>
+#include <exception>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <system_error>
 #include <tuple>
+#include <utility>
+#include <vector>
 #include <stdint.h>
 #include <boost/asio.hpp>
 #include <boost/asio/basic_waitable_timer.hpp>
@@ -13,9 +19,12 @@
 
 #include "ai/controller/base.hpp"
 #include "ai/model/command.hpp"
+#include "ai/model/predictor.hpp"
 #include "ai/model/teamColor.hpp"
 #include "ai/model/updater/world.hpp"
 #include "ai/sender/base.hpp"
+#include "ai/util/histogram.hpp"
+#include "ai/util/threadPool.hpp"
 #include "ai/util/time.hpp"
 
 namespace ai {
@@ -25,16 +34,37 @@ class driver {
   /// Senderのポインタの型
   using SenderType = std::shared_ptr<sender::base>;
   /// Driverで行う処理で必要となる各ロボットの情報の型
-  using MetadataType = std::tuple<model::command, ControllerType, SenderType>;
+  /// 周期の処理中に登録が解除されても破棄されないよう, Controllerは共有して持つ
+  using MetadataType =
+      std::tuple<model::command, std::shared_ptr<controller::base>, SenderType>;
   /// Commandが更新された(Controllerを通された)ときに発火するシグナルの型
   using UpdatedSignalType = boost::signals2::signal<void(const model::command&)>;
+  /// 制御周期のスケジュールに用いるclock (システム時刻の変更の影響を受けない)
+  using SteadyClockType = std::chrono::steady_clock;
 
 public:
+  /// 制御周期の処理の統計
+  struct cycleStatistics {
+    uint64_t cycles{0};         // 処理した周期の数
+    uint64_t overruns{0};       // 処理が次の周期の開始時刻までに終わらなかった回数
+    uint64_t skipped{0};        // 処理が1周期以上遅れたために飛ばした周期の数
+    std::error_code realtime;   // 最後にrealtime()の設定を適用した結果
+    util::histogram wakeup;     // 周期の開始時刻から処理を始めるまでの遅れ
+    util::histogram snapshot;   // WorldModelの取得と予測にかかった時間
+    util::histogram controller; // Controllerの計算にかかった時間
+    util::histogram send;       // Senderでの送信にかかった時間
+    util::histogram signal;     // commandUpdatedのシグナルにかかった時間
+    util::histogram total;      // 1周期の処理全体にかかった時間
+  };
+
   /// @param _cycle            制御周期
   /// @param _world            updater::worldの参照
   /// @param _color            チームカラー
+  /// @param _threads          Controllerを並列に計算するワーカースレッドの数
+  ///                          (0ならio_serviceを回しているスレッドで順に計算する)
   driver(boost::asio::io_service& _ioService, util::DurationType _cycle,
-         const model::updater::world& _world, model::teamColor _color);
+         const model::updater::world& _world, model::teamColor _color,
+         std::size_t _threads = 0);
 
   /// @brief                  現在設定されているチームカラーを取得する
   model::teamColor teamColor() const;
@@ -69,30 +99,96 @@ public:
   /// @param _limit            速度の制限値
   void velocityLimit(double _limit);
 
+  /// @brief                  送信期限の時刻まで予測したWorldModelを取得する
+  ///
+  /// 制御周期ごとに, updater::worldのスナップショットをこの周期の送信期限の時刻まで
+  /// 進めたものが公開される. Controllerに渡される値もこれと同じものなので,
+  /// 戦略側でこれを使えば制御と時刻の揃った値で判断できる
+  std::shared_ptr<const model::world> predicted() const;
+
+  /// @brief                  制御周期を回すスレッドをリアルタイムに動かす
+  /// @param _priority         SCHED_FIFOの優先度 (0ならスケジューリングポリシーを変えない)
+  /// @param _cpu              固定するCPUの番号 (負ならCPUを固定しない)
+  ///
+  /// 次の周期の初めに, io_serviceを回しているスレッドで適用する.
+  /// 適用できたかはstatistics().realtimeで確かめられる
+  void realtime(int _priority, int _cpu);
+
+  /// @brief                  制御周期の処理の統計を取得する
+  cycleStatistics statistics() const;
+
+  /// @brief                  制御周期の処理の統計を消す
+  void resetStatistics();
+
 private:
   /// @brief                  cycle_毎に呼ばれる制御部のメインループ
   void mainLoop(const boost::system::error_code& _error);
 
-  /// @brief                  ロボットへの命令をControllerを通してから送信する
-  void process(const model::world& _world, MetadataType& _metadata);
+  /// @brief                  ロボットへの命令をControllerに通す
+  /// @return                  ロボットが検出されていなければnullopt
+  ///
+  /// 他のロボットと共有する状態を書き換えないので, ロボットごとに並列に呼び出してよい
+  std::optional<model::command> control(const model::world& _world, model::teamColor _color,
+                                        const MetadataType& _metadata) const;
+
+  /// @brief                  ワーカースレッドでwork_[index]のロボットの命令をControllerに通す
+  void run(const model::world& _world, model::teamColor _color, std::size_t _index);
 
   mutable std::mutex mutex_;
+  /// Controllerの計算中に速度制限が変更されないようにするための排他
+  std::mutex controllerMutex_;
 
   /// 制御部の処理を一定の周期で回すためのタイマ
-  boost::asio::basic_waitable_timer<util::ClockType> timer_;
+  boost::asio::basic_waitable_timer<SteadyClockType> timer_;
   /// 制御周期
   util::DurationType cycle_;
 
+  // deadline_からbatches_まではmainLoop()の中でだけ扱うので, mutex_では保護しない
+
+  /// 今の周期の開始時刻 (最初の周期が始まるまではエポック)
+  SteadyClockType::time_point deadline_;
+  /// この周期で処理するロボットの情報 (周期の初めにmutex_を取得して写しておく)
+  std::vector<MetadataType> work_;
+  /// work_の各ロボットについてControllerに通した命令
+  std::vector<std::optional<model::command>> results_;
+  /// この周期で送信する命令とその送信先
+  std::vector<std::pair<model::command, sender::base*>> commands_;
+  /// この周期でSenderごとにまとめて送信する命令 (要素の領域は周期をまたいで使い回す)
+  std::vector<std::pair<sender::base*, std::vector<model::command>>> batches_;
+
   /// updater::worldの参照
   const model::updater::world& world_;
 
   /// チームカラー
   model::teamColor teamColor_;
 
+  /// 次の周期の初めに適用するリアルタイムの設定 (優先度とCPUの番号)
+  std::optional<std::pair<int, int>> realtime_;
+
+  /// Visionの遅れ時間を補償するための予測器 (mutex_を取得して扱う)
+  model::predictor predictor_;
+  /// 最後に予測したWorldModel
+  /// std::atomic_load/std::atomic_storeでのみアクセスする
+  std::shared_ptr<const model::world> predicted_;
+
   /// 登録されたロボットの情報
   std::unordered_map<uint32_t, MetadataType> robotsMetadata_;
 
   UpdatedSignalType commandUpdated_;
+
+  mutable std::mutex statisticsMutex_;
+  /// 制御周期の処理の統計
+  cycleStatistics statistics_;
+
+  std::mutex workerMutex_;
+  std::condition_variable done_;
+  /// この周期でまだ終わっていないワーカースレッドの処理の数
+  std::size_t pending_;
+  /// ワーカースレッドで投げられた最初の例外
+  std::exception_ptr error_;
+  /// Controllerを並列に計算するワーカースレッド (並列に計算しなければnullptr)
+  /// 他のメンバより先に破棄して, 実行中の処理が終わるのを待つ
+  std::unique_ptr<util::threadPool> pool_;
 };
 } // namespace ai
 
@@ -0,0 +1,109 @@
+#include <cmath>
+#include <limits>
+#include <boost/math/constants/constants.hpp>
+
+#include "va.hpp"
+
+namespace ai {
+namespace filter {
+namespace batch {
+
+namespace {
+
+namespace bmc = boost::math::double_constants;
+using ColumnType = model::robotStates::ColumnType;
+
+/// @brief           util::math::wrapTo2piと同じ計算を全スロットに対して行う
+/// @param r         角度
+/// @param mod       std::fmod(r, 2pi)
+ColumnType wrapTo2pi(const ColumnType& _r, const ColumnType& _mod) {
+  return (_r < 0).select(_mod + bmc::two_pi, _mod);
+}
+
+/// @brief           util::math::wrapToPiと同じ計算を全スロットに対して行う
+/// @param mod       std::fmod(r, 2pi)
+ColumnType wrapToPi(const ColumnType& _mod) {
+  return (_mod > bmc::pi)
+      .select(_mod - bmc::two_pi, (_mod <= -bmc::pi).select(_mod + bmc::two_pi, _mod));
+}
+
+} // namespace
+
+va::va() {
+  prevThetaMod_.setZero();
+  prevTime_.setZero();
+  initialized_.setConstant(false);
+}
+
+void va::update(model::robotStates& _states, const MaskType& _updated,
+                util::TimePointType _time) {
+  // std::chrono::duration<double>{_time - prevTime_}.count() と同じ計算をする
+  static_assert(util::DurationType::period::num == 1);
+  constexpr auto den = static_cast<double>(util::DurationType::period::den);
+  const auto now     = _time.time_since_epoch().count();
+  const ColumnType dt =
+      (TicksType::Constant(now) - prevTime_).cast<double>() / ColumnType::Constant(den);
+
+  // 初めて更新されたスロット
+  const MaskType first = _updated && !initialized_;
+  // 非常に短い間隔で更新されたスロット (直前の値を返す)
+  const MaskType skip =
+      _updated && initialized_ && (dt.abs() < std::numeric_limits<double>::epsilon());
+  // 速度と加速度を計算するスロット
+  const MaskType calc = _updated && initialized_ && !skip;
+
+  const auto& p         = prevState_;
+  const ColumnType zero = ColumnType::Zero();
+
+  // 速度の計算
+  const ColumnType vx = (_states.x() - p.x()) / dt;
+  const ColumnType vy = (_states.y() - p.y()) / dt;
+
+  // 角速度の計算
+  // 境界で大きな値になるのを防ぐために, 偏差がpi以下かそうでないかで処理を変える
+  // wrapTo2pi, wrapToPiはどちらもstd::fmod(theta, 2pi)を補正したものなので,
+  // fmodは1スロットにつき1回だけ計算し, 前回の値は保存しておいたものを使う
+  const ColumnType mod =
+      _states.theta().unaryExpr([](double _r) { return std::fmod(_r, bmc::two_pi); });
+  const ColumnType dtheta =
+      wrapTo2pi(_states.theta(), mod) - wrapTo2pi(p.theta(), prevThetaMod_);
+  const ColumnType dtheta2 = wrapToPi(mod) - wrapToPi(prevThetaMod_);
+  const ColumnType omega   = (dtheta.abs() < bmc::pi).select(dtheta / dt, dtheta2 / dt);
+
+  // 加速度の計算
+  const ColumnType ax = (vx - p.vx()) / dt;
+  const ColumnType ay = (vy - p.vy()) / dt;
+
+  // 各スロットの結果を選ぶ
+  _states.x()     = skip.select(p.x(), _states.x());
+  _states.y()     = skip.select(p.y(), _states.y());
+  _states.theta() = skip.select(p.theta(), _states.theta());
+  _states.vx()    = calc.select(vx, first.select(zero, skip.select(p.vx(), _states.vx())));
+  _states.vy()    = calc.select(vy, first.select(zero, skip.select(p.vy(), _states.vy())));
+  _states.omega() =
+      calc.select(omega, first.select(zero, skip.select(p.omega(), _states.omega())));
+  _states.ax()    = calc.select(ax, first.select(zero, skip.select(p.ax(), _states.ax())));
+  _states.ay()    = calc.select(ay, first.select(zero, skip.select(p.ay(), _states.ay())));
+
+  // 計算したスロットの状態を保存する
+  const MaskType store = first || calc;
+  prevState_.x()       = store.select(_states.x(), p.x());
+  prevState_.y()       = store.select(_states.y(), p.y());
+  prevState_.theta()   = store.select(_states.theta(), p.theta());
+  prevState_.vx()      = store.select(_states.vx(), p.vx());
+  prevState_.vy()      = store.select(_states.vy(), p.vy());
+  prevState_.omega()   = store.select(_states.omega(), p.omega());
+  prevState_.ax()      = store.select(_states.ax(), p.ax());
+  prevState_.ay()      = store.select(_states.ay(), p.ay());
+  prevThetaMod_        = store.select(mod, prevThetaMod_);
+  prevTime_            = store.select(TicksType::Constant(now), prevTime_);
+  initialized_         = initialized_ || _updated;
+}
+
+void va::reset(std::size_t _index) {
+  initialized_(_index) = false;
+}
+
+} // namespace batch
+} // namespace filter
+} // namespace ai
@@ -0,0 +1,53 @@
+#ifndef AI_FILTER_BATCH_VA_HPP_
+#define AI_FILTER_BATCH_VA_HPP_
+
+#include <Eigen/Core>
+
+#include "ai/model/robotStates.hpp"
+#include "ai/util/time.hpp"
+
+namespace ai {
+namespace filter {
+namespace batch {
+
+/// @class   va
+/// @brief   全ロボットの速度と加速度をまとめて計算する
+///
+/// filter::va<model::robot> を model::robotStates の全スロットに対して
+/// 一度に適用したものと同じ結果を返す.
+/// スロットごとに前回の状態と時刻を保持しており, 各スロットは独立したfilter::vaとして振る舞う.
+class va {
+public:
+  using MaskType = model::robotStates::MaskType;
+
+  va();
+
+  /// @brief           速度と加速度を計算する
+  /// @param states    位置が更新された状態. 計算結果はここに書き込まれる
+  /// @param updated   今回値が更新されたスロット. それ以外のスロットは変更されない
+  /// @param time      値が更新された時刻
+  void update(model::robotStates& _states, const MaskType& _updated, util::TimePointType _time);
+
+  /// @brief           スロットの状態を初期化する
+  ///
+  /// 次にそのスロットが更新されたときは, 初めて更新されたときと同様に扱われる
+  void reset(std::size_t _index);
+
+private:
+  using TicksType = Eigen::Array<util::DurationType::rep, model::robotStates::capacity, 1>;
+
+  /// 前回の計算結果
+  model::robotStates prevState_;
+  /// 前回の角度をstd::fmod(theta, 2pi)したもの
+  model::robotStates::ColumnType prevThetaMod_;
+  /// 前回更新された時刻 (time_since_epochのcount)
+  TicksType prevTime_;
+  /// 一度でも更新されたスロット
+  MaskType initialized_;
+};
+
+} // namespace batch
+} // namespace filter
+} // namespace ai
+
+#endif // AI_FILTER_BATCH_VA_HPP_
@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#include "ball.hpp"
+
+namespace ai {
+namespace filter {
+namespace kalman {
+
+constexpr double ball::slidingDecel_;
+constexpr double ball::rollingDecel_;
+constexpr double ball::rollingRatio_;
+constexpr double ball::kickThreshold_;
+constexpr double ball::kickVariance_;
+constexpr double ball::settledVariance_;
+constexpr double ball::resetTime_;
+
+ball::ball(double _positionNoise, double _accelNoise)
+    : positionVariance_(_positionNoise * _positionNoise),
+      accelNoise_(_accelNoise),
+      initialized_(false),
+      phase_(phase::rolling),
+      peakSpeed_(0) {}
+
+model::ball ball::update(const model::ball& _value, util::TimePointType _time) {
+  using VectorType = kinematic<2>::VectorType;
+
+  if (!initialized_) {
+    reset(_value);
+    prevTime_ = _time;
+    return prevState_;
+  }
+
+  // 前回呼ばれたときからの経過時間
+  const auto dt = std::chrono::duration<double>{_time - prevTime_}.count();
+  // 非常に短い間隔や, 時間が巻き戻った場合は直前の値を返す
+  if (dt < std::numeric_limits<double>::epsilon()) return prevState_;
+  prevTime_ = _time;
+
+  // 長い間観測されていなかった場合は予測が当てにならないので初期化する
+  if (dt > resetTime_) {
+    reset(_value);
+    return prevState_;
+  }
+
+  // 摩擦による減速を制御入力として与える
+  // 減速しきって止まる場合は, 止まった位置で速度を0にする
+  const auto vx    = x_.state()(1);
+  const auto vy    = y_.state()(1);
+  const auto speed = std::hypot(vx, vy);
+  const auto decel = phase_ == phase::sliding ? slidingDecel_ : rollingDecel_;
+  VectorType ux, uy;
+  if (speed > decel * dt) {
+    const auto dv = decel * dt / speed;
+    ux << -0.5 * dv * vx * dt, -dv * vx;
+    uy << -0.5 * dv * vy * dt, -dv * vy;
+  } else {
+    const auto stop = speed / decel;
+    ux << vx * (0.5 * stop - dt), -vx;
+    uy << vy * (0.5 * stop - dt), -vy;
+  }
+  x_.predict(dt, accelNoise_, ux);
+  y_.predict(dt, accelNoise_, uy);
+
+  const auto ex = _value.x() - x_.state()(0);
+  const auto ey = _value.y() - y_.state()(0);
+
+  // 予測から大きく外れた場合は蹴られた(何かに衝突した)とみなし,
+  // 誤差共分散を大きくして観測値に素早く追従させる
+  // 前回の観測からの間に速度が変化したとして, その分の位置の誤差も加える
+  const auto nis = ex * ex / x_.innovationVariance(positionVariance_) +
+                   ey * ey / y_.innovationVariance(positionVariance_);
+  if (nis > kickThreshold_) {
+    kinematic<2>::MatrixType kick;
+    kick << dt * dt / 3, dt / 2, dt / 2, 1;
+    x_.inflate(kickVariance_ * kick);
+    y_.inflate(kickVariance_ * kick);
+    phase_     = phase::sliding;
+    peakSpeed_ = 0;
+  }
+
+  x_.correct(ex, positionVariance_);
+  y_.correct(ey, positionVariance_);
+
+  const auto newSpeed = std::hypot(x_.state()(1), y_.state()(1));
+  // 蹴られた直後は推定値が行き過ぎることがあるので, 速度の誤差分散が十分小さくなってから
+  // 最大の速さを記録する
+  const auto settled = x_.covariance()(1, 1) + y_.covariance()(1, 1) < settledVariance_;
+  if (phase_ == phase::sliding && settled) {
+    peakSpeed_ = std::max(peakSpeed_, newSpeed);
+    if (newSpeed <= rollingRatio_ * peakSpeed_) phase_ = phase::rolling;
+  }
+
+  auto result = _value;
+  result.x(x_.state()(0));
+  result.y(y_.state()(0));
+  result.vx(x_.state()(1));
+  result.vy(y_.state()(1));
+  // 加速度はモデルから求めた摩擦による減速度とする
+  if (newSpeed > std::numeric_limits<double>::epsilon()) {
+    const auto a = phase_ == phase::sliding ? slidingDecel_ : rollingDecel_;
+    result.ax(-a * result.vx() / newSpeed);
+    result.ay(-a * result.vy() / newSpeed);
+  } else {
+    result.ax(0);
+    result.ay(0);
+  }
+
+  prevState_ = result;
+  return result;
+}
+
+ball::phase ball::currentPhase() const {
+  return phase_;
+}
+
+void ball::reset(const model::ball& _value) {
+  using VectorType = kinematic<2>::VectorType;
+
+  const kinematic<2>::MatrixType p =
+      VectorType{positionVariance_, kickVariance_}.asDiagonal();
+  x_.reset(VectorType{_value.x(), 0}, p);
+  y_.reset(VectorType{_value.y(), 0}, p);
+
+  prevState_ = _value;
+  prevState_.vx(0);
+  prevState_.vy(0);
+  prevState_.ax(0);
+  prevState_.ay(0);
+  phase_       = phase::rolling;
+  peakSpeed_   = 0;
+  initialized_ = true;
+}
+
+} // namespace kalman
+} // namespace filter
+} // namespace ai
@@ -0,0 +1,76 @@
+#ifndef AI_FILTER_KALMAN_BALL_HPP_
+#define AI_FILTER_KALMAN_BALL_HPP_
+
+#include "ai/filter/base.hpp"
+#include "ai/model/ball.hpp"
+#include "kinematic.hpp"
+
+namespace ai {
+namespace filter {
+namespace kalman {
+
+/// @class   ball
+/// @brief   ボールの位置, 速度を推定するKalman Filter
+///
+/// 等速度モデルに床との摩擦による減速を加えたモデルで推定する.
+/// 蹴られた直後のボールは床を滑りながら大きく減速し, 速度が初速の5/7まで落ちると
+/// 転がり始めて減速が小さくなるので, 2つの状態を切り替えて扱う.
+/// 蹴られたことはイノベーションの大きさから検出する
+class ball : public base<model::ball, timing::OnUpdated> {
+public:
+  /// ボールの状態
+  enum class phase {
+    sliding, // 床を滑っている
+    rolling, // 床を転がっている
+  };
+
+  /// @param positionNoise     位置の観測雑音の標準偏差[mm]
+  /// @param accelNoise        加速度に加わる白色雑音のパワースペクトル密度[mm^2/s^3]
+  explicit ball(double _positionNoise = 3.0, double _accelNoise = 1.0e4);
+
+  model::ball update(const model::ball& _value, util::TimePointType _time) override;
+
+  /// @brief           現在のボールの状態を返す
+  phase currentPhase() const;
+
+private:
+  /// @brief           観測値で状態を初期化する
+  void reset(const model::ball& _value);
+
+  /// 滑っているときの減速度[mm/s^2]
+  static constexpr double slidingDecel_ = 3500.0;
+  /// 転がっているときの減速度[mm/s^2]
+  static constexpr double rollingDecel_ = 350.0;
+  /// 滑りから転がりに変わる速度の比
+  static constexpr double rollingRatio_ = 5.0 / 7.0;
+  /// 蹴られたとみなす正規化したイノベーションの2乗の閾値 (自由度2のカイ2乗分布の99.9%点)
+  static constexpr double kickThreshold_ = 13.8;
+  /// 蹴られたときに速度の誤差分散に加える値
+  static constexpr double kickVariance_ = 1.0e7;
+  /// 速度の推定が落ち着いたとみなす誤差分散
+  static constexpr double settledVariance_ = 1.0e5;
+  /// これ以上観測が途切れたら状態を初期化する時間[s]
+  static constexpr double resetTime_ = 1.0;
+
+  /// 位置の観測雑音の分散
+  double positionVariance_;
+  double accelNoise_;
+
+  /// 状態が初期化されているか
+  bool initialized_;
+  util::TimePointType prevTime_;
+  model::ball prevState_;
+
+  phase phase_;
+  /// 蹴られてから推定した最大の速さ[mm/s]
+  double peakSpeed_;
+
+  kinematic<2> x_;
+  kinematic<2> y_;
+};
+
+} // namespace kalman
+} // namespace filter
+} // namespace ai
+
+#endif // AI_FILTER_KALMAN_BALL_HPP_
@@ -0,0 +1,112 @@
+#ifndef AI_FILTER_KALMAN_KINEMATIC_HPP_
+#define AI_FILTER_KALMAN_KINEMATIC_HPP_
+
+#include <Eigen/Core>
+
+namespace ai {
+namespace filter {
+namespace kalman {
+
+/// @class   kinematic
+/// @brief   1軸の運動モデルに対するKalman Filter
+///
+/// 状態は[位置, 速度, 加速度, ...]の先頭N個で, 最上位の微分が白色雑音で変化するとみなす.
+/// (N = 2なら等速度モデル, N = 3なら等加速度モデル)
+/// 観測は位置のみとし, 行列はすべて固定長なので動的なメモリ確保は行わない
+template <int N>
+class kinematic {
+  static_assert(N >= 1, "N must be positive");
+
+public:
+  using VectorType = Eigen::Matrix<double, N, 1>;
+  using MatrixType = Eigen::Matrix<double, N, N>;
+
+  kinematic() : x_(VectorType::Zero()), p_(MatrixType::Zero()) {}
+
+  /// @brief           状態と誤差共分散を設定する
+  /// @param x         状態
+  /// @param p         誤差共分散
+  void reset(const VectorType& _x, const MatrixType& _p) {
+    x_ = _x;
+    p_ = _p;
+  }
+
+  /// @brief           状態を時間dtだけ進める
+  /// @param dt        経過時間[s]
+  /// @param q         最上位の微分に加わる白色雑音のパワースペクトル密度
+  /// @param u         運動モデルで表せない状態の変化量 (摩擦による減速など)
+  void predict(double _dt, double _q, const VectorType& _u = VectorType::Zero()) {
+    // dtの累乗 / 階乗
+    double c[2 * N];
+    c[0] = 1;
+    for (auto k = 1; k < 2 * N; ++k) c[k] = c[k - 1] * _dt / k;
+
+    // F_ij = dt^(j - i) / (j - i)!
+    MatrixType f = MatrixType::Zero();
+    for (auto i = 0; i < N; ++i) {
+      for (auto j = i; j < N; ++j) f(i, j) = c[j - i];
+    }
+
+    // 連続時間の白色雑音を離散化したもの
+    // Q_ij = q * dt^(2N - 1 - i - j) / ((2N - 1 - i - j) * (N - 1 - i)! * (N - 1 - j)!)
+    MatrixType q;
+    for (auto i = 0; i < N; ++i) {
+      for (auto j = 0; j < N; ++j) {
+        const auto k = 2 * N - 1 - i - j;
+        const auto d = factorial(N - 1 - i) * factorial(N - 1 - j);
+        q(i, j)      = _q * c[k] * factorial(k - 1) / d;
+      }
+    }
+
+    x_ = f * x_ + _u;
+    p_ = f * p_ * f.transpose() + q;
+  }
+
+  /// @brief           位置の観測値で状態を修正する
+  /// @param y         観測値と予測値の差 (イノベーション)
+  /// @param r         観測雑音の分散
+  void correct(double _y, double _r) {
+    const auto s      = p_(0, 0) + _r;
+    const VectorType k = p_.col(0) / s;
+    x_ += k * _y;
+    p_ -= k * p_.row(0);
+  }
+
+  /// @brief           イノベーションの分散を返す
+  /// @param r         観測雑音の分散
+  double innovationVariance(double _r) const {
+    return p_(0, 0) + _r;
+  }
+
+  /// @brief           誤差共分散を増やす
+  /// @param q         加える共分散
+  ///
+  /// 急な外乱(ボールが蹴られたなど)を受けて, 推定値を観測値に素早く追従させたいときに使う
+  void inflate(const MatrixType& _q) {
+    p_ += _q;
+  }
+
+  const VectorType& state() const {
+    return x_;
+  }
+
+  const MatrixType& covariance() const {
+    return p_;
+  }
+
+private:
+  static constexpr double factorial(int _n) {
+    return _n <= 1 ? 1 : _n * factorial(_n - 1);
+  }
+
+  /// 状態
+  VectorType x_;
+  /// 誤差共分散
+  MatrixType p_;
+};
+
+} // namespace kalman
+} // namespace filter
+} // namespace ai
+
+#endif // AI_FILTER_KALMAN_KINEMATIC_HPP_
@@ -0,0 +1,93 @@
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#include "ai/util/math/angle.hpp"
+#include "robot.hpp"
+
+namespace ai {
+namespace filter {
+namespace kalman {
+
+constexpr double robot::resetTime_;
+constexpr double robot::initialVariance_;
+
+robot::robot(double _positionNoise, double _angleNoise, double _jerkNoise,
+             double _angularAccelNoise)
+    : positionVariance_(_positionNoise * _positionNoise),
+      angleVariance_(_angleNoise * _angleNoise),
+      jerkNoise_(_jerkNoise),
+      angularAccelNoise_(_angularAccelNoise),
+      initialized_(false) {}
+
+model::robot robot::update(const model::robot& _value, util::TimePointType _time) {
+  if (!initialized_) {
+    reset(_value);
+    prevTime_ = _time;
+    return prevState_;
+  }
+
+  // 前回呼ばれたときからの経過時間
+  const auto dt = std::chrono::duration<double>{_time - prevTime_}.count();
+  // 非常に短い間隔や, 時間が巻き戻った場合は直前の値を返す
+  if (dt < std::numeric_limits<double>::epsilon()) return prevState_;
+  prevTime_ = _time;
+
+  // 長い間観測されていなかった場合は予測が当てにならないので初期化する
+  if (dt > resetTime_) {
+    reset(_value);
+    return prevState_;
+  }
+
+  x_.predict(dt, jerkNoise_);
+  y_.predict(dt, jerkNoise_);
+  theta_.predict(dt, angularAccelNoise_);
+
+  x_.correct(_value.x() - x_.state()(0), positionVariance_);
+  y_.correct(_value.y() - y_.state()(0), positionVariance_);
+  // 角度の差は[-pi, pi]に正規化してから使う
+  theta_.correct(util::math::wrapToPi(_value.theta() - theta_.state()(0)), angleVariance_);
+  // 推定した角度も正規化しておく
+  auto theta = theta_.state();
+  theta(0)   = util::math::wrapToPi(theta(0));
+  theta_.reset(theta, theta_.covariance());
+
+  auto result = _value;
+  result.x(x_.state()(0));
+  result.y(y_.state()(0));
+  // 出力する角度は他のフィルタやtransformと同じく[0, 2pi)にする
+  result.theta(util::math::wrapTo2pi(theta(0)));
+  result.vx(x_.state()(1));
+  result.vy(y_.state()(1));
+  result.omega(theta_.state()(1));
+  result.ax(x_.state()(2));
+  result.ay(y_.state()(2));
+
+  prevState_ = result;
+  return result;
+}
+
+void robot::reset(const model::robot& _value) {
+  using pos = kinematic<3>;
+  using rot = kinematic<2>;
+
+  const pos::MatrixType p =
+      pos::VectorType{positionVariance_, initialVariance_, initialVariance_}.asDiagonal();
+  x_.reset(pos::VectorType{_value.x(), 0, 0}, p);
+  y_.reset(pos::VectorType{_value.y(), 0, 0}, p);
+  theta_.reset(rot::VectorType{_value.theta(), 0},
+               rot::VectorType{angleVariance_, initialVariance_}.asDiagonal());
+
+  prevState_ = _value;
+  prevState_.theta(util::math::wrapTo2pi(_value.theta()));
+  prevState_.vx(0);
+  prevState_.vy(0);
+  prevState_.omega(0);
+  prevState_.ax(0);
+  prevState_.ay(0);
+  initialized_ = true;
+}
+
+} // namespace kalman
+} // namespace filter
+} // namespace ai
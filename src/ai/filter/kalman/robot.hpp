@@ -0,0 +1,58 @@
+#ifndef AI_FILTER_KALMAN_ROBOT_HPP_
+#define AI_FILTER_KALMAN_ROBOT_HPP_
+
+#include "ai/filter/base.hpp"
+#include "ai/model/robot.hpp"
+#include "kinematic.hpp"
+
+namespace ai {
+namespace filter {
+namespace kalman {
+
+/// @class   robot
+/// @brief   ロボットの位置, 速度, 加速度を推定するKalman Filter
+///
+/// x, y方向は等加速度モデル, 角度は等角速度モデルで推定する.
+/// filter::vaのように差分を取らないので, 観測雑音が速度や加速度に増幅されにくい
+class robot : public base<model::robot, timing::OnUpdated> {
+public:
+  /// @param positionNoise     位置の観測雑音の標準偏差[mm]
+  /// @param angleNoise        角度の観測雑音の標準偏差[rad]
+  /// @param jerkNoise         躍度に加わる白色雑音のパワースペクトル密度[mm^2/s^5]
+  /// @param angularAccelNoise 角加速度に加わる白色雑音のパワースペクトル密度[rad^2/s^3]
+  explicit robot(double _positionNoise = 2.0, double _angleNoise = 0.02,
+                 double _jerkNoise = 1.0e6, double _angularAccelNoise = 1.0e3);
+
+  model::robot update(const model::robot& _value, util::TimePointType _time) override;
+
+private:
+  /// @brief           観測値で状態を初期化する
+  void reset(const model::robot& _value);
+
+  /// これ以上観測が途切れたら状態を初期化する時間[s]
+  static constexpr double resetTime_ = 1.0;
+  /// 初期化直後の速度, 加速度の誤差分散 (観測値に素早く追従させるために大きくする)
+  static constexpr double initialVariance_ = 1.0e8;
+
+  /// 位置の観測雑音の分散
+  double positionVariance_;
+  /// 角度の観測雑音の分散
+  double angleVariance_;
+  double jerkNoise_;
+  double angularAccelNoise_;
+
+  /// 状態が初期化されているか
+  bool initialized_;
+  util::TimePointType prevTime_;
+  model::robot prevState_;
+
+  kinematic<3> x_;
+  kinematic<3> y_;
+  kinematic<2> theta_;
+};
+
+} // namespace kalman
+} // namespace filter
+} // namespace ai
+
+#endif // AI_FILTER_KALMAN_ROBOT_HPP_
@@ -1,4 +1,5 @@
 #include <cmath>
+#include <functional>
 #include <boost/geometry/geometry.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
 #include <boost/geometry/geometries/polygon.hpp>
@@ -45,18 +46,16 @@ model::command getBall::execute() {
   Eigen::Vector2d position{Eigen::Vector2d::Zero()};
   auto theta = 0.0;
 
-  const auto field = world_.field();
+  const auto map   = world_.fieldMap();
+  const auto& field = map->field();
 
-  if ((std::abs(robot.x()) > field.xMax() - field.penaltyLength() - 100.0) &&
-      (std::abs(robot.y()) < field.penaltyWidth() / 2.0 + 100.0)) {
+  if (map->inPenalty(robot.x(), robot.y(), 100.0)) {
     // robot in the penalty area
     command.pos({0.0, 0.0, robotTheta});
-  } else if ((std::abs(ballPos.x()) > field.xMax() - field.penaltyLength() - 100.0) &&
-             (std::abs(ballPos.y()) < field.penaltyWidth() / 2.0 + 100.0)) {
+  } else if (map->inPenalty(ballPos.x(), ballPos.y(), 100.0)) {
     // ball in the penalty area
     command.vel({0.0, 0.0, 0.0});
-  } else if (std::abs(ballPos.x()) > field.xMax() + 100.0 ||
-             std::abs(ballPos.y()) > field.yMax() + 100.0) {
+  } else if (map->outside(ballPos.x(), ballPos.y(), 100.0)) {
     // don't get the ball which is out of the field
     command.vel({0.0, 0.0, 0.0});
   } else if (false && (std::hypot(ballPos.x() - robot.x(), ballPos.y() - robot.y()) / 1000.0) *
@@ -227,8 +226,8 @@ model::command getBall::execute() {
 
     std::vector<planner::rrt::obstacle> obstacles{};
     obstacles.reserve(enemyRobots.size() + friendRobots.size());
-    for (auto&& [iy, rs] : {std::forward_as_tuple(false, enemyRobots),
-                            std::forward_as_tuple(true, friendRobots)}) {
+    for (auto&& [iy, rs] : {std::make_tuple(false, std::cref(enemyRobots)),
+                            std::make_tuple(true, std::cref(friendRobots))}) {
       for (auto&& [i, r] : rs) {
         if (iy != isYellow_ || i != id_) {
           obstacles.push_back({model::command::position{r.x(), r.y(), 0.0}, 300.0});
@@ -1,4 +1,5 @@
 #include <cmath>
+#include <functional>
 #include <Eigen/Dense>
 #include <boost/geometry/geometry.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
@@ -82,8 +83,8 @@ model::command marking::execute() {
   }
   std::vector<planner::rrt::obstacle> obstacles{};
   obstacles.reserve(enemyRobots.size() + friendRobots.size());
-  for (auto&& [iy, rs] :
-       {std::forward_as_tuple(false, enemyRobots), std::forward_as_tuple(true, friendRobots)}) {
+  for (auto&& [iy, rs] : {std::make_tuple(false, std::cref(enemyRobots)),
+                          std::make_tuple(true, std::cref(friendRobots))}) {
     for (auto&& [i, r] : rs) {
       if (iy != isYellow_ || i != id_) {
         obstacles.push_back({model::command::position{r.x(), r.y(), 0.0}, 300.0});
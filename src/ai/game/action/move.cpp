@@ -1,4 +1,5 @@
 #include <cmath>
+#include <functional>
 #include <boost/math/constants/constants.hpp>
 #include "move.hpp"
 
@@ -13,6 +14,8 @@ void move::moveTo(double _x, double _y, double _theta) {
   y_     = _y;
   theta_ = _theta;
   rrt_   = std::make_shared<ai::planner::rrt>(world_);
+  // 他のロボットがこれから来る位置も避けるので, 半径はロボットの大きさ程度まで小さくできる
+  rrt_->robotSpeed(robotSpeed);
 }
 
 model::command move::execute() {
@@ -37,16 +40,18 @@ model::command move::execute() {
 
     std::vector<planner::rrt::obstacle> obstacles{};
     obstacles.reserve(robotsBlue.size() + robotsYellow.size());
-    for (auto&& [iy, rs] : {std::forward_as_tuple(false, robotsBlue),
-                            std::forward_as_tuple(true, robotsYellow)}) {
+    for (auto&& [iy, rs] : {std::make_tuple(false, std::cref(robotsBlue)),
+                            std::make_tuple(true, std::cref(robotsYellow))}) {
       for (auto&& [i, r] : rs) {
         if (iy != isYellow_ || i != id_) {
-          obstacles.push_back({model::command::position{r.x(), r.y(), 0.0}, 300.0});
+          obstacles.push_back({model::command::position{r.x(), r.y(), 0.0}, robotRadius,
+                               {r.vx(), r.vy(), 0.0}});
         }
       }
     }
 
-    obstacles.push_back({model::command::position{ball.x(), ball.y(), 0.0}, 500.0});
+    obstacles.push_back({model::command::position{ball.x(), ball.y(), 0.0}, 500.0,
+                         {ball.vx(), ball.vy(), 0.0}});
     rrt_->obstacles(obstacles);
     rrt_->search(model::command::position{thisRobot.x(), thisRobot.y(), thisRobot.theta()},
                  model::command::position{x_, y_, theta_});
@@ -17,6 +17,11 @@ public:
 
   model::command execute() override;
 
+  /// 経路を辿るときに見込む自身の速さ[mm/s]
+  static constexpr double robotSpeed = 1500.0;
+  /// 障害物とする他のロボットの半径[mm]
+  static constexpr double robotRadius = 200.0;
+
 private:
   double x_;
   double y_;
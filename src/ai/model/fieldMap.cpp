@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <cmath>
+
+#include "fieldMap.hpp"
+
+namespace ai {
+namespace model {
+
+namespace {
+
+/// 格子をフィールドの外側へ広げる幅[mm]
+constexpr double extent = 1000.0;
+
+// フィールドの境界までの距離 (内側が正)
+double boundaryOf(const model::field& _field, double _x, double _y) {
+  const auto ax = std::abs(_x) - _field.xMax();
+  const auto ay = std::abs(_y) - _field.yMax();
+  if (ax <= 0.0 && ay <= 0.0) return -std::max(ax, ay);
+  return -std::hypot(std::max(ax, 0.0), std::max(ay, 0.0));
+}
+
+// 近い方のペナルティエリアまでの距離 (外側が正)
+double penaltyOf(const model::field& _field, double _x, double _y) {
+  const auto dx = _field.xMax() - _field.penaltyLength() - std::abs(_x);
+  const auto dy = std::abs(_y) - _field.penaltyWidth() / 2.0;
+  if (dx <= 0.0 && dy <= 0.0) return std::max(dx, dy);
+  return std::hypot(std::max(dx, 0.0), std::max(dy, 0.0));
+}
+
+// 長さlengthを間隔resolutionで覆うのに必要な格子点の数
+std::size_t points(double _length, double _resolution) {
+  return static_cast<std::size_t>(std::ceil(_length / _resolution)) + 1;
+}
+
+} // namespace
+
+fieldMap::fieldMap(const model::field& _field, double _resolution)
+    : field_(_field),
+      resolution_(_resolution),
+      minX_(_field.xMin() - extent),
+      minY_(_field.yMin() - extent),
+      nx_(points(_field.length() + 2 * extent, _resolution)),
+      ny_(points(_field.width() + 2 * extent, _resolution)),
+      boundary_(nx_ * ny_),
+      penalty_(nx_ * ny_) {
+  for (auto j = 0u; j < ny_; ++j) {
+    const auto y = minY_ + j * resolution_;
+    for (auto i = 0u; i < nx_; ++i) {
+      const auto x           = minX_ + i * resolution_;
+      boundary_[j * nx_ + i] = static_cast<float>(boundaryOf(field_, x, y));
+      penalty_[j * nx_ + i]  = static_cast<float>(penaltyOf(field_, x, y));
+    }
+  }
+}
+
+std::shared_ptr<const fieldMap> fieldMap::standard() {
+  // 初期化はスレッドセーフに1度だけ行われ, その後は読むだけなので排他は要らない
+  static const auto map = std::make_shared<const fieldMap>(model::field{});
+  return map;
+}
+
+std::shared_ptr<const fieldMap> fieldMap::update(
+    const std::shared_ptr<const fieldMap>& _current, const model::field& _field) {
+  if (_current && _current->sameGeometry(_field)) return _current;
+  return std::make_shared<const fieldMap>(_field);
+}
+
+bool fieldMap::sameGeometry(const model::field& _field) const {
+  return field_.length() == _field.length() && field_.width() == _field.width() &&
+         field_.penaltyLength() == _field.penaltyLength() &&
+         field_.penaltyWidth() == _field.penaltyWidth();
+}
+
+const model::field& fieldMap::field() const {
+  return field_;
+}
+
+double fieldMap::resolution() const {
+  return resolution_;
+}
+
+double fieldMap::boundary(double _x, double _y) const {
+  const auto c = locate(_x, _y);
+  return c ? interpolate(boundary_, *c) : boundaryOf(field_, _x, _y);
+}
+
+double fieldMap::penalty(double _x, double _y) const {
+  const auto c = locate(_x, _y);
+  return c ? interpolate(penalty_, *c) : penaltyOf(field_, _x, _y);
+}
+
+double fieldMap::distance(double _x, double _y) const {
+  const auto c = locate(_x, _y);
+  if (!c) return std::min(boundaryOf(field_, _x, _y), penaltyOf(field_, _x, _y));
+  return std::min(interpolate(boundary_, *c), interpolate(penalty_, *c));
+}
+
+Eigen::Vector2d fieldMap::gradient(double _x, double _y) const {
+  const auto c = locate(_x, _y);
+  if (!c) {
+    // 格子の外では中心差分で求める
+    const auto h = resolution_;
+    return Eigen::Vector2d{distance(_x + h, _y) - distance(_x - h, _y),
+                           distance(_x, _y + h) - distance(_x, _y - h)} /
+           (2 * h);
+  }
+
+  // 小さい方の値を取る格子について, 双線形補間した面の傾きを求める
+  const auto& v =
+      interpolate(boundary_, *c) < interpolate(penalty_, *c) ? boundary_ : penalty_;
+  const auto i   = c->index;
+  const auto v00 = v[i];
+  const auto v10 = v[i + 1];
+  const auto v01 = v[i + nx_];
+  const auto v11 = v[i + nx_ + 1];
+  return Eigen::Vector2d{(v10 - v00) * (1 - c->fy) + (v11 - v01) * c->fy,
+                         (v01 - v00) * (1 - c->fx) + (v11 - v10) * c->fx} /
+         resolution_;
+}
+
+bool fieldMap::outside(double _x, double _y, double _margin) const {
+  return std::abs(_x) > field_.xMax() + _margin || std::abs(_y) > field_.yMax() + _margin;
+}
+
+bool fieldMap::inPenalty(double _x, double _y, double _margin) const {
+  return std::abs(_x) > field_.xMax() - field_.penaltyLength() - _margin &&
+         std::abs(_y) < field_.penaltyWidth() / 2.0 + _margin;
+}
+
+std::optional<fieldMap::cell> fieldMap::locate(double _x, double _y) const {
+  const auto gx = (_x - minX_) / resolution_;
+  const auto gy = (_y - minY_) / resolution_;
+  if (!(gx >= 0.0 && gy >= 0.0 && gx <= nx_ - 1 && gy <= ny_ - 1)) return std::nullopt;
+
+  // 上端と右端の格子点上の点は, その手前の格子に含める
+  const auto i = std::min(static_cast<std::size_t>(gx), nx_ - 2);
+  const auto j = std::min(static_cast<std::size_t>(gy), ny_ - 2);
+  return cell{j * nx_ + i, gx - i, gy - j};
+}
+
+double fieldMap::interpolate(const std::vector<float>& _values, const cell& _cell) const {
+  const auto i = _cell.index;
+  const auto a = _values[i] + (_values[i + 1] - _values[i]) * _cell.fx;
+  const auto b = _values[i + nx_] + (_values[i + nx_ + 1] - _values[i + nx_]) * _cell.fx;
+  return a + (b - a) * _cell.fy;
+}
+
+} // namespace model
+} // namespace ai
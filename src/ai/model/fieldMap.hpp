@@ -0,0 +1,103 @@
+#ifndef AI_MODEL_FIELD_MAP_HPP_
+#define AI_MODEL_FIELD_MAP_HPP_
+
+#include <memory>
+#include <optional>
+#include <vector>
+#include <Eigen/Core>
+
+#include "field.hpp"
+
+namespace ai {
+namespace model {
+
+/// @class   fieldMap
+/// @brief   フィールドの境界とペナルティエリアまでの符号付き距離を格子状に求めておいたもの
+///
+/// 距離は格子点の値の双線形補間で求めるので, 問い合わせは位置によらず定数時間で終わる.
+/// 格子はフィールドの外側にも広げてあり, それより外の点では距離を直接計算する.
+/// 作った後は変更されないので, 複数のスレッドから同時に読み出してよい
+class fieldMap {
+public:
+  /// @param field      フィールドの情報
+  /// @param resolution 格子の間隔[mm]
+  explicit fieldMap(const model::field& _field, double _resolution = 50.0);
+
+  /// @brief            既定のフィールド(model::field{})のfieldMapを取得する
+  ///
+  /// 最初の呼び出しで1度だけ作り, 以後は同じものを返す
+  static std::shared_ptr<const fieldMap> standard();
+
+  /// @brief            フィールドの情報に合わせたfieldMapを取得する
+  /// @param current    現在のfieldMap
+  /// @param field      新しいフィールドの情報
+  ///
+  /// currentがfieldと同じ形状から作られていればそれを返し, 異なれば作り直す
+  static std::shared_ptr<const fieldMap> update(const std::shared_ptr<const fieldMap>& _current,
+                                                const model::field& _field);
+
+  /// @brief            fieldと同じ形状のフィールドから作られたか
+  ///
+  /// 距離に関係しない値(ゴールの幅など)は比べない
+  bool sameGeometry(const model::field& _field) const;
+
+  /// @brief            作成に使ったフィールドの情報
+  const model::field& field() const;
+
+  /// @brief            格子の間隔[mm]
+  double resolution() const;
+
+  /// @brief            フィールドの境界までの距離 (フィールドの内側が正)
+  double boundary(double _x, double _y) const;
+
+  /// @brief            近い方のペナルティエリアまでの距離 (ペナルティエリアの外側が正)
+  ///
+  /// ペナルティエリアはゴールラインより外側にも続いているものとする
+  double penalty(double _x, double _y) const;
+
+  /// @brief            立ち入ってはいけない領域(フィールド外とペナルティエリア)までの距離
+  ///
+  /// boundary()とpenalty()の小さい方で, 立ち入ってよい領域の内側が正になる
+  double distance(double _x, double _y) const;
+
+  /// @brief            distance()の勾配 (distance()が増える向き)
+  Eigen::Vector2d gradient(double _x, double _y) const;
+
+  /// @brief            フィールドを各辺marginだけ外へ広げた長方形の外側にあるか
+  ///
+  /// x, yを軸ごとに比べるので, boundary()と違い角の付近でも長方形として扱う
+  bool outside(double _x, double _y, double _margin) const;
+
+  /// @brief            近い方のペナルティエリアを各辺marginだけ広げた長方形の内側にあるか
+  ///
+  /// x, yを軸ごとに比べるので, penalty()と違い角の付近でも長方形として扱う
+  bool inPenalty(double _x, double _y, double _margin) const;
+
+private:
+  /// 格子上での位置
+  struct cell {
+    std::size_t index; // 左下の格子点の添字
+    double fx;         // 左下の格子点から見たx方向の位置(0から1)
+    double fy;         // 左下の格子点から見たy方向の位置(0から1)
+  };
+
+  /// @brief            点を含む格子を求める (格子の外ならnullopt)
+  std::optional<cell> locate(double _x, double _y) const;
+
+  /// @brief            格子点の値を双線形補間する
+  double interpolate(const std::vector<float>& _values, const cell& _cell) const;
+
+  model::field field_;
+  double resolution_;
+  double minX_;
+  double minY_;
+  std::size_t nx_;
+  std::size_t ny_;
+  std::vector<float> boundary_; // 各格子点のboundary()の値
+  std::vector<float> penalty_;  // 各格子点のpenalty()の値
+};
+
+} // namespace model
+} // namespace ai
+
+#endif // AI_MODEL_FIELD_MAP_HPP_
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <Eigen/Core>
+
+#include "ai/util/math/angle.hpp"
+#include "predictor.hpp"
+
+namespace ai {
+namespace model {
+
+constexpr double predictor::maxHorizon_;
+constexpr double predictor::step_;
+constexpr double predictor::ballDecel_;
+
+predictor::predictor(double _zeta, double _omega) : zeta_(_zeta), omega_(_omega) {
+  for (auto& h : histories_) {
+    h.head = 0;
+    h.size = 0;
+  }
+}
+
+void predictor::record(const model::command& _command, util::TimePointType _time) {
+  const auto id = _command.id();
+  if (id >= histories_.size()) return;
+  const auto vel = std::get_if<velocity>(&_command.setpoint());
+  if (!vel) return;
+
+  auto& h = histories_[id];
+  // 時刻が巻き戻った場合は以前の履歴を捨てる
+  if (h.size > 0 && h.entries[(h.head + h.size - 1) % historySize].time > _time) h.size = 0;
+
+  if (h.size < historySize) {
+    h.entries[(h.head + h.size) % historySize] = {_time, *vel};
+    ++h.size;
+  } else {
+    // いっぱいなら最も古いものを上書きする
+    h.entries[h.head] = {_time, *vel};
+    h.head            = (h.head + 1) % historySize;
+  }
+}
+
+void predictor::clear(uint32_t _id) {
+  if (_id < histories_.size()) histories_[_id].size = 0;
+}
+
+model::world predictor::predict(const model::world& _world, model::teamColor _color,
+                                util::TimePointType _time) const {
+  model::world result{_world};
+  result.captureTime(_time);
+
+  const auto from = _world.captureTime();
+  const auto horizon =
+      std::clamp(std::chrono::duration<double>{_time - from}.count(), 0.0, maxHorizon_);
+  if (horizon == 0.0) return result;
+  // 進める時間が上限を超えていた場合は, 上限まで進める
+  const auto to = from + std::chrono::duration_cast<util::DurationType>(
+                             std::chrono::duration<double>{horizon});
+
+  auto predictRobots = [&](model::world::RobotsList _robots, bool _commanded) {
+    for (auto&& r : _robots) {
+      const auto& h = histories_[r.first];
+      if (_commanded && h.size > 0) {
+        r.second = rollout(r.second, h, from, to);
+      } else {
+        r.second.x(r.second.x() + r.second.vx() * horizon);
+        r.second.y(r.second.y() + r.second.vy() * horizon);
+        r.second.theta(util::math::wrapTo2pi(r.second.theta() + r.second.omega() * horizon));
+      }
+    }
+    return _robots;
+  };
+  result.robotsBlue(predictRobots(_world.robotsBlue(), _color == model::teamColor::Blue));
+  result.robotsYellow(predictRobots(_world.robotsYellow(), _color == model::teamColor::Yellow));
+
+  // ボールは減速しきったらそこで止まる
+  auto ball        = _world.ball();
+  const auto speed = std::hypot(ball.vx(), ball.vy());
+  if (speed > 0) {
+    const auto t     = std::min(horizon, speed / ballDecel_);
+    const auto ratio = (speed - ballDecel_ * t) / speed;
+    ball.x(ball.x() + ball.vx() * (1 + ratio) / 2 * t);
+    ball.y(ball.y() + ball.vy() * (1 + ratio) / 2 * t);
+    ball.vx(ball.vx() * ratio);
+    ball.vy(ball.vy() * ratio);
+  }
+  result.ball(ball);
+
+  return result;
+}
+
+model::robot predictor::rollout(const model::robot& _robot, const history& _history,
+                                util::TimePointType _from, util::TimePointType _to) const {
+  // 状態を[位置, 速度, 加速度]の列で表す (行はx, y, theta)
+  Eigen::Vector3d p{_robot.x(), _robot.y(), _robot.theta()};
+  Eigen::Vector3d v{_robot.vx(), _robot.vy(), _robot.omega()};
+  Eigen::Vector3d a{_robot.ax(), _robot.ay(), 0};
+
+  const auto w2  = omega_ * omega_;
+  const auto zw2 = 2 * zeta_ * omega_;
+
+  auto entryAt = [&_history](std::size_t _i) -> const entry& {
+    return _history.entries[(_history.head + _i) % historySize];
+  };
+
+  // fromの時点で有効だった指令を探す
+  // (fromより前の指令が記録されていなければ, 速度を保つ入力とする)
+  auto next = std::size_t{0};
+  while (next < _history.size && entryAt(next).time <= _from) ++next;
+
+  auto t = _from;
+  while (t < _to) {
+    // 次に指令が切り替わる時刻か, 刻み幅だけ進んだ時刻まで進める
+    auto until = std::min(_to, t + std::chrono::duration_cast<util::DurationType>(
+                                       std::chrono::duration<double>{step_}));
+    if (next < _history.size) until = std::min(until, entryAt(next).time);
+    const auto dt = std::chrono::duration<double>{until - t}.count();
+
+    // 指令はロボット基準の座標系なのでフィールド基準に変換する
+    Eigen::Vector3d u = v;
+    if (next > 0) {
+      const auto& vel = entryAt(next - 1).vel;
+      const auto c    = std::cos(p.z());
+      const auto s    = std::sin(p.z());
+      u << vel.vx * c - vel.vy * s, vel.vx * s + vel.vy * c, vel.omega;
+    }
+
+    // p = p + v * dt, v = v + a * dt, a = a + (ω^2 * (u - v) - 2ζω * a) * dt
+    const Eigen::Vector3d da = w2 * (u - v) - zw2 * a;
+    p += v * dt;
+    v += a * dt;
+    a += da * dt;
+
+    t = until;
+    while (next < _history.size && entryAt(next).time <= t) ++next;
+  }
+
+  auto result = _robot;
+  result.x(p.x());
+  result.y(p.y());
+  // 世界の角度は[0, 2pi)で表すので, 予測した姿勢も同じ範囲にする
+  result.theta(util::math::wrapTo2pi(p.z()));
+  result.vx(v.x());
+  result.vy(v.y());
+  result.omega(v.z());
+  result.ax(a.x());
+  result.ay(a.y());
+  return result;
+}
+
+} // namespace model
+} // namespace ai
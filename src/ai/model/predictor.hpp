@@ -0,0 +1,89 @@
+#ifndef AI_MODEL_PREDICTOR_HPP_
+#define AI_MODEL_PREDICTOR_HPP_
+
+#include <array>
+#include <cstddef>
+#include <stdint.h>
+
+#include "ai/model/command.hpp"
+#include "ai/model/teamColor.hpp"
+#include "ai/model/world.hpp"
+#include "ai/util/time.hpp"
+
+namespace ai {
+namespace model {
+
+/// @class   predictor
+/// @brief   Visionの遅れ時間を補償するため, WorldModelを指定した時刻まで進める
+///
+/// WorldModelの値はキャプチャされた時刻のものなので, そのまま制御に使うと
+/// キャプチャから指令が届くまでの時間だけ遅れが生じる.
+/// このクラスは各ロボットとボールをキャプチャ時刻から指定した時刻まで外挿する.
+/// - 味方のロボットは送信した指令の履歴を入力として, 二次遅れモデルで進める
+/// - 指令の履歴がないロボットは等速度で進める
+/// - ボールは床との摩擦で減速しながら進め, 止まったらそこで止める
+class predictor {
+public:
+  using velocity = model::command::velocity;
+
+  /// 記録しておく指令の数
+  static constexpr std::size_t historySize = 32;
+
+  /// @param zeta      ロボット二次遅れモデルのパラメータζ
+  /// @param omega     ロボット二次遅れモデルのパラメータω
+  explicit predictor(double _zeta = 1.0, double _omega = 49.17);
+
+  /// @brief           ロボットに送信した指令を記録する
+  /// @param command   送信した指令 (速度指令でなければ無視する)
+  /// @param time      送信した時刻
+  void record(const model::command& _command, util::TimePointType _time);
+
+  /// @brief           記録した指令を消去する
+  /// @param id        ロボットのID
+  void clear(uint32_t _id);
+
+  /// @brief           WorldModelを時刻timeまで進める
+  /// @param world     キャプチャ時刻を持つWorldModel
+  /// @param color     指令を記録したロボットのチームカラー
+  /// @param time      予測する時刻
+  /// @return          予測したWorldModel (キャプチャ時刻はtimeになる)
+  model::world predict(const model::world& _world, model::teamColor _color,
+                       util::TimePointType _time) const;
+
+private:
+  /// 指令と送信時刻の組
+  struct entry {
+    util::TimePointType time;
+    velocity vel;
+  };
+
+  /// 1ロボット分の指令の履歴 (送信時刻の昇順に並ぶリングバッファ)
+  struct history {
+    std::array<entry, historySize> entries;
+    /// 最も古い指令の位置
+    std::size_t head;
+    /// 記録されている指令の数
+    std::size_t size;
+  };
+
+  /// @brief           指令の履歴を使ってロボットを進める
+  model::robot rollout(const model::robot& _robot, const history& _history,
+                       util::TimePointType _from, util::TimePointType _to) const;
+
+  /// 外挿する時間の上限[s] (これより古い値はそれ以上進めない)
+  static constexpr double maxHorizon_ = 0.5;
+  /// 二次遅れモデルを積分する刻み幅[s]
+  static constexpr double step_ = 0.002;
+  /// ボールが転がっているときの減速度[mm/s^2]
+  static constexpr double ballDecel_ = 350.0;
+
+  double zeta_;
+  double omega_;
+
+  std::array<history, model::world::maxRobots> histories_;
+};
+
+} // namespace model
+} // namespace ai
+
+#endif // AI_MODEL_PREDICTOR_HPP_
@@ -3,7 +3,15 @@
 namespace ai {
 namespace model {
 robot::robot(uint32_t _id, double _x, double _y, double _theta)
-    : id_(_id), x_(_x), y_(_y), theta_(_theta) {}
+    : id_(_id),
+      x_(_x),
+      y_(_y),
+      vx_(0),
+      vy_(0),
+      ax_(0),
+      ay_(0),
+      theta_(_theta),
+      omega_(0) {}
 
 uint32_t robot::id() const {
   return id_;
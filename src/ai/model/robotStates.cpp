@@ -0,0 +1,141 @@
+#include "robotStates.hpp"
+
+namespace ai {
+namespace model {
+
+robotStates::robotStates() {
+  clear();
+}
+
+std::size_t robotStates::index(model::teamColor _color, uint32_t _id) {
+  return static_cast<std::size_t>(_color) * world::maxRobots + _id;
+}
+
+void robotStates::clear() {
+  mask_.setConstant(false);
+  x_.setZero();
+  y_.setZero();
+  theta_.setZero();
+  vx_.setZero();
+  vy_.setZero();
+  omega_.setZero();
+  ax_.setZero();
+  ay_.setZero();
+}
+
+bool robotStates::exists(std::size_t _index) const {
+  return mask_(_index);
+}
+
+model::robot robotStates::get(std::size_t _index) const {
+  model::robot r{static_cast<uint32_t>(_index % world::maxRobots), x_(_index), y_(_index),
+                 theta_(_index)};
+  r.vx(vx_(_index));
+  r.vy(vy_(_index));
+  r.omega(omega_(_index));
+  r.ax(ax_(_index));
+  r.ay(ay_(_index));
+  return r;
+}
+
+void robotStates::set(std::size_t _index, const model::robot& _robot) {
+  mask_(_index)  = true;
+  x_(_index)     = _robot.x();
+  y_(_index)     = _robot.y();
+  theta_(_index) = _robot.theta();
+  vx_(_index)    = _robot.vx();
+  vy_(_index)    = _robot.vy();
+  omega_(_index) = _robot.omega();
+  ax_(_index)    = _robot.ax();
+  ay_(_index)    = _robot.ay();
+}
+
+void robotStates::erase(std::size_t _index) {
+  mask_(_index) = false;
+}
+
+void robotStates::load(model::teamColor _color, const world::RobotsList& _robots) {
+  const auto offset = index(_color, 0);
+  mask_.segment<world::maxRobots>(offset).setConstant(false);
+  for (const auto& [id, r] : _robots) set(offset + id, r);
+}
+
+world::RobotsList robotStates::robots(model::teamColor _color) const {
+  const auto offset = index(_color, 0);
+  world::RobotsList result{};
+  for (auto id = 0u; id < world::maxRobots; ++id) {
+    if (mask_(offset + id)) result[id] = get(offset + id);
+  }
+  return result;
+}
+
+const robotStates::MaskType& robotStates::mask() const {
+  return mask_;
+}
+
+robotStates::ColumnType& robotStates::x() {
+  return x_;
+}
+
+robotStates::ColumnType& robotStates::y() {
+  return y_;
+}
+
+robotStates::ColumnType& robotStates::theta() {
+  return theta_;
+}
+
+robotStates::ColumnType& robotStates::vx() {
+  return vx_;
+}
+
+robotStates::ColumnType& robotStates::vy() {
+  return vy_;
+}
+
+robotStates::ColumnType& robotStates::omega() {
+  return omega_;
+}
+
+robotStates::ColumnType& robotStates::ax() {
+  return ax_;
+}
+
+robotStates::ColumnType& robotStates::ay() {
+  return ay_;
+}
+
+const robotStates::ColumnType& robotStates::x() const {
+  return x_;
+}
+
+const robotStates::ColumnType& robotStates::y() const {
+  return y_;
+}
+
+const robotStates::ColumnType& robotStates::theta() const {
+  return theta_;
+}
+
+const robotStates::ColumnType& robotStates::vx() const {
+  return vx_;
+}
+
+const robotStates::ColumnType& robotStates::vy() const {
+  return vy_;
+}
+
+const robotStates::ColumnType& robotStates::omega() const {
+  return omega_;
+}
+
+const robotStates::ColumnType& robotStates::ax() const {
+  return ax_;
+}
+
+const robotStates::ColumnType& robotStates::ay() const {
+  return ay_;
+}
+
+} // namespace model
+} // namespace ai
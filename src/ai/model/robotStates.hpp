@@ -0,0 +1,98 @@
+#ifndef AI_MODEL_ROBOT_STATES_HPP_
+#define AI_MODEL_ROBOT_STATES_HPP_
+
+#include <cstddef>
+#include <stdint.h>
+#include <Eigen/Core>
+
+#include "robot.hpp"
+#include "teamColor.hpp"
+#include "world.hpp"
+
+namespace ai {
+namespace model {
+
+/// @class   robotStates
+/// @brief   両チームの全ロボットの状態を, 成分ごとの配列(SoA)で保持する
+///
+/// 各成分はEigen::Arrayの列として連続に並んでいるので,
+/// 全ロボットに対する同じ計算をSIMD命令でまとめて行うことができる.
+/// ロボットは index(color, id) で求めたスロットに格納される.
+class robotStates {
+public:
+  /// スロットの数 (チーム数 * チームあたりのロボットの最大数)
+  static constexpr std::size_t capacity = 2 * world::maxRobots;
+
+  /// 各成分の列の型
+  using ColumnType = Eigen::Array<double, capacity, 1>;
+  /// 各スロットに対する真偽値の列の型
+  using MaskType = Eigen::Array<bool, capacity, 1>;
+
+  robotStates();
+
+  /// @brief           チームカラーとIDからスロットの番号を求める
+  static std::size_t index(model::teamColor _color, uint32_t _id);
+
+  /// @brief           全てのスロットを空にする
+  void clear();
+
+  /// @brief           スロットに値が格納されているか
+  bool exists(std::size_t _index) const;
+
+  /// @brief           スロットの値をmodel::robotとして取得する
+  model::robot get(std::size_t _index) const;
+
+  /// @brief           スロットに値を格納する
+  void set(std::size_t _index, const model::robot& _robot);
+
+  /// @brief           スロットを空にする
+  void erase(std::size_t _index);
+
+  /// @brief           ロボットのリストを読み込む
+  /// @param color     リストのチームカラー
+  /// @param robots    読み込むロボットのリスト
+  ///
+  /// そのチームのスロットは一度空にされてから, robotsの値で埋められる
+  void load(model::teamColor _color, const world::RobotsList& _robots);
+
+  /// @brief           ロボットのリストを取り出す
+  /// @param color     取り出すチームカラー
+  world::RobotsList robots(model::teamColor _color) const;
+
+  /// @brief           値が格納されているスロット
+  const MaskType& mask() const;
+
+  ColumnType& x();
+  ColumnType& y();
+  ColumnType& theta();
+  ColumnType& vx();
+  ColumnType& vy();
+  ColumnType& omega();
+  ColumnType& ax();
+  ColumnType& ay();
+
+  const ColumnType& x() const;
+  const ColumnType& y() const;
+  const ColumnType& theta() const;
+  const ColumnType& vx() const;
+  const ColumnType& vy() const;
+  const ColumnType& omega() const;
+  const ColumnType& ax() const;
+  const ColumnType& ay() const;
+
+private:
+  MaskType mask_;
+  ColumnType x_;
+  ColumnType y_;
+  ColumnType theta_;
+  ColumnType vx_;
+  ColumnType vy_;
+  ColumnType omega_;
+  ColumnType ax_;
+  ColumnType ay_;
+};
+
+} // namespace model
+} // namespace ai
+
+#endif // AI_MODEL_ROBOT_STATES_HPP_
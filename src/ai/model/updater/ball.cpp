@@ -1,5 +1,8 @@
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <iterator>
+#include <limits>
 
 #include "ai/util/math/affine.hpp"
 #include "ai/util/time.hpp"
@@ -9,7 +12,15 @@ namespace ai {
 namespace model {
 namespace updater {
 
-ball::ball() : ball_{}, affine_{Eigen::Translation3d{.0, .0, .0}} {}
+ball::ball()
+    : ball_{},
+      observations_{},
+      affine_{Eigen::Translation3d{.0, .0, .0}},
+      fusion_(fusionMode::maxConfidence),
+      fusionWindow_(std::chrono::milliseconds{50}),
+      tracking_(false),
+      tracks_{},
+      selected_(maxTracks) {}
 
 model::ball ball::value() const {
   std::shared_lock<std::shared_timed_mutex> lock(mutex_);
@@ -21,14 +32,41 @@ void ball::transformationMatrix(const Eigen::Affine3d& _matrix) {
   affine_ = _matrix;
 }
 
+void ball::fusion(fusionMode _mode) {
+  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+  fusion_ = _mode;
+}
+
+void ball::fusionWindow(util::DurationType _window) {
+  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+  fusionWindow_ = _window;
+}
+
+void ball::tracking(bool _enable) {
+  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+  tracking_ = _enable;
+}
+
+std::size_t ball::tracks() const {
+  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+  return std::count_if(tracks_.cbegin(), tracks_.cend(), [](auto& _t) { return _t.active; });
+}
+
 void ball::update(const ssl_protos::vision::DetectionFrame& _detection) {
   std::unique_lock<std::shared_timed_mutex> lock(mutex_);
 
   // カメラID
-  const auto& cameraId = _detection.camera_id();
+  const auto cameraId = _detection.camera_id();
+  // 扱えないカメラIDのパケットは無視する
+  if (cameraId >= maxCameras) return;
   // キャプチャされた時間
   const auto capturedTime = util::TimePointType{util::toDuration(_detection.t_capture())};
 
+  if (tracking_) {
+    associate(_detection, capturedTime);
+    return;
+  }
+
   // 検出されたボールの中から, 最もconfidenceの高い値を選択候補に登録する
   // FIXME:
   // 現在の実装は, フィールドにボールが1つしかないと仮定している
@@ -38,36 +76,191 @@ void ball::update(const ssl_protos::vision::DetectionFrame& _detection) {
     return _a.confidence() < _b.confidence();
   });
   if (candidate != balls.cend()) {
-    rawBalls_[cameraId] = *candidate;
+    observations_[cameraId] = {true, candidate->confidence(), candidate->x(), candidate->y(),
+                               capturedTime};
   } else {
-    rawBalls_.erase(cameraId);
+    observations_[cameraId].valid = false;
   }
 
-  // 候補の中から, 最もconfidenceの高いボールを求める
-  const auto reliable =
-      std::max_element(rawBalls_.cbegin(), rawBalls_.cend(), [](auto& _a, auto& _b) {
-        return std::get<1>(_a).confidence() < std::get<1>(_b).confidence();
-      });
-
-  if (reliable != rawBalls_.cend()) {
-    // 選択された値のカメラIDとdetectionのカメラIDが一致していたらデータを更新する
-    if (std::get<0>(*reliable) == cameraId) {
-      const auto& value = std::get<1>(*reliable);
-      reliableBall_     = util::math::transform(affine_, model::ball{value.x(), value.y()});
-
-      if (onUpdatedFilter_) {
-        // on_updated_filter_が設定されていたらFilterを通した値を使う
-        ball_ = onUpdatedFilter_->update(*reliableBall_, capturedTime);
-      } else if (!manualFilter_) {
-        // Filterが登録されていない場合はそのままの値を使う
-        ball_.x(reliableBall_->x());
-        ball_.y(reliableBall_->y());
+  if (fusion_ == fusionMode::maxConfidence) {
+    // 候補の中から, 最もconfidenceの高いボールを求める
+    auto reliable = maxCameras;
+    for (auto c = 0u; c < maxCameras; ++c) {
+      if (!observations_[c].valid) continue;
+      if (reliable == maxCameras ||
+          observations_[reliable].confidence < observations_[c].confidence) {
+        reliable = c;
       }
     }
+
+    if (reliable == maxCameras) {
+      // 現時点ではボールが存在しない場合を想定していないので何もしない
+      reliableBall_ = std::nullopt;
+    } else if (reliable == cameraId) {
+      // 選択された値のカメラIDとdetectionのカメラIDが一致していたらデータを更新する
+      const auto& o = observations_[reliable];
+      updateValue(model::ball{o.x, o.y}, capturedTime);
+    }
   } else {
-    // 現時点ではボールが存在しない場合を想定していないので何もしない
+    // 時間窓内の観測値を, confidenceと観測時刻で重み付けして平均する
+    double sw = 0, sx = 0, sy = 0;
+    for (const auto& o : observations_) {
+      if (!o.valid) continue;
+      const auto w = fusionWeight(o.confidence, capturedTime - o.time, fusionWindow_);
+      sw += w;
+      sx += w * o.x;
+      sy += w * o.y;
+    }
+
+    if (sw <= 0) {
+      // 現時点ではボールが存在しない場合を想定していないので何もしない
+      reliableBall_ = std::nullopt;
+    } else if (observations_[cameraId].valid) {
+      // 現在のカメラで検出されていたら, 新しい観測値を含めた値で更新する
+      updateValue(model::ball{sx / sw, sy / sw}, capturedTime);
+    }
+  }
+}
+
+void ball::updateValue(const model::ball& _raw, util::TimePointType _time) {
+  reliableBall_ = util::math::transform(affine_, _raw);
+
+  if (onUpdatedFilter_) {
+    // on_updated_filter_が設定されていたらFilterを通した値を使う
+    ball_ = onUpdatedFilter_->update(*reliableBall_, _time);
+  } else if (!manualFilter_) {
+    // Filterが登録されていない場合はそのままの値を使う
+    ball_.x(reliableBall_->x());
+    ball_.y(reliableBall_->y());
+  }
+}
+
+void ball::associate(const ssl_protos::vision::DetectionFrame& _detection,
+                     util::TimePointType _time) {
+  constexpr auto inf = std::numeric_limits<double>::infinity();
+  using seconds      = std::chrono::duration<double>;
+
+  // 検出されたボールを変換して取り出す
+  std::array<model::ball, maxDetections> detected;
+  std::array<double, maxDetections> confidence;
+  std::size_t numDetected = 0;
+  for (const auto& b : _detection.balls()) {
+    if (numDetected == maxDetections) break;
+    detected[numDetected]   = util::math::transform(affine_, model::ball{b.x(), b.y()});
+    confidence[numDetected] = b.confidence();
+    ++numDetected;
+  }
+
+  // しばらく検出されていない候補の追跡を打ち切る
+  for (auto& t : tracks_) {
+    t.updated = false;
+    if (t.active && std::abs(seconds{_time - t.lastSeen}.count()) > trackTimeout_) {
+      t.active = false;
+    }
+  }
+
+  // 検出値と候補の距離の表を作る (ゲートの外にあるものは無限大にする)
+  std::array<std::array<double, maxTracks>, maxDetections> distance;
+  for (auto i = 0u; i < numDetected; ++i) {
+    for (auto j = 0u; j < maxTracks; ++j) {
+      const auto& t  = tracks_[j];
+      distance[i][j] = inf;
+      if (!t.active) continue;
+      const auto dt   = std::abs(seconds{_time - t.lastSeen}.count());
+      const auto gate = gateRadius_ + maxSpeed_ * dt;
+      const auto d    = std::hypot(detected[i].x() - t.raw.x(), detected[i].y() - t.raw.y());
+      if (d <= gate) distance[i][j] = d;
+    }
+  }
+
+  // 距離の近い組から順に, 検出値を候補に割り当てる
+  std::array<std::size_t, maxDetections> assigned;
+  assigned.fill(maxTracks);
+  std::array<bool, maxTracks> used{};
+  while (true) {
+    auto best = inf;
+    auto bi   = maxDetections;
+    auto bj   = maxTracks;
+    for (auto i = 0u; i < numDetected; ++i) {
+      if (assigned[i] != maxTracks) continue;
+      for (auto j = 0u; j < maxTracks; ++j) {
+        if (!used[j] && distance[i][j] < best) {
+          best = distance[i][j];
+          bi   = i;
+          bj   = j;
+        }
+      }
+    }
+    if (bi == maxDetections) break;
+    assigned[bi] = bj;
+    used[bj]     = true;
+  }
+
+  for (auto i = 0u; i < numDetected; ++i) {
+    auto j = assigned[i];
+    if (j == maxTracks) {
+      // どの候補のゲート内にもない検出値は新たな候補として追跡を始める
+      // (ゲート内にあるが割り当てられなかったものは, 同じボールの重複とみなして無視する)
+      const auto inGate = std::any_of(distance[i].cbegin(), distance[i].cend(),
+                                      [](auto _d) { return std::isfinite(_d); });
+      if (inGate) continue;
+      const auto it =
+          std::find_if(tracks_.begin(), tracks_.end(), [](auto& _t) { return !_t.active; });
+      // 空いている枠がなければ諦める
+      if (it == tracks_.end()) continue;
+
+      j            = static_cast<std::size_t>(std::distance(tracks_.begin(), it));
+      it->active   = true;
+      it->score    = 0;
+      it->lastSeen = _time;
+      it->filter   = trackFilterInitializer_ ? trackFilterInitializer_() : nullptr;
+    }
+
+    // 候補の値を更新する
+    auto& t    = tracks_[j];
+    t.score    = score(t, _time) + confidence[i];
+    t.lastSeen = _time;
+    t.raw      = detected[i];
+    t.value    = t.filter ? t.filter->update(t.raw, _time) : t.raw;
+    t.updated  = true;
+  }
+
+  // 最もボールらしい候補を選ぶ
+  // 候補が頻繁に切り替わらないように, 選ばれている候補を優先する
+  auto best = maxTracks;
+  for (auto j = 0u; j < maxTracks; ++j) {
+    if (!tracks_[j].active) continue;
+    if (best == maxTracks || score(tracks_[best], _time) < score(tracks_[j], _time)) best = j;
+  }
+  if (best == maxTracks) {
+    selected_     = maxTracks;
     reliableBall_ = std::nullopt;
+    return;
   }
+  if (selected_ == maxTracks || !tracks_[selected_].active ||
+      score(tracks_[selected_], _time) * switchRatio_ < score(tracks_[best], _time)) {
+    selected_ = best;
+  }
+
+  // 選ばれた候補が現在のフレームで検出されていたら値を更新する
+  const auto& t = tracks_[selected_];
+  if (t.updated) {
+    reliableBall_ = t.raw;
+    if (manualFilter_) return;
+    if (t.filter) {
+      // 候補のFilterが設定されていたらFilterを通した値を使う
+      ball_ = t.value;
+    } else {
+      // Filterが設定されていない場合はそのままの値を使う
+      ball_.x(t.raw.x());
+      ball_.y(t.raw.y());
+    }
+  }
+}
+
+double ball::score(const track& _track, util::TimePointType _time) const {
+  const auto dt = std::chrono::duration<double>{_time - _track.lastSeen}.count();
+  return _track.score * std::exp(-std::abs(dt) / scoreTau_);
 }
 
 void ball::clearFilter() {
@@ -1,16 +1,19 @@
 #ifndef AI_MODEL_UPDATER_BALL_HPP_
 #define AI_MODEL_UPDATER_BALL_HPP_
 
+#include <array>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <shared_mutex>
 #include <type_traits>
-#include <unordered_map>
 
 #include <Eigen/Geometry>
 
 #include "ai/filter/base.hpp"
 #include "ai/model/ball.hpp"
+#include "ai/util/time.hpp"
+#include "fusion.hpp"
 #include "ssl-protos/vision/detection.pb.h"
 
 namespace ai {
@@ -25,6 +28,42 @@ class ball {
   /// 更新タイミングがmanualなFilterの型
   using ManualFilterType = filter::base<model::ball, filter::timing::Manual>;
 
+  /// あるカメラで検出されたボールの生データ
+  struct observation {
+    /// このカメラで検出されているか
+    bool valid;
+    double confidence;
+    double x;
+    double y;
+    /// キャプチャされた時刻
+    util::TimePointType time;
+  };
+
+public:
+  /// 同時に追跡できるボールの数
+  static constexpr std::size_t maxTracks = 8;
+  /// 1つのDetectionパケットから取り出すボールの数の上限
+  static constexpr std::size_t maxDetections = 16;
+
+private:
+  /// 追跡しているボールの候補
+  struct track {
+    /// 追跡中か
+    bool active;
+    /// このフレームで値が更新されたか
+    bool updated;
+    /// ボールらしさ (confidenceの時間減衰付きの累計)
+    double score;
+    /// 最後に検出された時刻
+    util::TimePointType lastSeen;
+    /// 最後に検出された値
+    model::ball raw;
+    /// Filterを通した値
+    model::ball value;
+    /// この候補のFilter
+    std::shared_ptr<OnUpdatedFilterType> filter;
+  };
+
 public:
   ball();
 
@@ -42,6 +81,39 @@ public:
   /// @param matrix    変換行列
   void transformationMatrix(const Eigen::Affine3d& _matrix);
 
+  /// @brief           複数のカメラの観測値をまとめる方法を設定する
+  /// @param mode      まとめる方法 (デフォルトはfusionMode::maxConfidence)
+  ///
+  /// fusionMode::weightedでは, 現在のカメラでボールが検出されたときだけ値が更新される
+  void fusion(fusionMode _mode);
+
+  /// @brief           fusionMode::weightedで平均する観測値の時間窓を設定する
+  /// @param window    時間窓 (デフォルトは50ms)
+  void fusionWindow(util::DurationType _window);
+
+  /// @brief           複数のボールの候補を追跡するかを設定する
+  /// @param enable    追跡するか (デフォルトはfalse)
+  ///
+  /// 追跡する場合, 検出された全てのボールを, ゲート付きの最近傍法で候補に割り当てる.
+  /// 候補ごとにsetTrackFilter()で設定したFilterを持ち,
+  /// 最もボールらしい候補の値が最終的な値になる.
+  /// このときfusion()の設定とsetFilter()で設定した更新タイミングがon_updatedなFilterは使われない
+  void tracking(bool _enable);
+
+  /// @brief           追跡しているボールの候補の数を返す
+  std::size_t tracks() const;
+
+  /// @brief           ボールの候補ごとに使うFilterを設定する
+  /// @param args      Filterの引数
+  ///
+  /// Filterは新しい候補の追跡を始めたときに初期化される
+  template <class Filter, class... Args>
+  auto setTrackFilter(Args... _args)
+      -> std::enable_if_t<std::is_base_of<OnUpdatedFilterType, Filter>::value> {
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+    trackFilterInitializer_ = [_args...] { return std::make_shared<Filter>(_args...); };
+  }
+
   /// @brief           設定されたFilterを解除する
   void clearFilter();
 
@@ -88,13 +160,27 @@ public:
   }
 
 private:
+  /// @brief           選ばれた観測値で値を更新する
+  /// @param raw       変換前の観測値
+  /// @param time      キャプチャされた時刻
+  void updateValue(const model::ball& _raw, util::TimePointType _time);
+
+  /// @brief           Detectionパケットで検出された全てのボールで候補を更新する
+  /// @param detection SSL-VisionのDetectionパケット
+  /// @param time      キャプチャされた時刻
+  void associate(const ssl_protos::vision::DetectionFrame& _detection,
+                 util::TimePointType _time);
+
+  /// @brief           時刻timeにおける候補のボールらしさを返す
+  double score(const track& _track, util::TimePointType _time) const;
+
   mutable std::shared_timed_mutex mutex_;
 
   /// 最終的な値
   model::ball ball_;
 
-  /// 各カメラで検出されたボールの生データ
-  std::unordered_map<uint32_t, ssl_protos::vision::DetectionBall> rawBalls_;
+  /// 各カメラで検出されたボールの生データ (添字はカメラID)
+  std::array<observation, maxCameras> observations_;
   /// 検出された中から選ばれた, 最も確かとされる値
   std::optional<model::ball> reliableBall_;
 
@@ -105,6 +191,32 @@ private:
 
   /// 変換行列
   Eigen::Affine3d affine_;
+
+  /// 観測値をまとめる方法
+  fusionMode fusion_;
+  /// fusionMode::weightedで平均する観測値の時間窓
+  util::DurationType fusionWindow_;
+
+  /// 候補に割り当てる検出値の, 候補からの最大距離 [mm]
+  /// 候補が最後に検出されてからの経過時間に応じて, maxSpeed_ * dtだけ広げる
+  static constexpr double gateRadius_ = 200.0;
+  /// ボールの最大速度 [mm/s]
+  static constexpr double maxSpeed_ = 8000.0;
+  /// 検出されなくなった候補の追跡を打ち切るまでの時間 [s]
+  static constexpr double trackTimeout_ = 1.0;
+  /// ボールらしさが減衰する時定数 [s]
+  static constexpr double scoreTau_ = 0.5;
+  /// 選ばれている候補を切り替えるのに必要な, ボールらしさの比
+  static constexpr double switchRatio_ = 2.0;
+
+  /// 複数のボールの候補を追跡するか
+  bool tracking_;
+  /// ボールの候補 (あらかじめ確保しておいた枠を使い回す)
+  std::array<track, maxTracks> tracks_;
+  /// 最終的な値として選ばれている候補 (maxTracksなら選ばれていない)
+  std::size_t selected_;
+  /// 候補のFilterを初期化するための関数オブジェクト
+  std::function<std::shared_ptr<OnUpdatedFilterType>()> trackFilterInitializer_;
 };
 
 } // namespace updater
@@ -7,7 +7,7 @@ namespace ai {
 namespace model {
 namespace updater {
 
-field::field() : field_{} {}
+field::field() : field_{}, map_(model::fieldMap::standard()) {}
 
 void field::update(const ssl_protos::vision::GeometryData& _geometry) {
   std::unique_lock<std::shared_timed_mutex> lock(mutex_);
@@ -23,6 +23,9 @@ void field::update(const ssl_protos::vision::GeometryData& _geometry) {
       field_.centerRadius(arc.radius());
     }
   }
+
+  // 形状が変わっていれば, ここで距離マップを作り直しておく
+  map_ = model::fieldMap::update(map_, field_);
 }
 
 model::field field::value() const {
@@ -30,6 +33,11 @@ model::field field::value() const {
   return field_;
 }
 
+std::shared_ptr<const model::fieldMap> field::map() const {
+  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+  return map_;
+}
+
 } // namespace updater
 } // namespace model
 } // namespace ai
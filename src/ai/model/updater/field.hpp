@@ -1,8 +1,10 @@
 #ifndef AI_MODEL_UPDATER_FIELD_HPP_
 #define AI_MODEL_UPDATER_FIELD_HPP_
 
+#include <memory>
 #include <shared_mutex>
 #include "ai/model/field.hpp"
+#include "ai/model/fieldMap.hpp"
 
 // 前方宣言
 namespace ssl_protos {
@@ -20,6 +22,7 @@ namespace updater {
 class field {
   mutable std::shared_timed_mutex mutex_;
   model::field field_;
+  std::shared_ptr<const model::fieldMap> map_;
 
 public:
   field();
@@ -33,6 +36,11 @@ public:
 
   /// @brief          値を取得する
   model::field value() const;
+
+  /// @brief          現在のフィールドの距離マップを取得する
+  ///
+  /// 距離マップはGeometryパケットで形状が変わったときにだけ作り直される
+  std::shared_ptr<const model::fieldMap> map() const;
 };
 
 } // namespace updater
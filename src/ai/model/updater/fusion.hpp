@@ -0,0 +1,43 @@
+#ifndef AI_MODEL_UPDATER_FUSION_HPP_
+#define AI_MODEL_UPDATER_FUSION_HPP_
+
+#include <chrono>
+#include <cstddef>
+
+#include "ai/util/time.hpp"
+
+namespace ai {
+namespace model {
+namespace updater {
+
+/// 扱えるカメラの数 (これ以上のカメラIDのパケットは無視される)
+constexpr std::size_t maxCameras = 8;
+
+/// @brief   複数のカメラで検出された同じ物体の観測値を1つにまとめる方法
+enum class fusionMode {
+  /// 最もconfidenceの高い観測値だけを使う
+  maxConfidence,
+  /// 時間窓内の全ての観測値を, confidenceと観測時刻で重み付けして平均する
+  weighted
+};
+
+/// @brief           重み付き平均で使う観測値の重みを求める
+/// @param confidence 観測値のconfidence
+/// @param age       観測値が得られた時刻と現在の時刻の差
+/// @param window    平均する観測値の時間窓
+/// @return          重み. 時間窓の外にある観測値の重みは0になる
+///
+/// 重みはconfidenceに比例し, 観測値が古くなるにつれて線形に小さくなる
+inline double fusionWeight(double _confidence, util::DurationType _age,
+                           util::DurationType _window) {
+  const auto age = _age < util::DurationType::zero() ? -_age : _age;
+  if (age >= _window) return 0.0;
+  return _confidence * (1.0 - std::chrono::duration<double>{age}.count() /
+                                  std::chrono::duration<double>{_window}.count());
+}
+
+} // namespace updater
+} // namespace model
+} // namespace ai
+
+#endif // AI_MODEL_UPDATER_FUSION_HPP_
@@ -1,4 +1,4 @@
-#include <algorithm>
+#include <cmath>
 
 #include "ai/util/math/affine.hpp"
 #include "ai/util/time.hpp"
@@ -20,7 +20,11 @@ const robot<model::teamColor::Yellow>::SourceFunctionPointerType
     robot<model::teamColor::Yellow>::src_ = &ssl_protos::vision::DetectionFrame::robots_yellow;
 
 template <model::teamColor Color>
-robot<Color>::robot() : affine_{Eigen::Translation3d{.0, .0, .0}} {}
+robot<Color>::robot()
+    : observations_{},
+      affine_{Eigen::Translation3d{.0, .0, .0}},
+      fusion_(fusionMode::maxConfidence),
+      fusionWindow_(std::chrono::milliseconds{50}) {}
 
 template <model::teamColor Color>
 void robot<Color>::update(const ssl_protos::vision::DetectionFrame& _detection) {
@@ -28,82 +32,80 @@ void robot<Color>::update(const ssl_protos::vision::DetectionFrame& _detection)
 
   // カメラID
   const auto cameraId = _detection.camera_id();
+  // 扱えないカメラIDのパケットは無視する
+  if (cameraId >= maxCameras) return;
   // キャプチャされた時間
   const auto capturedTime = util::TimePointType{util::toDuration(_detection.t_capture())};
 
-  // 保持している生データを更新する
-  rawRobots_[cameraId] = (_detection.*src_)();
-
-  // カメラIDをKeyに, 各カメラで検出されたロボットの情報を保持しているraw_robots_から
-  // | Key(cam_id) | Value({Robot})           |
-  // | ----------- | ------------------------ |
-  // |           0 | {Robot(ID0), Robot(ID1)} |
-  // |           1 | {Robot(ID1), Robot(ID2)} |
-  // ロボットIDをKeyに,
-  // 1つ以上のロボットの情報をカメラIDとともに保持するハッシュテーブルを作る
-  // | Key(robo_id)  | Value({cam_id, Robot})                       |
-  // | ------------- | -------------------------------------------- |
-  // |             0 | {{cam_id, Robot(ID0)}}                       |
-  // |             1 | {{cam_id, Robot(ID1)}, {cam_id, Robot(ID1)}} |
-  // |             2 | {{cam_id, Robot(ID2)}}                       |
-  const auto candidates = [this] {
-    using RobotWithCameraId = std::tuple<uint32_t, RawDataArrayType::const_iterator>;
-    std::unordered_multimap<uint32_t, RobotWithCameraId> table{};
-    for (auto it1 = rawRobots_.cbegin(); it1 != rawRobots_.cend(); ++it1) {
-      const auto& robotsList = it1->second;
-      for (auto it2 = robotsList.cbegin(); it2 != robotsList.cend(); ++it2) {
-        table.emplace(it2->robot_id(), std::forward_as_tuple(it1->first, it2));
-      }
+  // 保持している生データのうち, このカメラの列だけを入れ替える
+  // | robot_id \ cam_id | 0          | 1          | ... |
+  // | ----------------- | ---------- | ---------- | --- |
+  // |                 0 | Robot(ID0) | -          |     |
+  // |                 1 | Robot(ID1) | Robot(ID1) |     |
+  // |                 2 | -          | Robot(ID2) |     |
+  for (auto& o : observations_) o[cameraId].valid = false;
+  for (const auto& r : (_detection.*src_)()) {
+    // 扱えない範囲のIDは誤検出として無視する
+    if (!RobotsListType::acceptable(r.robot_id())) continue;
+    // 同じカメラで同じIDのロボットが複数検出された場合は, 最もconfidenceの高いものを使う
+    auto& o = observations_[r.robot_id()][cameraId];
+    if (!o.valid || o.confidence < r.confidence()) {
+      const double theta = r.orientation();
+      o = {true, r.confidence(), r.x(), r.y(), theta, std::cos(theta), std::sin(theta),
+           capturedTime};
     }
-    return table;
-  }();
-
-  // 作ったハッシュテーブルから, 各IDの最もconfidenceの高い要素を選択して値の更新を行う
-  RobotsListType reliables{};
-  for (auto it = candidates.cbegin(); it != candidates.cend();) {
-    const auto robotId = it->first;
-
-    // IDがrobot_idのロボットの中で, 最もconfidenceの高い値を選択する
-    const auto range    = candidates.equal_range(robotId);
-    const auto reliable = std::max_element(range.first, range.second, [](auto& _a, auto& _b) {
-      return std::get<1>(_a.second)->confidence() < std::get<1>(_b.second)->confidence();
-    });
-
-    // その値が検出されたカメラIDとdetectionのカメラIDを比較
-    if (std::get<0>(reliable->second) == cameraId) {
-      // 一致していたら値の更新を行う
-      // (現在のカメラで新たに検出された or
-      // 現在のカメラで検出された値のほうがconfidenceが高かった)
-      const auto value   = util::math::transform(affine_, [reliable] {
-        const auto r = std::get<1>(reliable->second);
-        return model::robot{r->robot_id(), r->x(), r->y(), r->orientation()};
-      }());
-      reliables[robotId] = value;
-
-      // 2つのFilterが設定されておらず, かつfilter_initializer_が設定されていたら
-      // filter_initializer_でFilterを初期化する
-      if (filterInitializer_ && !onUpdatedFilters_.count(robotId) &&
-          !manualFilters_.count(robotId)) {
-        onUpdatedFilters_[robotId] = filterInitializer_();
+  }
+
+  // 各IDについて, 全カメラの観測値から値を求めて更新を行う
+  for (auto robotId = 0u; robotId < RobotsListType::capacity(); ++robotId) {
+    const auto& row = observations_[robotId];
+
+    if (fusion_ == fusionMode::maxConfidence) {
+      // 最もconfidenceの高い値を選択する
+      auto reliable = maxCameras;
+      for (auto c = 0u; c < maxCameras; ++c) {
+        if (!row[c].valid) continue;
+        if (reliable == maxCameras || row[reliable].confidence < row[c].confidence) {
+          reliable = c;
+        }
       }
 
-      if (onUpdatedFilters_.count(robotId)) {
-        // on_updated_filter_が設定されていたらFilterを通した値を使う
-        robots_[robotId] = onUpdatedFilters_.at(robotId)->update(value, capturedTime);
-      } else if (!manualFilters_.count(robotId)) {
-        // Filterが登録されていない場合はそのままの値を使う
-        robots_[robotId] = value;
+      if (reliable == maxCameras) {
+        // フィールド全体で検出されなかった
+        reliableRobots_.erase(robotId);
+      } else if (reliable == cameraId) {
+        // 現在のカメラで検出された値が選ばれたら値の更新を行う
+        // (現在のカメラで新たに検出された or
+        // 現在のカメラで検出された値のほうがconfidenceが高かった)
+        const auto& o = row[reliable];
+        updateValue(model::robot{robotId, o.x, o.y, o.theta}, capturedTime);
       }
-    } else {
-      // カメラIDが一致しないときは前の値を引き継ぐ
+      // 他のカメラの値が選ばれたときは前の値を引き継ぐ
       // (現在のカメラで検出されたがconfidenceが低かった or 現在のカメラで検出されなかった)
-      reliables[robotId] = reliableRobots_.at(robotId);
-    }
+    } else {
+      // 時間窓内の観測値を, confidenceと観測時刻で重み付けして平均する
+      // 角度は境界で値が飛ばないように, 単位ベクトルの平均から求める
+      double sw = 0, sx = 0, sy = 0, ss = 0, sc = 0;
+      for (const auto& o : row) {
+        if (!o.valid) continue;
+        const auto w = fusionWeight(o.confidence, capturedTime - o.time, fusionWindow_);
+        sw += w;
+        sx += w * o.x;
+        sy += w * o.y;
+        ss += w * o.sinTheta;
+        sc += w * o.cosTheta;
+      }
 
-    // イテレータを次のロボットIDの位置まで進める
-    it = range.second;
+      if (sw <= 0) {
+        // 時間窓内にどのカメラでも検出されなかった
+        reliableRobots_.erase(robotId);
+      } else if (row[cameraId].valid) {
+        // 現在のカメラで検出されていたら, 新しい観測値を含めた値で更新する
+        updateValue(model::robot{robotId, sx / sw, sy / sw, std::atan2(ss, sc)}, capturedTime);
+      }
+      // 現在のカメラで検出されなかったときは前の値を引き継ぐ
+    }
   }
-  reliableRobots_ = std::move(reliables);
 
   // 最終的なデータのリストから, フィールド全体で検出されなかったIDを取り除く
   // ただし, manual_filterが設定されている場合は例外とする
@@ -117,6 +119,28 @@ void robot<Color>::update(const ssl_protos::vision::DetectionFrame& _detection)
   }
 }
 
+template <model::teamColor Color>
+void robot<Color>::updateValue(const model::robot& _raw, util::TimePointType _time) {
+  const auto robotId       = _raw.id();
+  const auto value         = util::math::transform(affine_, _raw);
+  reliableRobots_[robotId] = value;
+
+  // 2つのFilterが設定されておらず, かつfilter_initializer_が設定されていたら
+  // filter_initializer_でFilterを初期化する
+  if (filterInitializer_ && !onUpdatedFilters_.count(robotId) &&
+      !manualFilters_.count(robotId)) {
+    onUpdatedFilters_[robotId] = filterInitializer_();
+  }
+
+  if (onUpdatedFilters_.count(robotId)) {
+    // on_updated_filter_が設定されていたらFilterを通した値を使う
+    robots_[robotId] = onUpdatedFilters_.at(robotId)->update(value, _time);
+  } else if (!manualFilters_.count(robotId)) {
+    // Filterが登録されていない場合はそのままの値を使う
+    robots_[robotId] = value;
+  }
+}
+
 template <model::teamColor Color>
 typename robot<Color>::RobotsListType robot<Color>::value() const {
   std::shared_lock<std::shared_timed_mutex> lock(mutex_);
@@ -129,6 +153,18 @@ void robot<Color>::transformationMatrix(const Eigen::Affine3d& matrix) {
   affine_ = matrix;
 }
 
+template <model::teamColor Color>
+void robot<Color>::fusion(fusionMode _mode) {
+  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+  fusion_ = _mode;
+}
+
+template <model::teamColor Color>
+void robot<Color>::fusionWindow(util::DurationType _window) {
+  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+  fusionWindow_ = _window;
+}
+
 template <model::teamColor Color>
 void robot<Color>::clearFilter(uint32_t _id) {
   std::unique_lock<std::shared_timed_mutex> lock(mutex_);
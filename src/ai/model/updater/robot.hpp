@@ -1,6 +1,7 @@
 #ifndef AI_MODEL_UPDATER_ROBOT_HPP_
 #define AI_MODEL_UPDATER_ROBOT_HPP_
 
+#include <array>
 #include <functional>
 #include <memory>
 #include <shared_mutex>
@@ -14,6 +15,9 @@
 #include "ai/filter/base.hpp"
 #include "ai/model/robot.hpp"
 #include "ai/model/teamColor.hpp"
+#include "ai/model/world.hpp"
+#include "ai/util/time.hpp"
+#include "fusion.hpp"
 #include "ssl-protos/vision/detection.pb.h"
 
 namespace ai {
@@ -24,13 +28,28 @@ namespace updater {
 /// @brief   SSL-VisionのDetectionパケットでロボットの情報を更新する
 template <model::teamColor Color>
 class robot {
-  /// KeyがID, Valueがロボットのハッシュテーブルの型
-  using RobotsListType = std::unordered_map<uint32_t, model::robot>;
+  /// KeyがID, Valueがロボットのテーブルの型
+  using RobotsListType = model::world::RobotsList;
 
   /// 生データの型
   using RawDataType = ssl_protos::vision::DetectionRobot;
   /// 生データが格納されている配列の型
   using RawDataArrayType = google::protobuf::RepeatedPtrField<RawDataType>;
+
+  /// あるカメラで検出されたロボットの生データ
+  struct observation {
+    /// このカメラで検出されているか
+    bool valid;
+    double confidence;
+    double x;
+    double y;
+    double theta;
+    /// 角度の単位ベクトル (fusionMode::weightedで使う)
+    double cosTheta;
+    double sinTheta;
+    /// キャプチャされた時刻
+    util::TimePointType time;
+  };
   /// ロボットの生データを取得するFrameのメンバ関数へのポインタの型
   using SourceFunctionPointerType =
       const RawDataArrayType& (ssl_protos::vision::DetectionFrame::*)() const;
@@ -41,12 +60,18 @@ class robot {
   using ManualFilterType = filter::base<model::robot, filter::timing::Manual>;
 
 public:
+  /// 扱えるカメラの数 (これ以上のカメラIDのパケットは無視される)
+  static constexpr std::size_t maxCameras = updater::maxCameras;
+
   robot();
   robot(const robot&) = delete;
   robot& operator=(const robot&) = delete;
 
-  /// @brief           Detectionパケットを処理し, ボールの情報を更新する
+  /// @brief           Detectionパケットを処理し, ロボットの情報を更新する
   /// @param detection SSL-VisionのDetectionパケット
+  ///
+  /// パケットを受信したカメラの生データだけを入れ替え, 各IDの値を選び直す.
+  /// 処理にかかる時間は (ロボットの数) * (カメラの数) に比例し, 動的なメモリ確保は行わない
   void update(const ssl_protos::vision::DetectionFrame& _detection);
 
   /// @brief           値を取得する
@@ -56,6 +81,17 @@ public:
   /// @param matrix    変換行列
   void transformationMatrix(const Eigen::Affine3d& _matrix);
 
+  /// @brief           複数のカメラの観測値をまとめる方法を設定する
+  /// @param mode      まとめる方法 (デフォルトはfusionMode::maxConfidence)
+  ///
+  /// fusionMode::weightedでは, 現在のカメラで検出されたIDの値だけが更新される.
+  /// また, 時間窓内にどのカメラでも検出されなかったIDは取り除かれる
+  void fusion(fusionMode _mode);
+
+  /// @brief           fusionMode::weightedで平均する観測値の時間窓を設定する
+  /// @param window    時間窓 (デフォルトは50ms)
+  void fusionWindow(util::DurationType _window);
+
   /// @brief           設定されたFilterを解除する
   /// @param id        Filterを解除するロボットのID
   void clearFilter(uint32_t _id);
@@ -134,6 +170,11 @@ public:
   }
 
 private:
+  /// @brief           選ばれた観測値で値を更新する
+  /// @param raw       変換前の観測値
+  /// @param time      キャプチャされた時刻
+  void updateValue(const model::robot& _raw, util::TimePointType _time);
+
   mutable std::shared_timed_mutex mutex_;
 
   /// ロボットの生データを取得するFrameのメンバ関数へのポインタ
@@ -143,8 +184,8 @@ private:
   /// 最終的な値
   RobotsListType robots_;
 
-  /// 各カメラで検出されたロボットの生データ (KeyはカメラID)
-  std::unordered_map<uint32_t, RawDataArrayType> rawRobots_;
+  /// 各カメラで検出されたロボットの生データ (observations_[ロボットID][カメラID])
+  std::array<std::array<observation, maxCameras>, RobotsListType::capacity()> observations_;
   /// 検出された中から選ばれた, 各IDの最も確かとされる値のリスト
   RobotsListType reliableRobots_;
 
@@ -157,6 +198,11 @@ private:
 
   /// 変換行列
   Eigen::Affine3d affine_;
+
+  /// 観測値をまとめる方法
+  fusionMode fusion_;
+  /// fusionMode::weightedで平均する観測値の時間窓
+  util::DurationType fusionWindow_;
 };
 
 } // namespace updater
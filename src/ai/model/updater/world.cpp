@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "ai/util/math/affine.hpp"
 #include "world.hpp"
 #include "ssl-protos/vision/wrapper.pb.h"
@@ -6,6 +8,14 @@ namespace ai {
 namespace model {
 namespace updater {
 
+world::world() : captureTime_{}, version_{0} {
+  publish();
+}
+
+void world::update(std::shared_ptr<const ssl_protos::vision::WrapperPacket> _packet) {
+  update(*_packet);
+}
+
 void world::update(const ssl_protos::vision::WrapperPacket& _packet) {
   if (_packet.has_detection()) {
     const auto& detection = _packet.detection();
@@ -19,16 +29,39 @@ void world::update(const ssl_protos::vision::WrapperPacket& _packet) {
     ball_.update(detection);
     robotsBlue_.update(detection);
     robotsYellow_.update(detection);
+
+    // Vision内での処理時間だけ受信時刻から遡った時刻をキャプチャ時刻とする
+    const auto latency = std::max(detection.t_sent() - detection.t_capture(), 0.0);
+    captureTime_       = util::ClockType::now() - util::toDuration(latency);
   }
 
   if (_packet.has_geometry()) {
     const auto& geometry = _packet.geometry();
     field_.update(geometry);
   }
+
+  publish();
 }
 
 model::world world::value() const {
-  return {field_.value(), ball_.value(), robotsBlue_.value(), robotsYellow_.value()};
+  return *snapshot();
+}
+
+std::shared_ptr<const model::world> world::snapshot() const {
+  return std::atomic_load(&snapshot_);
+}
+
+uint64_t world::version() const {
+  return version_.load(std::memory_order_acquire);
+}
+
+void world::publish() {
+  // 距離マップは作り直さず, field_が持っているものをスナップショットに載せる
+  auto next = std::make_shared<model::world>(field_.value(), ball_.value(), robotsBlue_.value(),
+                                             robotsYellow_.value(), field_.map());
+  next->captureTime(captureTime_);
+  std::atomic_store(&snapshot_, std::shared_ptr<const model::world>{std::move(next)});
+  version_.fetch_add(1, std::memory_order_release);
 }
 
 void world::transformationMatrix(const Eigen::Affine3d& _matrix) {
@@ -1,6 +1,8 @@
 #ifndef AI_MODEL_UPDATER_WORLD_HPP_
 #define AI_MODEL_UPDATER_WORLD_HPP_
 
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <Eigen/Geometry>
 #include <stdint.h>
@@ -34,18 +36,54 @@ class world {
   /// 無効化されたカメラID
   std::vector<uint32_t> disabledCamera_;
 
+  /// 最後に受け取ったフレームのキャプチャ時刻 (このプロセスの時計で表したもの)
+  util::TimePointType captureTime_;
+
+  /// 最後に公開されたWorldModelのスナップショット
+  /// std::atomic_load/std::atomic_storeでのみアクセスする
+  std::shared_ptr<const model::world> snapshot_;
+  /// snapshot_が公開されるたびに増加する番号
+  std::atomic<uint64_t> version_;
+
 public:
-  world()             = default;
+  world();
   world(const world&) = delete;
   world& operator=(const world&) = delete;
 
   /// @brief                  内部の状態を更新する
   /// @param packet           SSL-Visionのパース済みパケット
+  ///
+  /// 各updaterを更新した後, 新しいスナップショットを公開する.
+  /// VisionとAIの時計は同期しているとは限らないので, キャプチャ時刻は受信した時刻から
+  /// Visionでの処理時間(t_sent - t_capture)を引いて求める
   void update(const ssl_protos::vision::WrapperPacket& _packet);
 
+  /// @brief                  内部の状態を更新する
+  /// @param packet           SSL-Visionのパース済みパケット
+  ///
+  /// receiver::visionから受け取ったパケットをそのまま渡すためのもの.
+  /// 必要な値は各updaterに取り出されるので, パケットの参照は保持されない
+  void update(std::shared_ptr<const ssl_protos::vision::WrapperPacket> _packet);
+
   /// @brief           値を取得する
+  ///
+  /// 最新のスナップショットのコピーを返す
   model::world value() const;
 
+  /// @brief           最新のスナップショットを取得する
+  /// @return          不変なWorldModelへのポインタ
+  ///
+  /// スナップショットはupdate()で1フレーム分の処理が終わったときにまとめて公開されるので,
+  /// 得られる値は常に同じフレームのもので揃っている.
+  /// 読み出し側はコピーもupdaterのロックも必要としない.
+  std::shared_ptr<const model::world> snapshot() const;
+
+  /// @brief           スナップショットの版数を取得する
+  ///
+  /// 新しいスナップショットが公開されるたびに1増える.
+  /// 前回の値と比較することで, 新しいフレームが届いたか調べることができる
+  uint64_t version() const;
+
   /// @brief           updaterに変換行列を設定する
   /// @param matrix    変換行列
   void transformationMatrix(const Eigen::Affine3d& _matrix);
@@ -75,6 +113,10 @@ public:
   robot<model::teamColor::Blue>& robotsBlueUpdater();
   /// @brief           黄ロボットのupdaterを取得する
   robot<model::teamColor::Yellow>& robotsYellowUpdater();
+
+private:
+  /// @brief           各updaterの値から新しいスナップショットを作り公開する
+  void publish();
 };
 
 } // namespace updater
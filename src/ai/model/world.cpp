@@ -4,27 +4,40 @@
 
 namespace ai {
 namespace model {
-world::world() : field_{}, ball_{}, robotsBlue_{}, robotsYellow_{} {}
+world::world()
+    : field_{},
+      fieldMap_(model::fieldMap::standard()),
+      ball_{},
+      robotsBlue_{},
+      robotsYellow_{},
+      captureTime_{} {}
 
 world::world(model::field&& _field, model::ball&& _ball, RobotsList&& _robotsBlue,
-             RobotsList&& _robotsYellow)
+             RobotsList&& _robotsYellow, std::shared_ptr<const model::fieldMap> _fieldMap)
     : field_(std::move(_field)),
+      fieldMap_(model::fieldMap::update(_fieldMap ? _fieldMap : model::fieldMap::standard(),
+                                        field_)),
       ball_(std::move(_ball)),
       robotsBlue_(std::move(_robotsBlue)),
-      robotsYellow_(std::move(_robotsYellow)) {}
+      robotsYellow_(std::move(_robotsYellow)),
+      captureTime_{} {}
 
 world::world(const world& _others)
     : field_(_others.field()),
+      fieldMap_(_others.fieldMap()),
       ball_(_others.ball()),
       robotsBlue_(_others.robotsBlue()),
-      robotsYellow_(_others.robotsYellow()) {}
+      robotsYellow_(_others.robotsYellow()),
+      captureTime_(_others.captureTime()) {}
 
-world::world(world&& _others) {
+world::world(world&& _others) : fieldMap_(model::fieldMap::standard()), captureTime_{} {
   std::unique_lock<std::shared_timed_mutex> lock(_others.mutex_);
   std::swap(field_, _others.field_);
+  std::swap(fieldMap_, _others.fieldMap_);
   std::swap(ball_, _others.ball_);
   std::swap(robotsBlue_, _others.robotsBlue_);
   std::swap(robotsYellow_, _others.robotsYellow_);
+  std::swap(captureTime_, _others.captureTime_);
 }
 
 world& world::operator=(const world& _others) {
@@ -32,9 +45,11 @@ world& world::operator=(const world& _others) {
   std::shared_lock<std::shared_timed_mutex> lock2(_others.mutex_, std::defer_lock);
   std::lock(lock1, lock2);
   field_        = _others.field_;
+  fieldMap_     = _others.fieldMap_;
   ball_         = _others.ball_;
   robotsBlue_   = _others.robotsBlue_;
   robotsYellow_ = _others.robotsYellow_;
+  captureTime_  = _others.captureTime_;
   return *this;
 }
 
@@ -43,9 +58,11 @@ world& world::operator=(world&& _others) {
   std::unique_lock<std::shared_timed_mutex> lock2(_others.mutex_, std::defer_lock);
   std::lock(lock1, lock2);
   std::swap(field_, _others.field_);
+  std::swap(fieldMap_, _others.fieldMap_);
   std::swap(ball_, _others.ball_);
   std::swap(robotsBlue_, _others.robotsBlue_);
   std::swap(robotsYellow_, _others.robotsYellow_);
+  std::swap(captureTime_, _others.captureTime_);
   return *this;
 }
 
@@ -54,6 +71,11 @@ model::field world::field() const {
   return field_;
 }
 
+std::shared_ptr<const model::fieldMap> world::fieldMap() const {
+  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+  return fieldMap_;
+}
+
 model::ball world::ball() const {
   std::shared_lock<std::shared_timed_mutex> lock(mutex_);
   return ball_;
@@ -68,5 +90,15 @@ world::RobotsList world::robotsYellow() const {
   std::shared_lock<std::shared_timed_mutex> lock(mutex_);
   return robotsYellow_;
 }
+
+util::TimePointType world::captureTime() const {
+  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+  return captureTime_;
+}
+
+void world::captureTime(util::TimePointType _time) {
+  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+  captureTime_ = _time;
+}
 } // namespace model
 } // namespace ai
@@ -2,12 +2,16 @@
 #define AI_MODEL_WORLD_HPP_
 
 #include <stdint.h>
+#include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <string>
-#include <unordered_map>
 
+#include "ai/util/idMap.hpp"
+#include "ai/util/time.hpp"
 #include "ball.hpp"
 #include "field.hpp"
+#include "fieldMap.hpp"
 #include "robot.hpp"
 
 namespace ai {
@@ -16,10 +20,14 @@ class world {
   mutable std::shared_timed_mutex mutex_;
 
 public:
-  using RobotsList = std::unordered_map<uint32_t, model::robot>;
+  /// 扱うロボットIDの上限 (SSLのロボットIDは0から15)
+  static constexpr std::size_t maxRobots = 16;
+  /// KeyがID, Valueがロボットのテーブルの型
+  using RobotsList = util::idMap<model::robot, maxRobots>;
   world();
+  /// @param fieldMap fieldの距離マップ (形状が違うかnullptrなら, ここで作る)
   world(model::field&& _field, model::ball&& _ball, RobotsList&& _robotsBlue,
-        RobotsList&& _robotsYellow);
+        RobotsList&& _robotsYellow, std::shared_ptr<const model::fieldMap> _fieldMap = nullptr);
   world(const world& _others);
   world(world&& _others);
 
@@ -27,14 +35,30 @@ public:
   world& operator=(world&& _others);
 
   model::field field() const;
+
+  /// @brief           フィールドの境界とペナルティエリアまでの距離マップを取得する
+  ///
+  /// マップはフィールドを設定したときに用意され, 形状が同じ間はコピーしたworld同士で共有される
+  std::shared_ptr<const model::fieldMap> fieldMap() const;
+
   model::ball ball() const;
   RobotsList robotsBlue() const;
   RobotsList robotsYellow() const;
 
+  /// @brief           値がキャプチャされた時刻を取得する
+  ///
+  /// このプロセスの時計で表した, 含まれる値のうち最も新しいフレームのキャプチャ時刻
+  util::TimePointType captureTime() const;
+  void captureTime(util::TimePointType _time);
+
   template <class T>
   void field(T&& _field) {
+    model::field field{std::forward<T>(_field)};
+    // 形状が変わったときのマップの作り直しは, ロックの外で行う
+    auto map = model::fieldMap::update(fieldMap(), field);
     std::unique_lock<std::shared_timed_mutex> lock(mutex_);
-    field_ = std::forward<T>(_field);
+    field_    = std::move(field);
+    fieldMap_ = std::move(map);
   }
 
   template <class T>
@@ -57,9 +81,11 @@ public:
 
 private:
   model::field field_;
+  std::shared_ptr<const model::fieldMap> fieldMap_;
   model::ball ball_;
   RobotsList robotsBlue_;
   RobotsList robotsYellow_;
+  util::TimePointType captureTime_;
 };
 }; // namespace model
 } // namespace ai
@@ -0,0 +1,361 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+
+#include "ai/planner/astar.hpp"
+
+namespace ai {
+namespace planner {
+
+namespace {
+
+// 8近傍の向き
+constexpr int32_t directions[8][2] = {{1, 0},  {-1, 0}, {0, 1},  {0, -1},
+                                      {1, 1},  {1, -1}, {-1, 1}, {-1, -1}};
+
+int32_t sign(int32_t _v) {
+  return (_v > 0) - (_v < 0);
+}
+
+// 長さlengthを間隔cellSizeの格子で覆うのに必要な格子の数
+int32_t cells(double _length, double _cellSize) {
+  return std::max(static_cast<int32_t>(std::ceil(_length / _cellSize)), 1);
+}
+
+} // namespace
+
+astar::astar(const model::world& _world, double _cellSize)
+    : world_(_world),
+      cellSize_(_cellSize),
+      jps_(false),
+      minX_(0.0),
+      minY_(0.0),
+      nx_(0),
+      ny_(0),
+      stamp_(0),
+      cost_(0.0),
+      expanded_(0) {
+  updateDefaultObstacles();
+}
+
+void astar::obstacles(const std::vector<obstacle>& _obstacles) {
+  additionalObstacles_ = _obstacles;
+  rebuildObstacles();
+}
+
+void astar::updateDefaultObstacles() {
+  // ペナルティエリアを障害物指定
+  if (penaltyObstacles(world_.field(), defaultObstacles_)) rebuildObstacles();
+}
+
+void astar::rebuildObstacles() {
+  allObstacles_ = additionalObstacles_;
+  std::copy(defaultObstacles_.begin(), defaultObstacles_.end(),
+            std::back_inserter(allObstacles_));
+  obstacleSet_.clear();
+  for (const auto& it : allObstacles_) obstacleSet_.add(it.position_.x, it.position_.y, it.r_);
+}
+
+void astar::jumpPointSearch(bool _enable) {
+  jps_ = _enable;
+}
+
+bool astar::jumpPointSearch() const {
+  return jps_;
+}
+
+const std::vector<position>& astar::path() const {
+  return path_;
+}
+
+double astar::cost() const {
+  return cost_;
+}
+
+uint32_t astar::expanded() const {
+  return expanded_;
+}
+
+void astar::search(const position _start, const position _goal, const double _margin) {
+  updateDefaultObstacles();
+  rasterize(_margin);
+  expanded_ = 0;
+  cost_     = 0.0;
+
+  auto cellOf = [this](const position& _p) {
+    const auto x = std::clamp(static_cast<int32_t>(std::floor((_p.x - minX_) / cellSize_)), 0,
+                              nx_ - 1);
+    const auto y = std::clamp(static_cast<int32_t>(std::floor((_p.y - minY_) / cellSize_)), 0,
+                              ny_ - 1);
+    return y * nx_ + x;
+  };
+  const auto start = cellOf(_start);
+  const auto goal  = cellOf(_goal);
+
+  // 初期位置が障害物の中にあれば, まずそこから出る
+  const auto first = blocked_[start] ? nearestFree(start) : start;
+  if (first < 0) {
+    path_.assign({{_start.x, _start.y, _goal.theta}});
+    target_ = path_.front();
+    return;
+  }
+
+  ++stamp_;
+  open_.clear();
+  const std::greater<candidate> cmp{};
+  cells_[first] = cell{0.0f, -1, stamp_, false};
+  open_.push_back(candidate{static_cast<float>(octile(first, goal)), first});
+
+  // 目標位置に辿り着けなければ, 展開した中で目標位置に最も近いノードへ向かう
+  auto best     = first;
+  auto bestDist = octile(first, goal);
+  bool reached  = false;
+  while (!open_.empty()) {
+    std::pop_heap(open_.begin(), open_.end(), cmp);
+    const auto index = open_.back().index;
+    open_.pop_back();
+    auto& c = cells_[index];
+    if (c.closed) continue;
+    c.closed = true;
+    ++expanded_;
+
+    if (index == goal) {
+      best    = index;
+      reached = true;
+      break;
+    }
+    const auto dist = octile(index, goal);
+    if (dist < bestDist) {
+      best     = index;
+      bestDist = dist;
+    }
+
+    successors(index, goal);
+    for (auto next : successors_) {
+      auto& n = cells_[next];
+      if (n.stamp != stamp_) {
+        n = cell{std::numeric_limits<float>::infinity(), -1, stamp_, false};
+      }
+      if (n.closed) continue;
+      const auto g = static_cast<float>(c.g + octile(index, next));
+      if (g < n.g) {
+        n.g      = g;
+        n.parent = index;
+        open_.push_back(candidate{static_cast<float>(g + octile(next, goal)), next});
+        std::push_heap(open_.begin(), open_.end(), cmp);
+      }
+    }
+  }
+  cost_ = cells_[best].g;
+
+  buildPath(_start, _goal, first != start, best, reached, _margin);
+}
+
+void astar::rasterize(const double _margin) {
+  // 探索範囲はrrtと同じくフィールドにマージンを加えた範囲とする
+  const auto field = world_.field();
+  minX_            = field.xMin() - _margin;
+  minY_            = field.yMin() - _margin;
+  nx_              = cells(field.length() + 2 * _margin, cellSize_);
+  ny_              = cells(field.width() + 2 * _margin, cellSize_);
+
+  const auto n = static_cast<std::size_t>(nx_) * ny_;
+  blocked_.assign(n, 0);
+  if (cells_.size() != n) {
+    cells_.assign(n, cell{0.0f, -1, 0, false});
+    stamp_ = 0;
+  }
+
+  // 中心が障害物(とマージン)の内側にある格子を通れないものとする
+  for (const auto& o : allObstacles_) {
+    const auto r  = o.r_ + _margin;
+    const auto x0 = std::max(static_cast<int32_t>((o.position_.x - r - minX_) / cellSize_), 0);
+    const auto x1 =
+        std::min(static_cast<int32_t>((o.position_.x + r - minX_) / cellSize_), nx_ - 1);
+    const auto y0 = std::max(static_cast<int32_t>((o.position_.y - r - minY_) / cellSize_), 0);
+    const auto y1 =
+        std::min(static_cast<int32_t>((o.position_.y + r - minY_) / cellSize_), ny_ - 1);
+    for (auto y = y0; y <= y1; ++y) {
+      const auto cy = minY_ + (y + 0.5) * cellSize_;
+      for (auto x = x0; x <= x1; ++x) {
+        const auto cx = minX_ + (x + 0.5) * cellSize_;
+        if (std::hypot(cx - o.position_.x, cy - o.position_.y) < r) blocked_[y * nx_ + x] = 1;
+      }
+    }
+  }
+}
+
+bool astar::free(int32_t _x, int32_t _y) const {
+  return _x >= 0 && _y >= 0 && _x < nx_ && _y < ny_ && !blocked_[_y * nx_ + _x];
+}
+
+int32_t astar::nearestFree(int32_t _index) {
+  // 4近傍の幅優先探索で, 最も近い通れる格子を探す
+  ++stamp_;
+  queue_.clear();
+  queue_.push_back(_index);
+  cells_[_index].stamp = stamp_;
+  for (auto i = 0u; i < queue_.size(); ++i) {
+    const auto index = queue_[i];
+    if (!blocked_[index]) return index;
+    const auto x = index % nx_;
+    const auto y = index / nx_;
+    for (auto k = 0; k < 4; ++k) {
+      const auto nx = x + directions[k][0];
+      const auto ny = y + directions[k][1];
+      if (nx < 0 || ny < 0 || nx >= nx_ || ny >= ny_) continue;
+      auto& c = cells_[ny * nx_ + nx];
+      if (c.stamp == stamp_) continue;
+      c.stamp = stamp_;
+      queue_.push_back(ny * nx_ + nx);
+    }
+  }
+  return -1;
+}
+
+int32_t astar::jump(int32_t _x, int32_t _y, int32_t _dx, int32_t _dy, int32_t _goal) const {
+  while (true) {
+    // 斜めに進むときは, 縦横の隣が両方とも通れなければならない
+    if (_dx != 0 && _dy != 0 && !(free(_x + _dx, _y) && free(_x, _y + _dy))) return -1;
+    _x += _dx;
+    _y += _dy;
+    if (!free(_x, _y)) return -1;
+
+    const auto index = _y * nx_ + _x;
+    if (index == _goal) return index;
+    if (_dx != 0 && _dy != 0) {
+      // 縦横に進んだ先に跳躍点があれば, ここも跳躍点になる
+      if (jump(_x, _y, _dx, 0, _goal) >= 0 || jump(_x, _y, 0, _dy, _goal) >= 0) return index;
+    } else if (_dx != 0) {
+      // 横に進むとき, 後ろが塞がっていて横が開いていれば強制された隣接点がある
+      if ((free(_x, _y - 1) && !free(_x - _dx, _y - 1)) ||
+          (free(_x, _y + 1) && !free(_x - _dx, _y + 1))) {
+        return index;
+      }
+    } else {
+      if ((free(_x - 1, _y) && !free(_x - 1, _y - _dy)) ||
+          (free(_x + 1, _y) && !free(_x + 1, _y - _dy))) {
+        return index;
+      }
+    }
+  }
+}
+
+void astar::successors(int32_t _index, int32_t _goal) {
+  successors_.clear();
+  const auto x      = _index % nx_;
+  const auto y      = _index / nx_;
+  const auto parent = cells_[_index].parent;
+
+  // 進める向きを集める (JPSでは親から来た向きに応じて枝刈りする)
+  int32_t dirs[8][2];
+  auto num  = 0;
+  auto push = [&](int32_t _dx, int32_t _dy) {
+    dirs[num][0] = _dx;
+    dirs[num][1] = _dy;
+    ++num;
+  };
+  if (!jps_ || parent < 0) {
+    for (const auto& d : directions) {
+      if (!free(x + d[0], y + d[1])) continue;
+      if (d[0] != 0 && d[1] != 0 && !(free(x + d[0], y) && free(x, y + d[1]))) continue;
+      push(d[0], d[1]);
+    }
+  } else {
+    const auto dx = sign(x - parent % nx_);
+    const auto dy = sign(y - parent / nx_);
+    if (dx != 0 && dy != 0) {
+      const auto nextX = free(x + dx, y);
+      const auto nextY = free(x, y + dy);
+      if (nextY) push(0, dy);
+      if (nextX) push(dx, 0);
+      if (nextX && nextY) push(dx, dy);
+    } else if (dx != 0) {
+      const auto next  = free(x + dx, y);
+      const auto upper = free(x, y + 1);
+      const auto lower = free(x, y - 1);
+      if (next) {
+        push(dx, 0);
+        if (upper) push(dx, 1);
+        if (lower) push(dx, -1);
+      }
+      if (upper) push(0, 1);
+      if (lower) push(0, -1);
+    } else {
+      const auto next  = free(x, y + dy);
+      const auto right = free(x + 1, y);
+      const auto left  = free(x - 1, y);
+      if (next) {
+        push(0, dy);
+        if (right) push(1, dy);
+        if (left) push(-1, dy);
+      }
+      if (right) push(1, 0);
+      if (left) push(-1, 0);
+    }
+  }
+
+  for (auto i = 0; i < num; ++i) {
+    if (!jps_) {
+      successors_.push_back((y + dirs[i][1]) * nx_ + x + dirs[i][0]);
+      continue;
+    }
+    const auto j = jump(x, y, dirs[i][0], dirs[i][1], _goal);
+    if (j >= 0) successors_.push_back(j);
+  }
+}
+
+double astar::octile(int32_t _a, int32_t _b) const {
+  const auto dx = std::abs(_a % nx_ - _b % nx_);
+  const auto dy = std::abs(_a / nx_ - _b / nx_);
+  return (std::max(dx, dy) + (M_SQRT2 - 1.0) * std::min(dx, dy)) * cellSize_;
+}
+
+position astar::center(int32_t _index, double _theta) const {
+  return position{minX_ + (_index % nx_ + 0.5) * cellSize_,
+                  minY_ + (_index / nx_ + 0.5) * cellSize_, _theta};
+}
+
+void astar::buildPath(const position _start, const position _goal, bool _escaped,
+                      int32_t _last, bool _reached, double _margin) {
+  // 格子の中心を並べ, 始点と終点は実際の位置に置き換える
+  path_.clear();
+  for (auto index = _last; index >= 0; index = cells_[index].parent) {
+    path_.push_back(center(index, _goal.theta));
+  }
+  std::reverse(path_.begin(), path_.end());
+  const position start{_start.x, _start.y, _goal.theta};
+  if (_escaped) {
+    path_.insert(path_.begin(), start);
+  } else {
+    path_.front() = start;
+  }
+  if (_reached) {
+    if (path_.size() == 1) path_.push_back(_goal);
+    path_.back() = _goal;
+  }
+
+  // 見通せる限り経由点を飛ばす
+  // 書き込む位置は読み出す位置を追い越さないので, その場で詰められる
+  if (path_.size() > 2) {
+    auto last   = 0u;
+    auto anchor = 0u;
+    for (auto i = 2u; i < path_.size(); ++i) {
+      const auto& a = path_[anchor];
+      if (obstacleSet_.obstructed(path_[i].x, path_[i].y, a.x, a.y, _margin)) {
+        path_[++last] = path_[i - 1];
+        anchor        = i - 1;
+      }
+    }
+    path_[++last] = path_.back();
+    path_.resize(last + 1);
+  }
+
+  target_       = path_.size() > 1 ? path_[1] : path_.front();
+  target_.theta = _goal.theta;
+}
+
+} // namespace planner
+} // namespace ai
@@ -0,0 +1,139 @@
+#ifndef AI_PLANNER_ASTAR_HPP_
+#define AI_PLANNER_ASTAR_HPP_
+
+#include <vector>
+#include <stdint.h>
+
+#include "ai/model/world.hpp"
+#include "ai/planner/base.hpp"
+#include "ai/planner/obstacleSet.hpp"
+
+namespace ai {
+namespace planner {
+
+/// @class   astar
+/// @brief   格子上のA*探索による経路計画
+///
+/// フィールドを一様な格子に分け, 障害物(とマージン)に中心が入る格子を通れないものとして
+/// 8近傍で最短経路を探す. 斜めに進むのは, 隣り合う縦横の格子が両方とも通れるときだけとする.
+/// 乱数を使わないので, 同じ入力からは常に同じ経路が得られる.
+/// Jump Point Searchを有効にすると, 同じ長さの経路をより少ない展開数で求める.
+/// 作業領域は探索のたびに再利用する
+class astar final : public base {
+public:
+  /// @param world     WorldModel
+  /// @param cellSize  格子の間隔[mm]
+  explicit astar(const model::world& _world, double _cellSize = 100.0);
+
+  /// @brief           障害物を設定する (ペナルティエリアは設定しなくても避ける)
+  void obstacles(const std::vector<obstacle>& _obstacles);
+
+  /// @brief           Jump Point Searchを使うか設定する
+  void jumpPointSearch(bool _enable);
+
+  /// @brief           Jump Point Searchを使うか
+  bool jumpPointSearch() const;
+
+  /// @brief           経路を探索する
+  /// @param start     初期位置
+  /// @param goal      目標位置
+  /// @param margin    障害物の半径に加えるマージン
+  ///
+  /// 目標位置に辿り着けなければ, 辿り着ける格子のうち目標位置に最も近いものへ向かう.
+  /// 初期位置が通れない格子にあれば, 最も近い通れる格子へ出てから探索する
+  void search(const position _start, const position _goal, const double _margin = 150.0);
+
+  /// @brief           直前の探索で得られた経路
+  ///
+  /// 初期位置から始まり, 見通せる経由点の間はショートカットしてある.
+  /// 角度は全て目標の角度にしてある
+  const std::vector<position>& path() const;
+
+  /// @brief           直前の探索で求めた格子上の経路の長さ[mm] (ショートカットする前のもの)
+  double cost() const;
+
+  /// @brief           直前の探索で展開したノードの数
+  uint32_t expanded() const;
+
+private:
+  /// 各格子の探索の状態
+  struct cell {
+    float g;        // 始点からの距離
+    int32_t parent; // 経路上で1つ前の格子 (始点なら-1)
+    uint32_t stamp; // 最後に訪れた探索の番号 (今回の探索でなければgとparentは無効)
+    bool closed;    // 展開済みか
+  };
+
+  /// 探索中の候補
+  struct candidate {
+    float f;
+    int32_t index;
+
+    bool operator>(const candidate& _rhs) const {
+      return f > _rhs.f;
+    }
+  };
+
+  /// @brief  現在のフィールドからペナルティエリアの障害物を求め,
+  ///         変わっていればdefaultObstacles_と障害物の集合を作り直す
+  void updateDefaultObstacles();
+
+  /// @brief  additionalObstacles_とdefaultObstacles_から障害物の集合を作る
+  void rebuildObstacles();
+
+  /// @brief  格子を作り直し, 障害物に中心が入る格子を通れないものとする
+  void rasterize(const double _margin);
+
+  /// @brief  (x, y)の格子が範囲内にあり, 通れるか
+  bool free(int32_t _x, int32_t _y) const;
+
+  /// @brief  初期位置が通れない格子にあるとき, 最も近い通れる格子を探す
+  /// @return 見つからなければ-1
+  int32_t nearestFree(int32_t _index);
+
+  /// @brief  (x, y)から(dx, dy)の向きに進み, 最初に見つかった跳躍点を返す
+  /// @return 見つからなければ-1
+  int32_t jump(int32_t _x, int32_t _y, int32_t _dx, int32_t _dy, int32_t _goal) const;
+
+  /// @brief  格子indexの次に調べる格子(JPSなら跳躍点)をsuccessors_に集める
+  void successors(int32_t _index, int32_t _goal);
+
+  /// @brief  2つの格子の間を8近傍で進むときの距離[mm]
+  double octile(int32_t _a, int32_t _b) const;
+
+  /// @brief  格子の中心の座標
+  position center(int32_t _index, double _theta) const;
+
+  /// @brief  格子lastから親を辿り, 経由点の列をショートカットしてpath_を作る
+  /// @param escaped  初期位置が通れない格子にあり, 別の格子から探索したか
+  void buildPath(const position _start, const position _goal, bool _escaped, int32_t _last,
+                 bool _reached, double _margin);
+
+  const model::world& world_;
+  double cellSize_;
+  bool jps_;
+  std::vector<obstacle> defaultObstacles_;    // 固定障害物,セットしなくても避ける
+  std::vector<obstacle> additionalObstacles_; // 追加障害物,任意にセットして避ける
+  std::vector<obstacle> allObstacles_;        // 障害物,上記2つの合算
+  obstacleSet obstacleSet_; // allObstacles_を線分との干渉判定用に並べ直したもの
+
+  double minX_;
+  double minY_;
+  int32_t nx_;
+  int32_t ny_;
+  std::vector<uint8_t> blocked_; // 各格子が通れないか
+  std::vector<cell> cells_;      // 各格子の探索の状態
+  uint32_t stamp_;               // 探索の番号
+
+  std::vector<candidate> open_;     // 未展開の候補のヒープ
+  std::vector<int32_t> successors_; // 展開したノードの次に調べる格子
+  std::vector<int32_t> queue_;      // 通れる格子を探す幅優先探索のキュー
+  std::vector<position> path_;      // 直前の探索で得られた経路
+  double cost_;                     // 直前の探索で求めた格子上の経路の長さ
+  uint32_t expanded_;               // 直前の探索で展開したノードの数
+};
+
+} // namespace planner
+} // namespace ai
+
+#endif // AI_PLANNER_ASTAR_HPP_
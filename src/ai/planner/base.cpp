@@ -1,8 +1,25 @@
+#include <algorithm>
+#include <array>
+
 #include "base.hpp"
 
 namespace ai {
 namespace planner {
 
+bool penaltyObstacles(const model::field& _field, std::vector<obstacle>& _obstacles) {
+  const auto r = static_cast<double>(_field.penaltyLength());
+  const std::array<obstacle, 2> current{{obstacle{position{_field.xMax(), 0.0, 0.0}, r},
+                                         obstacle{position{_field.xMin(), 0.0, 0.0}, r}}};
+  const auto same = _obstacles.size() == current.size() &&
+                    std::equal(current.begin(), current.end(), _obstacles.begin(),
+                               [](const auto& _a, const auto& _b) {
+                                 return _a.position_.x == _b.position_.x && _a.r_ == _b.r_;
+                               });
+  if (same) return false;
+  _obstacles.assign(current.begin(), current.end());
+  return true;
+}
+
 base::base() {}
 
 base::~base() {}
@@ -2,7 +2,9 @@
 #define AI_PLANNER_BASE_HPP_
 
 #include <variant>
+#include <vector>
 #include "ai/model/command.hpp"
+#include "ai/model/field.hpp"
 
 namespace ai {
 namespace planner {
@@ -12,6 +14,21 @@ using velocity     = model::command::velocity;
 using acceleration = model::command::acceleration;
 using target       = std::variant<position, velocity>;
 
+/// 円形の障害物
+struct obstacle {
+  position position_;                // 座標
+  double r_;                         // 物体の半径
+  velocity velocity_{0.0, 0.0, 0.0}; // 速度 (考慮するかはプランナによる)
+};
+
+/// @brief  ペナルティエリアを近似した障害物(正方形の外接円)をobstaclesに設定する
+/// @param  field     フィールドの情報
+/// @param  obstacles 設定先 (既に同じものが入っていれば書き換えない)
+/// @return obstaclesを書き換えたか
+///
+/// フィールドの寸法は後から届くこともあるので, プランナは探索のたびにこれで確かめる
+bool penaltyObstacles(const model::field& _field, std::vector<obstacle>& _obstacles);
+
 class base {
 protected:
   position target_; // 目標(位置or速度)
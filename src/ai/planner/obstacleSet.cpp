@@ -0,0 +1,299 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "ai/planner/obstacleSet.hpp"
+
+namespace ai {
+namespace planner {
+
+namespace {
+
+#if defined(__AVX__)
+constexpr std::size_t lanes = 4;
+#elif defined(__SSE2__)
+constexpr std::size_t lanes = 2;
+#else
+constexpr std::size_t lanes = 1;
+#endif
+
+} // namespace
+
+obstacleSet::obstacleSet() : size_(0) {}
+
+void obstacleSet::clear() {
+  x_.clear();
+  y_.clear();
+  r_.clear();
+  vx_.clear();
+  vy_.clear();
+  size_ = 0;
+}
+
+void obstacleSet::add(double _x, double _y, double _r, double _vx, double _vy) {
+  if (size_ == x_.size()) {
+    // 末尾をlanes個の番兵で埋める (NaNとの比較は常に偽になる)
+    x_.resize(size_ + lanes, 0.0);
+    y_.resize(size_ + lanes, 0.0);
+    r_.resize(size_ + lanes, std::numeric_limits<double>::quiet_NaN());
+    vx_.resize(size_ + lanes, 0.0);
+    vy_.resize(size_ + lanes, 0.0);
+  }
+  x_[size_]  = _x;
+  y_[size_]  = _y;
+  r_[size_]  = _r;
+  vx_[size_] = _vx;
+  vy_[size_] = _vy;
+  ++size_;
+}
+
+std::size_t obstacleSet::size() const {
+  return size_;
+}
+
+bool obstacleSet::obstructedReference(double _sx, double _sy, double _gx, double _gy,
+                                      double _margin) const {
+  // 2点が完全に一致していたら
+  if (_sx == _gx && _sy == _gy) {
+    return false;
+  }
+
+  double a = _gy - _sy;
+  double b = -(_gx - _sx);
+  double c = -a * _sx - b * _sy;
+
+  bool obstructed = false;
+  for (auto i = 0u; i < size_; ++i) {
+    // 障害物と直線の距離
+    double dist = std::abs(a * x_[i] + b * y_[i] + c) / std::hypot(a, b);
+    // 直線の方向ベクトル
+    double vx = (_gx - _sx) / std::hypot(_sx - _gx, _sy - _gy);
+    double vy = (_gy - _sy) / std::hypot(_sx - _gx, _sy - _gy);
+    // 障害物判定のための内点
+    double px1 = _sx + vx * (_margin + r_[i]);
+    double py1 = _sy + vy * (_margin + r_[i]);
+    double px2 = _gx + vx * (_margin + r_[i]);
+    double py2 = _gy + vy * (_margin + r_[i]);
+
+    // 線に近く，p1,p2の点の四角形内に障害物があったら
+    if (dist < _margin + r_[i] && x_[i] + r_[i] > std::min(px1, px2) &&
+        x_[i] - r_[i] < std::max(px1, px2) && y_[i] + r_[i] > std::min(py1, py2) &&
+        y_[i] - r_[i] < std::max(py1, py2)) {
+      obstructed = true;
+      break;
+    }
+  }
+  return obstructed;
+}
+
+bool obstacleSet::obstructed(double _sx, double _sy, double _gx, double _gy,
+                             double _margin) const {
+#if defined(__AVX__) || defined(__SSE2__)
+  // 2点が完全に一致していたら
+  if (_sx == _gx && _sy == _gy) {
+    return false;
+  }
+
+  // 線分だけで決まる値は先に求めておく (演算の順序はobstructedReference()と同じにする)
+  const double a    = _gy - _sy;
+  const double b    = -(_gx - _sx);
+  const double c    = -a * _sx - b * _sy;
+  const double norm = std::hypot(a, b);
+  const double len  = std::hypot(_sx - _gx, _sy - _gy);
+  const double vx   = (_gx - _sx) / len;
+  const double vy   = (_gy - _sy) / len;
+
+#if defined(__AVX__)
+  const auto sign   = _mm256_set1_pd(-0.0);
+  const auto va     = _mm256_set1_pd(a);
+  const auto vb     = _mm256_set1_pd(b);
+  const auto vc     = _mm256_set1_pd(c);
+  const auto vnorm  = _mm256_set1_pd(norm);
+  const auto vvx    = _mm256_set1_pd(vx);
+  const auto vvy    = _mm256_set1_pd(vy);
+  const auto vsx    = _mm256_set1_pd(_sx);
+  const auto vsy    = _mm256_set1_pd(_sy);
+  const auto vgx    = _mm256_set1_pd(_gx);
+  const auto vgy    = _mm256_set1_pd(_gy);
+  const auto margin = _mm256_set1_pd(_margin);
+
+  for (auto i = 0u; i < size_; i += lanes) {
+    const auto x = _mm256_loadu_pd(x_.data() + i);
+    const auto y = _mm256_loadu_pd(y_.data() + i);
+    const auto r = _mm256_loadu_pd(r_.data() + i);
+
+    const auto dist = _mm256_div_pd(
+        _mm256_andnot_pd(
+            sign, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(va, x), _mm256_mul_pd(vb, y)), vc)),
+        vnorm);
+    const auto mr  = _mm256_add_pd(margin, r);
+    const auto px1 = _mm256_add_pd(vsx, _mm256_mul_pd(vvx, mr));
+    const auto py1 = _mm256_add_pd(vsy, _mm256_mul_pd(vvy, mr));
+    const auto px2 = _mm256_add_pd(vgx, _mm256_mul_pd(vvx, mr));
+    const auto py2 = _mm256_add_pd(vgy, _mm256_mul_pd(vvy, mr));
+
+    auto hit = _mm256_cmp_pd(dist, mr, _CMP_LT_OQ);
+    hit      = _mm256_and_pd(
+        hit, _mm256_cmp_pd(_mm256_add_pd(x, r), _mm256_min_pd(px1, px2), _CMP_GT_OQ));
+    hit = _mm256_and_pd(
+        hit, _mm256_cmp_pd(_mm256_sub_pd(x, r), _mm256_max_pd(px1, px2), _CMP_LT_OQ));
+    hit = _mm256_and_pd(
+        hit, _mm256_cmp_pd(_mm256_add_pd(y, r), _mm256_min_pd(py1, py2), _CMP_GT_OQ));
+    hit = _mm256_and_pd(
+        hit, _mm256_cmp_pd(_mm256_sub_pd(y, r), _mm256_max_pd(py1, py2), _CMP_LT_OQ));
+    if (_mm256_movemask_pd(hit)) return true;
+  }
+#else
+  const auto sign   = _mm_set1_pd(-0.0);
+  const auto va     = _mm_set1_pd(a);
+  const auto vb     = _mm_set1_pd(b);
+  const auto vc     = _mm_set1_pd(c);
+  const auto vnorm  = _mm_set1_pd(norm);
+  const auto vvx    = _mm_set1_pd(vx);
+  const auto vvy    = _mm_set1_pd(vy);
+  const auto vsx    = _mm_set1_pd(_sx);
+  const auto vsy    = _mm_set1_pd(_sy);
+  const auto vgx    = _mm_set1_pd(_gx);
+  const auto vgy    = _mm_set1_pd(_gy);
+  const auto margin = _mm_set1_pd(_margin);
+
+  for (auto i = 0u; i < size_; i += lanes) {
+    const auto x = _mm_loadu_pd(x_.data() + i);
+    const auto y = _mm_loadu_pd(y_.data() + i);
+    const auto r = _mm_loadu_pd(r_.data() + i);
+
+    const auto dist = _mm_div_pd(
+        _mm_andnot_pd(sign, _mm_add_pd(_mm_add_pd(_mm_mul_pd(va, x), _mm_mul_pd(vb, y)), vc)),
+        vnorm);
+    const auto mr  = _mm_add_pd(margin, r);
+    const auto px1 = _mm_add_pd(vsx, _mm_mul_pd(vvx, mr));
+    const auto py1 = _mm_add_pd(vsy, _mm_mul_pd(vvy, mr));
+    const auto px2 = _mm_add_pd(vgx, _mm_mul_pd(vvx, mr));
+    const auto py2 = _mm_add_pd(vgy, _mm_mul_pd(vvy, mr));
+
+    auto hit = _mm_cmplt_pd(dist, mr);
+    hit      = _mm_and_pd(hit, _mm_cmpgt_pd(_mm_add_pd(x, r), _mm_min_pd(px1, px2)));
+    hit      = _mm_and_pd(hit, _mm_cmplt_pd(_mm_sub_pd(x, r), _mm_max_pd(px1, px2)));
+    hit      = _mm_and_pd(hit, _mm_cmpgt_pd(_mm_add_pd(y, r), _mm_min_pd(py1, py2)));
+    hit      = _mm_and_pd(hit, _mm_cmplt_pd(_mm_sub_pd(y, r), _mm_max_pd(py1, py2)));
+    if (_mm_movemask_pd(hit)) return true;
+  }
+#endif
+  return false;
+#else
+  // SIMD命令が使えない環境ではスカラー実装で判定する
+  return obstructedReference(_sx, _sy, _gx, _gy, _margin);
+#endif
+}
+
+bool obstacleSet::sweptObstructedReference(double _sx, double _sy, double _t0, double _gx,
+                                           double _gy, double _t1, double _margin) const {
+  const double dt = _t1 - _t0;
+  const double ex = _gx - _sx;
+  const double ey = _gy - _sy;
+
+  for (auto i = 0u; i < size_; ++i) {
+    // 時刻t0における障害物から見た始点の位置
+    const double px = _sx - (x_[i] + vx_[i] * _t0);
+    const double py = _sy - (y_[i] + vy_[i] * _t0);
+    // t0からt1までの相対的な変位
+    const double dx = ex - vx_[i] * dt;
+    const double dy = ey - vy_[i] * dt;
+    // 相対的な動きの線分上で障害物の中心に最も近い点の位置(0から1)
+    // 相対的に止まっている(0 / 0でNaNになる)ときは始点とする
+    double s = -(px * dx + py * dy) / (dx * dx + dy * dy);
+    s        = s > 0.0 ? s : 0.0;
+    s        = s < 1.0 ? s : 1.0;
+    const double qx = px + s * dx;
+    const double qy = py + s * dy;
+    const double mr = _margin + r_[i];
+    if (qx * qx + qy * qy < mr * mr) return true;
+  }
+  return false;
+}
+
+bool obstacleSet::sweptObstructed(double _sx, double _sy, double _t0, double _gx, double _gy,
+                                  double _t1, double _margin) const {
+#if defined(__AVX__) || defined(__SSE2__)
+  // 演算の順序はsweptObstructedReference()と同じにする
+  // max, minは引数の一方がNaNなら2つ目を返すので, 三項演算子による比較と結果が一致する
+#if defined(__AVX__)
+  const auto sign   = _mm256_set1_pd(-0.0);
+  const auto zero   = _mm256_setzero_pd();
+  const auto one    = _mm256_set1_pd(1.0);
+  const auto t0     = _mm256_set1_pd(_t0);
+  const auto dt     = _mm256_set1_pd(_t1 - _t0);
+  const auto ex     = _mm256_set1_pd(_gx - _sx);
+  const auto ey     = _mm256_set1_pd(_gy - _sy);
+  const auto sx     = _mm256_set1_pd(_sx);
+  const auto sy     = _mm256_set1_pd(_sy);
+  const auto margin = _mm256_set1_pd(_margin);
+
+  for (auto i = 0u; i < size_; i += lanes) {
+    const auto vx = _mm256_loadu_pd(vx_.data() + i);
+    const auto vy = _mm256_loadu_pd(vy_.data() + i);
+    const auto px =
+        _mm256_sub_pd(sx, _mm256_add_pd(_mm256_loadu_pd(x_.data() + i), _mm256_mul_pd(vx, t0)));
+    const auto py =
+        _mm256_sub_pd(sy, _mm256_add_pd(_mm256_loadu_pd(y_.data() + i), _mm256_mul_pd(vy, t0)));
+    const auto dx = _mm256_sub_pd(ex, _mm256_mul_pd(vx, dt));
+    const auto dy = _mm256_sub_pd(ey, _mm256_mul_pd(vy, dt));
+
+    const auto num =
+        _mm256_xor_pd(sign, _mm256_add_pd(_mm256_mul_pd(px, dx), _mm256_mul_pd(py, dy)));
+    const auto den = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+    const auto s   = _mm256_min_pd(_mm256_max_pd(_mm256_div_pd(num, den), zero), one);
+    const auto qx  = _mm256_add_pd(px, _mm256_mul_pd(s, dx));
+    const auto qy  = _mm256_add_pd(py, _mm256_mul_pd(s, dy));
+    const auto mr  = _mm256_add_pd(margin, _mm256_loadu_pd(r_.data() + i));
+
+    const auto hit =
+        _mm256_cmp_pd(_mm256_add_pd(_mm256_mul_pd(qx, qx), _mm256_mul_pd(qy, qy)),
+                      _mm256_mul_pd(mr, mr), _CMP_LT_OQ);
+    if (_mm256_movemask_pd(hit)) return true;
+  }
+#else
+  const auto sign   = _mm_set1_pd(-0.0);
+  const auto zero   = _mm_setzero_pd();
+  const auto one    = _mm_set1_pd(1.0);
+  const auto t0     = _mm_set1_pd(_t0);
+  const auto dt     = _mm_set1_pd(_t1 - _t0);
+  const auto ex     = _mm_set1_pd(_gx - _sx);
+  const auto ey     = _mm_set1_pd(_gy - _sy);
+  const auto sx     = _mm_set1_pd(_sx);
+  const auto sy     = _mm_set1_pd(_sy);
+  const auto margin = _mm_set1_pd(_margin);
+
+  for (auto i = 0u; i < size_; i += lanes) {
+    const auto vx = _mm_loadu_pd(vx_.data() + i);
+    const auto vy = _mm_loadu_pd(vy_.data() + i);
+    const auto px = _mm_sub_pd(sx, _mm_add_pd(_mm_loadu_pd(x_.data() + i), _mm_mul_pd(vx, t0)));
+    const auto py = _mm_sub_pd(sy, _mm_add_pd(_mm_loadu_pd(y_.data() + i), _mm_mul_pd(vy, t0)));
+    const auto dx = _mm_sub_pd(ex, _mm_mul_pd(vx, dt));
+    const auto dy = _mm_sub_pd(ey, _mm_mul_pd(vy, dt));
+
+    const auto num = _mm_xor_pd(sign, _mm_add_pd(_mm_mul_pd(px, dx), _mm_mul_pd(py, dy)));
+    const auto den = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+    const auto s   = _mm_min_pd(_mm_max_pd(_mm_div_pd(num, den), zero), one);
+    const auto qx  = _mm_add_pd(px, _mm_mul_pd(s, dx));
+    const auto qy  = _mm_add_pd(py, _mm_mul_pd(s, dy));
+    const auto mr  = _mm_add_pd(margin, _mm_loadu_pd(r_.data() + i));
+
+    const auto hit = _mm_cmplt_pd(_mm_add_pd(_mm_mul_pd(qx, qx), _mm_mul_pd(qy, qy)),
+                                  _mm_mul_pd(mr, mr));
+    if (_mm_movemask_pd(hit)) return true;
+  }
+#endif
+  return false;
+#else
+  // SIMD命令が使えない環境ではスカラー実装で判定する
+  return sweptObstructedReference(_sx, _sy, _t0, _gx, _gy, _t1, _margin);
+#endif
+}
+
+} // namespace planner
+} // namespace ai
@@ -0,0 +1,79 @@
+#ifndef AI_PLANNER_OBSTACLE_SET_HPP_
+#define AI_PLANNER_OBSTACLE_SET_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace ai {
+namespace planner {
+
+/// @class   obstacleSet
+/// @brief   円形の障害物の集合を座標ごとの配列(SoA)で保持し, 線分との干渉を判定する
+///
+/// obstructed()とsweptObstructed()はSIMD命令で複数の障害物を同時に調べる.
+/// 名前の末尾にReferenceが付く関数は同じ判定を障害物1つずつ行うスカラー実装で,
+/// 両者の結果は常に一致する (浮動小数点演算の順序も揃えてある)
+class obstacleSet {
+public:
+  obstacleSet();
+
+  /// @brief           全ての障害物を削除する (メモリは解放しない)
+  void clear();
+
+  /// @brief           障害物を追加する
+  /// @param x         中心のx座標
+  /// @param y         中心のy座標
+  /// @param r         半径
+  /// @param vx        x方向の速度 (sweptObstructed()でのみ使う)
+  /// @param vy        y方向の速度 (sweptObstructed()でのみ使う)
+  void add(double _x, double _y, double _r, double _vx = 0.0, double _vy = 0.0);
+
+  /// @brief           障害物の数を返す
+  std::size_t size() const;
+
+  /// @brief           線分が障害物と干渉するか
+  /// @param sx        始点のx座標
+  /// @param sy        始点のy座標
+  /// @param gx        終点のx座標
+  /// @param gy        終点のy座標
+  /// @param margin    障害物の半径に加えるマージン
+  bool obstructed(double _sx, double _sy, double _gx, double _gy, double _margin) const;
+
+  /// @brief           obstructed()と同じ判定をスカラー演算で行う
+  bool obstructedReference(double _sx, double _sy, double _gx, double _gy,
+                           double _margin) const;
+
+  /// @brief           時刻t0に始点を出て時刻t1に終点へ等速で着くまでの間に,
+  ///                  速度に従って動く障害物と近づきすぎるか
+  /// @param sx        始点のx座標
+  /// @param sy        始点のy座標
+  /// @param t0        始点を出る時刻
+  /// @param gx        終点のx座標
+  /// @param gy        終点のy座標
+  /// @param t1        終点に着く時刻
+  /// @param margin    障害物の半径に加えるマージン
+  ///
+  /// 障害物の中心は時刻tに(x + vx * t, y + vy * t)にあるものとする.
+  /// 障害物から見た相対的な動きは線分になるので, その線分と中心の最短距離で判定する
+  bool sweptObstructed(double _sx, double _sy, double _t0, double _gx, double _gy,
+                       double _t1, double _margin) const;
+
+  /// @brief           sweptObstructed()と同じ判定をスカラー演算で行う
+  bool sweptObstructedReference(double _sx, double _sy, double _t0, double _gx, double _gy,
+                                double _t1, double _margin) const;
+
+private:
+  // 各配列の長さはSIMD命令で同時に処理する要素数の倍数とし,
+  // 余った要素は決して干渉しない障害物(半径がNaN)で埋める
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<double> r_;
+  std::vector<double> vx_;
+  std::vector<double> vy_;
+  std::size_t size_;
+};
+
+} // namespace planner
+} // namespace ai
+
+#endif // AI_PLANNER_OBSTACLE_SET_HPP_
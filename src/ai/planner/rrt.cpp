@@ -1,80 +1,111 @@
+#include <algorithm>
 #include <cmath>
+#include <numeric>
+#include <optional>
 #include <random>
 #include "ai/planner/rrt.hpp"
 
 namespace ai {
 namespace planner {
-rrt::rrt(const model::world& _world) : world_(_world) {
-  // ペナルティエリアを障害物指定(正方形の外接円で近似)
-  defaultObstacles_.push_back(obstacle{position{world_.field().xMax(), 0.0, 0.0},
-                                       static_cast<double>(world_.field().penaltyLength())});
-  defaultObstacles_.push_back(obstacle{position{world_.field().xMin(), 0.0, 0.0},
-                                       static_cast<double>(world_.field().penaltyLength())});
+rrt::rrt(const model::world& _world) : rrt(_world, std::random_device{}()) {}
+
+rrt::rrt(const model::world& _world, const uint64_t _seed)
+    : world_(_world), nearestNode_(0), iterations_(0), speed_(0.0), random_(_seed) {
+  updateDefaultObstacles();
 }
 
 bool rrt::obstructed(const position _start, const position _goal, const double _margin) {
-  // 2点が完全に一致していたら
-  if (_start.x == _goal.x && _start.y == _goal.y) {
-    return false;
-  }
+  return obstacleSet_.obstructed(_start.x, _start.y, _goal.x, _goal.y, _margin);
+}
 
-  double a = _goal.y - _start.y;
-  double b = -(_goal.x - _start.x);
-  double c = -a * _start.x - b * _start.y;
+bool rrt::swept(const position _from, const double _fromCost, const position _to,
+                const double _margin) {
+  const auto t0 = _fromCost / speed_;
+  const auto t1 = t0 + std::hypot(_to.x - _from.x, _to.y - _from.y) / speed_;
+  return obstacleSet_.sweptObstructed(_from.x, _from.y, t0, _to.x, _to.y, t1, _margin);
+}
 
-  bool obstructed = false;
+void rrt::obstacles(const std::vector<obstacle>& _obstacles) {
+  additionalObstacles_ = _obstacles;
+  rebuildObstacles();
+}
+
+void rrt::updateDefaultObstacles() {
+  // ペナルティエリアを障害物指定
+  if (penaltyObstacles(world_.field(), defaultObstacles_)) rebuildObstacles();
+}
+
+void rrt::rebuildObstacles() {
+  allObstacles_ = additionalObstacles_;
+  std::copy(defaultObstacles_.begin(), defaultObstacles_.end(),
+            std::back_inserter(allObstacles_));
+  obstacleSet_.clear();
   for (const auto& it : allObstacles_) {
-    // 障害物と直線の距離
-    double dist = std::abs(a * it.position_.x + b * it.position_.y + c) / std::hypot(a, b);
-    // 直線の方向ベクトル
-    double vx = (_goal.x - _start.x) / std::hypot(_start.x - _goal.x, _start.y - _goal.y);
-    double vy = (_goal.y - _start.y) / std::hypot(_start.x - _goal.x, _start.y - _goal.y);
-    // 障害物判定のための内点
-    double px1 = _start.x + vx * (_margin + it.r_);
-    double py1 = _start.y + vy * (_margin + it.r_);
-    double px2 = _goal.x + vx * (_margin + it.r_);
-    double py2 = _goal.y + vy * (_margin + it.r_);
-
-    // 線に近く，p1,p2の点の四角形内に障害物があったら
-    if (dist < _margin + it.r_ && it.position_.x + it.r_ > std::min(px1, px2) &&
-        it.position_.x - it.r_ < std::max(px1, px2) &&
-        it.position_.y + it.r_ > std::min(py1, py2) &&
-        it.position_.y - it.r_ < std::max(py1, py2)) {
-      obstructed = true;
-      break;
-    }
+    obstacleSet_.add(it.position_.x, it.position_.y, it.r_, it.velocity_.vx, it.velocity_.vy);
   }
-  return obstructed;
 }
 
-bool rrt::inPenalty(const position _point, const double _margin) {
-  if (std::abs(_point.x) > (world_.field().xMax() - world_.field().penaltyLength() - _margin) &&
-      std::abs(_point.y) < (world_.field().penaltyWidth() / 2.0 - _margin)) {
-    return true;
+void rrt::search(const position _start, const position _goal, const uint32_t _searchNum,
+                 const double maxBranchLength, const double _margin) {
+  updateDefaultObstacles();
+  iterations_ = 0;
+  if (!escape(_start, _margin)) { // RRT*
+    // 毎回新しい木を作り, 決まった回数だけ伸ばす
+    resetTree(_start, _searchNum + 1, maxBranchLength, _margin);
+    grow(_goal, _searchNum, util::TimePointType::max(), maxBranchLength, _margin);
+    smooth();
+    buildPath(_goal);
+  } else {
+    path_.assign({{_start.x, _start.y, _goal.theta}, {target_.x, target_.y, _goal.theta}});
   }
-  return false;
+  target_.theta = _goal.theta;
 }
 
-bool rrt::outField(const position _point, const double _margin) {
-  if (std::abs(_point.x) > world_.field().xMax() + _margin ||
-      std::abs(_point.y) > world_.field().yMax() + _margin) {
-    return true;
+void rrt::search(const position _start, const position _goal,
+                 const util::TimePointType _deadline, const uint32_t _maxNodes,
+                 const double _maxBranchLength, const double _margin) {
+  updateDefaultObstacles();
+  iterations_ = 0;
+  if (!escape(_start, _margin)) { // anytime RRT*
+    // 前回の木を現在位置に付け替えて使い, 付け替えられなければ作り直す
+    if (!reroot(_start, _maxNodes, _maxBranchLength, _margin)) {
+      resetTree(_start, _maxNodes, _maxBranchLength, _margin);
+    }
+    const auto size = static_cast<uint32_t>(tree_.size());
+    grow(_goal, _maxNodes > size ? _maxNodes - size : 0, _deadline, _maxBranchLength, _margin);
+    smooth();
+    buildPath(_goal);
+  } else {
+    path_.assign({{_start.x, _start.y, _goal.theta}, {target_.x, target_.y, _goal.theta}});
   }
-  return false;
+  target_.theta = _goal.theta;
 }
 
-void rrt::obstacles(const std::vector<obstacle>& _obstacles) {
-  allObstacles_.clear();
-  allObstacles_ = _obstacles;
-  std::copy(defaultObstacles_.begin(), defaultObstacles_.end(),
-            std::back_inserter(allObstacles_));
+void rrt::seed(const uint64_t _seed) {
+  random_.seed(_seed);
+  // 前回までの探索の結果も捨て, 作り直したときと同じ状態にする
+  tree_.clear();
+  std::queue<position>().swap(priorityPoints_);
 }
 
-void rrt::search(const position _start, const position _goal, const uint32_t _searchNum,
-                 const double maxBranchLength, const double _margin) {
+uint32_t rrt::iterations() const {
+  return iterations_;
+}
+
+const std::vector<position>& rrt::path() const {
+  return path_;
+}
+
+void rrt::robotSpeed(const double _speed) {
+  speed_ = std::max(_speed, 0.0);
+}
+
+double rrt::robotSpeed() const {
+  return speed_;
+}
+
+bool rrt::escape(const position _start, const double _margin) {
   obstacle nearObstacle;
-  position minPos = {world_.field().xMin(), world_.field().yMin(), 0};
-  position maxPos = {world_.field().xMax(), world_.field().yMax(), 0};
 
   bool inAvoidRange = false;
   for (auto&& it : allObstacles_) {
@@ -89,124 +120,281 @@ void rrt::search(const position _start, const position _goal, const uint32_t _se
     target_.x     = nearObstacle.position_.x + nearObstacle.r_ * std::cos(angle);
     target_.y     = nearObstacle.position_.y + nearObstacle.r_ * std::sin(angle);
     target_.theta = 0.0;
-  } else if (inPenalty(_start, _margin) ||
-             outField(_start, 200.0)) { // penalty内かfield外，特別処理
+    return true;
+  }
+  const auto map = world_.fieldMap();
+  if (map->inPenalty(_start.x, _start.y, _margin) ||
+      map->outside(_start.x, _start.y, 200.0)) { // penalty内かfield外，特別処理
     target_ = {0.0, 0.0, 0.0};
-  } else { // RRT*
-    tree_.clear();
-    // 初期ノード追加
-    tree_.push_back(std::make_shared<node>(node{_start, 0.0, {}}));
-
-    uint32_t searchCount = 0;
-    std::random_device rnd;
-    std::mt19937 mt(rnd());
-    std::uniform_real_distribution<> randX(minPos.x - _margin, maxPos.x + _margin);
-    std::uniform_real_distribution<> randY(minPos.y - _margin, maxPos.y + _margin);
-
-    double minDistToGoal = 10000; // 目標位置までの最短距離(初期値は大きく取る)
-
-    while (searchCount < _searchNum) {
-      searchCount++;
-      position searchPos; // 次探索点
-      bool onObstacle;    // 障害物上は探索しない
-      double minDist                = 100000.0;
-      std::shared_ptr<node> minNode = nullptr;
-      position minNewNode;
-      position nextNode;
+    return true;
+  }
+  return false;
+}
+
+void rrt::resetIndex(const double _maxBranchLength, const double _margin) {
+  // 探索範囲全体を覆う格子で木のノードを管理する
+  index_.reset(world_.field().xMin() - _margin, world_.field().yMin() - _margin,
+               world_.field().xMax() + _margin, world_.field().yMax() + _margin,
+               _maxBranchLength);
+}
+
+void rrt::resetTree(const position _start, const uint32_t _capacity,
+                    const double _maxBranchLength, const double _margin) {
+  // 前回の探索で確保した領域は解放せずに使い回す
+  tree_.clear();
+  tree_.reserve(_capacity);
+  // 初期ノード追加
+  tree_.push_back(node{_start, 0.0, noParent});
+
+  resetIndex(_maxBranchLength, _margin);
+  index_.reserve(_capacity);
+  index_.insert(0, _start.x, _start.y);
+}
+
+bool rrt::reroot(const position _start, const uint32_t _maxNodes,
+                 const double _maxBranchLength, const double _margin) {
+  if (tree_.empty()) return false;
+
+  // 現在位置から障害物なく枝を伸ばせる最も近いノードを探す
+  const auto joint = index_.nearest(_start.x, _start.y, [&](uint32_t _i, double) {
+    const auto& q = tree_[_i].position_;
+    return !(speed_ > 0.0 ? swept(_start, 0.0, q) : obstructed(_start, q));
+  });
+  if (!joint) return false;
+
+  // 現在位置を新しい根とし, jointから古い根までの親子関係を逆にする
+  // 前回の目標にちょうど到達していたときは, そのノードをそのまま根にする
+  // (同じ位置に2つのノードがあると, 次の目標がいつまでも現在位置になってしまう)
+  auto root  = *joint;
+  auto child = *joint;
+  auto it    = tree_[*joint].parent_;
+  if (tree_[root].position_.x != _start.x || tree_[root].position_.y != _start.y) {
+    root  = static_cast<uint32_t>(tree_.size());
+    child = root;
+    it    = *joint;
+    tree_.push_back(node{_start, 0.0, noParent});
+  }
+  for (auto i = 0u; it != noParent && i < tree_.size(); ++i) {
+    const auto parent = tree_[it].parent_;
+    tree_[it].parent_ = child;
+    child             = it;
+    it                = parent;
+  }
+  tree_[root].parent_ = noParent;
+
+  // 各ノードの子の一覧を作る
+  // ノードiの子はchildren_のchildBegin_[i]番目からchildBegin_[i + 1]番目の手前まで
+  const auto n = tree_.size();
+  childBegin_.assign(n + 1, 0);
+  for (const auto& nd : tree_) {
+    if (nd.parent_ != noParent) ++childBegin_[nd.parent_ + 1];
+  }
+  std::partial_sum(childBegin_.begin(), childBegin_.end(), childBegin_.begin());
+  children_.resize(childBegin_[n]);
+  for (auto i = 0u; i < n; ++i) {
+    if (tree_[i].parent_ != noParent) children_[childBegin_[tree_[i].parent_]++] = i;
+  }
+  // 上のループで各要素が次の要素の値まで進んでいるので, 1つずつずらして戻す
+  std::copy_backward(childBegin_.begin(), childBegin_.end() - 1, childBegin_.end());
+  childBegin_[0] = 0;
+
+  // 根から幅優先で辿り, 障害物と干渉するようになった枝の先を捨てながら詰め直す
+  // 新しく伸ばす分を残すため, 引き継ぐのは上限の半分まで
+  const auto keep = std::max(_maxNodes / 2, 1u);
+  spare_.clear();
+  spare_.reserve(std::max<std::size_t>(_maxNodes, n));
+  origin_.clear();
+  spare_.push_back(node{_start, 0.0, noParent});
+  origin_.push_back(root);
+  for (auto i = 0u; i < spare_.size() && spare_.size() < keep; ++i) {
+    const auto p    = spare_[i].position_;
+    const auto cost = spare_[i].cost_;
+    const auto o    = origin_[i];
+    for (auto c = childBegin_[o]; c < childBegin_[o + 1] && spare_.size() < keep; ++c) {
+      const auto& q = tree_[children_[c]].position_;
+      if (speed_ > 0.0 ? swept(p, cost, q) : obstructed(p, q)) continue;
+      spare_.push_back(node{q, cost + std::hypot(q.x - p.x, q.y - p.y), i});
+      origin_.push_back(children_[c]);
+    }
+  }
+  tree_.swap(spare_);
+  tree_.reserve(_maxNodes);
+
+  resetIndex(_maxBranchLength, _margin);
+  index_.reserve(_maxNodes);
+  for (auto i = 0u; i < tree_.size(); ++i) {
+    index_.insert(i, tree_[i].position_.x, tree_[i].position_.y);
+  }
+  return true;
+}
+
+void rrt::grow(const position _goal, const uint32_t _maxIterations,
+               const util::TimePointType _deadline, const double maxBranchLength,
+               const double _margin) {
+  position minPos = {world_.field().xMin(), world_.field().yMin(), 0};
+  position maxPos = {world_.field().xMax(), world_.field().yMax(), 0};
+
+  // 再接続を行う半径の係数 (RRT*の論文のγに相当)
+  // 再接続する範囲はノードが増えるにつれて狭くなるが, 枝の長さよりは小さくしない
+  const auto width  = maxPos.x - minPos.x + 2 * _margin;
+  const auto height = maxPos.y - minPos.y + 2 * _margin;
+  const auto gamma  = 2.0 * std::sqrt(1.5 * width * height / M_PI);
+
+  // 目標位置までの最短距離(初期値は大きく取る)
+  // 引き継いだ木があれば, その中で目標位置に最も近いノードから始める
+  double minDistToGoal = 10000;
+  nearestNode_         = 0;
+  for (auto i = 1u; i < tree_.size(); ++i) {
+    const auto& p = tree_[i].position_;
+    const auto d  = std::hypot(_goal.x - p.x, _goal.y - p.y);
+    if (minDistToGoal > d) {
+      minDistToGoal = d;
+      nearestNode_  = i;
+    }
+  }
+
+  // 期限がなければ時刻を調べない
+  const bool timed = _deadline != util::TimePointType::max();
+  // 期限を過ぎていても1回は木を伸ばす
+  while (iterations_ < _maxIterations &&
+         (iterations_ == 0 || !timed || util::ClockType::now() < _deadline)) {
+    iterations_++;
+    position searchPos; // 次探索点
+    bool onObstacle;    // 障害物上は探索しない
+    double minDist = 0.0;
+    std::optional<uint32_t> minNode;
+    position minNewNode;
+    position nextNode;
+    do {
       do {
-        do {
-          onObstacle = false;
-          if (priorityPoints_.size() == 0) {
-            searchPos.x = randX(mt);
-            searchPos.y = randX(mt);
-          } else {
-            searchPos = priorityPoints_.front();
-            priorityPoints_.pop();
-          }
-          for (const auto it : allObstacles_) {
-            if (std::hypot(searchPos.x - it.position_.x, searchPos.y - it.position_.y) <
-                (it.r_ + _margin)) {
-              onObstacle = true;
-            }
-          }
-        } while (onObstacle);
-        // ツリー中の全ノードから次探索点までの距離を算出，最近傍で障害物のないものを選ぶ
-        for (const auto tree : tree_) {
-          // 距離算出
-          double dist =
-              std::hypot(searchPos.x - tree->position_.x, searchPos.y - tree->position_.y);
-          nextNode.x =
-              std::min(dist, maxBranchLength) * (searchPos.x - tree->position_.x) / dist +
-              tree->position_.x;
-          nextNode.y =
-              std::min(dist, maxBranchLength) * (searchPos.y - tree->position_.y) / dist +
-              tree->position_.y;
-
-          // 距離比較
-          if (minDist > dist) {
-            // 障害物検査
-            if (!(obstructed(searchPos, nextNode))) {
-              minDist    = dist;
-              minNode    = tree;
-              minNewNode = nextNode;
-            }
+        onObstacle = false;
+        if (priorityPoints_.size() == 0) {
+          searchPos.x = random_.uniform(minPos.x - _margin, maxPos.x + _margin);
+          searchPos.y = random_.uniform(minPos.y - _margin, maxPos.y + _margin);
+        } else {
+          searchPos = priorityPoints_.front();
+          priorityPoints_.pop();
+        }
+        for (const auto& it : allObstacles_) {
+          if (std::hypot(searchPos.x - it.position_.x, searchPos.y - it.position_.y) <
+              (it.r_ + _margin)) {
+            onObstacle = true;
           }
         }
-      } while (minNode == nullptr);
-
-      // 伸ばせるノードを見つけていたらtree追加
-      if (minNode != nullptr) {
-        std::shared_ptr<node> newNode = std::make_shared<node>(
-            node{minNewNode, minNode->cost_ + std::min(minDist, maxBranchLength), minNode});
-
-        tree_.push_back(newNode);
-        // 新ノードからゴールまでの距離を計算
-        double distBetGoalToNewNode =
-            std::hypot(_goal.x - newNode->position_.x, _goal.y - newNode->position_.y);
-        if (minDistToGoal > distBetGoalToNewNode) {
-          minDistToGoal = distBetGoalToNewNode;
-          nearestNode_  = newNode;
+      } while (onObstacle);
+      // 次探索点に近いノードから順に調べ, 障害物なく枝を伸ばせる最近傍のノードを選ぶ
+      minNode = index_.nearest(searchPos.x, searchPos.y, [&](uint32_t _i, double _dist) {
+        const auto& p = tree_[_i].position_;
+        if (_dist > 0.0) {
+          nextNode.x = std::min(_dist, maxBranchLength) * (searchPos.x - p.x) / _dist + p.x;
+          nextNode.y = std::min(_dist, maxBranchLength) * (searchPos.y - p.y) / _dist + p.y;
+        } else {
+          nextNode = p;
         }
-        // これまでの道と新しいノードからの道を比較してコスト低ならノード再接続
-        for (auto& it : tree_) {
-          // 追加した物自身だったらやめる
-          if (it != newNode) {
-            // コストの比較
-            double rewiredCost =
-                newNode->cost_ + std::hypot(newNode->position_.x - it->position_.x,
-                                            newNode->position_.y - it->position_.y);
-            if (it->cost_ > rewiredCost) {
-              // 障害物検査
-              searchPos = it->position_;
-              nextNode  = newNode->position_;
-              if (!(obstructed(searchPos, nextNode))) {
-                it->cost_   = rewiredCost;
-                it->parent_ = newNode;
-              }
-            }
-          }
+        // 障害物検査
+        // 障害物の移動を考慮するときは, _iから伸ばす枝そのものを調べる
+        if (speed_ > 0.0 ? swept(p, tree_[_i].cost_, nextNode)
+                         : obstructed(searchPos, nextNode)) {
+          return false;
         }
-      }
+        minDist    = _dist;
+        minNewNode = nextNode;
+        return true;
+      });
+    } while (!minNode);
+    // 既にあるノードと同じ位置には追加しない
+    // (前回の経路から選んだ優先探索点は, 引き継いだ木のノードと一致する)
+    if (minDist == 0.0) continue;
+
+    // 伸ばせるノードを見つけていたらtree追加
+    const auto newIndex = static_cast<uint32_t>(tree_.size());
+    const auto newCost  = tree_[*minNode].cost_ + std::min(minDist, maxBranchLength);
+    tree_.push_back(node{minNewNode, newCost, *minNode});
+    const auto& newNode = tree_.back();
+    index_.insert(newIndex, newNode.position_.x, newNode.position_.y);
+    // 新ノードからゴールまでの距離を計算
+    double distBetGoalToNewNode =
+        std::hypot(_goal.x - newNode.position_.x, _goal.y - newNode.position_.y);
+    if (minDistToGoal > distBetGoalToNewNode) {
+      minDistToGoal = distBetGoalToNewNode;
+      nearestNode_  = newIndex;
     }
-    auto node = nearestNode_;
-    std::queue<position>().swap(priorityPoints_);
-    priorityPoints_.push(node->position_);
-    // 障害物を挟まないノードをショートカットして
-    // スムースをかける
-    while (!node->parent_.expired() && !node->parent_.lock()->parent_.expired() &&
-           node->parent_.lock()->parent_.lock() != nullptr) {
-      if (!obstructed(node->position_, node->parent_.lock()->parent_.lock()->position_,
-                      100.0)) {
-        node->parent_ = node->parent_.lock()->parent_.lock();
-      } else {
-        node = node->parent_.lock();
-        priorityPoints_.push(node->position_);
-        target_ = node->position_;
+    // 近傍のノードについて, これまでの道と新しいノードからの道を比較して
+    // コスト低ならノード再接続
+    const auto n      = static_cast<double>(tree_.size());
+    const auto radius = std::max(maxBranchLength, gamma * std::sqrt(std::log(n) / n));
+    neighbors_.clear();
+    index_.within(newNode.position_.x, newNode.position_.y, radius, neighbors_);
+    for (auto i : neighbors_) {
+      // 追加した物自身だったらやめる
+      if (i == newIndex) continue;
+      auto& it = tree_[i];
+      // コストの比較
+      double rewiredCost = newNode.cost_ + std::hypot(newNode.position_.x - it.position_.x,
+                                                      newNode.position_.y - it.position_.y);
+      if (it.cost_ > rewiredCost) {
+        // 障害物検査
+        if (!(speed_ > 0.0 ? swept(newNode.position_, newNode.cost_, it.position_)
+                           : obstructed(it.position_, newNode.position_))) {
+          it.cost_   = rewiredCost;
+          it.parent_ = newIndex;
+        }
       }
     }
-    target_ = node->position_;
   }
-  target_.theta = _goal.theta;
+}
+
+void rrt::smooth() {
+  auto node = nearestNode_;
+  std::queue<position>().swap(priorityPoints_);
+  priorityPoints_.push(tree_[node].position_);
+  // 障害物を挟まないノードをショートカットして
+  // スムースをかける
+  while (tree_[node].parent_ != noParent && tree_[tree_[node].parent_].parent_ != noParent) {
+    const auto grandParent = tree_[tree_[node].parent_].parent_;
+    const auto& p          = tree_[grandParent];
+    if (!(speed_ > 0.0 ? swept(p.position_, p.cost_, tree_[node].position_, 100.0)
+                       : obstructed(tree_[node].position_, p.position_, 100.0))) {
+      tree_[node].parent_ = grandParent;
+    } else {
+      node = tree_[node].parent_;
+      priorityPoints_.push(tree_[node].position_);
+      target_ = tree_[node].position_;
+    }
+  }
+  target_ = tree_[node].position_;
+}
+
+void rrt::buildPath(const position _goal) {
+  // 根から目標位置に最も近いノードまで並べる
+  path_.clear();
+  for (auto node = nearestNode_; node != noParent; node = tree_[node].parent_) {
+    path_.push_back(tree_[node].position_);
+    if (path_.size() > tree_.size()) break;
+  }
+  std::reverse(path_.begin(), path_.end());
+  // 目標位置まで直接つなげるなら, 目標位置を終点にする
+  if (!(speed_ > 0.0 ? swept(path_.back(), tree_[nearestNode_].cost_, _goal, 100.0)
+                     : obstructed(_goal, path_.back(), 100.0))) {
+    path_.push_back(_goal);
+  }
+
+  // 各経由点から見通せる最も遠い経由点へショートカットする
+  // 書き込む位置は読み出す位置を追い越さないので, その場で詰められる
+  auto last   = 0u;
+  double cost = 0.0;
+  for (auto i = 0u; i + 1 < path_.size();) {
+    auto j = static_cast<uint32_t>(path_.size() - 1);
+    while (j > i + 1 && (speed_ > 0.0 ? swept(path_[i], cost, path_[j], 100.0)
+                                      : obstructed(path_[j], path_[i], 100.0))) {
+      --j;
+    }
+    cost += std::hypot(path_[j].x - path_[i].x, path_[j].y - path_[i].y);
+    path_[++last] = path_[j];
+    i             = j;
+  }
+  path_.resize(last + 1);
+  for (auto& p : path_) p.theta = _goal.theta;
 }
 
 } // namespace planner
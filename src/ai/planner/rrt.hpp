@@ -1,8 +1,7 @@
 #ifndef AI_PLANNER_RRT_HPP_
 #define AI_PLANNER_RRT_HPP_
 
-#include <list>
-#include <memory>
+#include <limits>
 #include <queue>
 #include <vector>
 #include <stdint.h>
@@ -10,6 +9,10 @@
 #include "ai/model/command.hpp"
 #include "ai/model/world.hpp"
 #include "ai/planner/base.hpp"
+#include "ai/planner/obstacleSet.hpp"
+#include "ai/planner/spatialGrid.hpp"
+#include "ai/util/time.hpp"
+#include "ai/util/xoshiro.hpp"
 
 namespace ai {
 namespace planner {
@@ -18,22 +21,26 @@ namespace planner {
 /// @brief : Path planner using RRT*
 class rrt final : public base {
 public:
+  /// @brief : 乱数のシードをstd::random_deviceで決める
   explicit rrt(const model::world& _world);
+
+  /// @brief : 乱数のシードを指定する (同じシードと入力からは同じ木が作られる)
+  rrt(const model::world& _world, const uint64_t _seed);
   //~rrt_star();
 
+  /// 親を持たないノードの親の添字
+  static constexpr uint32_t noParent = std::numeric_limits<uint32_t>::max();
+
   // 節点
   struct node {
-    position position_;                 // 座標
-    double cost_;                       // 親ノードまでに必要なコスト
-    std::weak_ptr<struct node> parent_; // 親ノードを指すポインタ
-  };
-
-  // 障害物
-  struct obstacle {
     position position_; // 座標
-    double r_;          // 物体の半径
+    double cost_;       // 親ノードまでに必要なコスト
+    uint32_t parent_;   // 親ノードのtree_での添字 (根ならnoParent)
   };
 
+  // 障害物 (速度はrobotSpeed()が正のときだけ考慮する)
+  using obstacle = planner::obstacle;
+
   /// @brief :  障害物の任意指定
   /// @param :  obstacles 障害物(struct object)のvector
   void obstacles(const std::vector<obstacle>& _obstacles);
@@ -47,13 +54,66 @@ public:
   void search(const position _start, const position _goal, const uint32_t _searchNum = 100,
               const double _maxBranchLength = 300.0, const double _margin = 150.0);
 
+  /// @brief : 期限まで木を伸ばし続ける探索関数(anytime RRT*)
+  /// @param : _start 初期位置
+  /// @param : _goal  目標位置
+  /// @param : _deadline 探索を打ち切る時刻 (過ぎていても1回は木を伸ばす)
+  /// @param : _maxNodes 木のノード数の上限
+  /// @param : _maxBranchLength 伸ばす枝の最大距離
+  /// @param : _margin  避けるときのマージン
+  ///
+  /// 前回の探索で作った木を現在位置に付け替え, 障害物と干渉するようになった枝を
+  /// 取り除いてから探索を続けるので, 周期ごとに呼ぶと経路が少しずつ改善される.
+  /// 付け替えられる木がなければ新しく作る
+  void search(const position _start, const position _goal,
+              const util::TimePointType _deadline, const uint32_t _maxNodes = 3000,
+              const double _maxBranchLength = 300.0, const double _margin = 150.0);
+
+  /// @brief : 乱数のシードを設定し直し, 前回までの探索の結果を捨てる
+  ///
+  /// 記録した場面を同じシードで再生すれば, 同じ木が作られる
+  void seed(const uint64_t _seed);
+
+  /// @brief : 直前の探索で木を伸ばした回数
+  uint32_t iterations() const;
+
+  /// @brief : 直前の探索で得られた経路
+  ///
+  /// 初期位置から始まり, 目標位置(障害物で直接つなげなければ目標に最も近いノード)で終わる.
+  /// 見通せる経由点の間はショートカットしてあり, 角度は全て目標の角度にしてある.
+  /// trajectoryに渡せば, 時刻ごとの目標位置と速度が得られる
+  const std::vector<position>& path() const;
+
+  /// @brief : 枝を辿るときのロボットの速さを設定する
+  /// @param : _speed 速さ[mm/s], 0なら障害物は止まっているものとして扱う
+  ///
+  /// 正の値を設定すると, ロボットが根から各ノードまでこの速さで進むとして,
+  /// 枝を通る間に障害物がその速度で動いた位置と干渉するかを調べる.
+  /// 障害物が今いる位置だけでなく, これから来る位置も避けられるので,
+  /// 障害物の半径を小さく見積もっても安全な経路が得られる
+  void robotSpeed(const double _speed);
+
+  /// @brief : 枝を辿るときのロボットの速さ[mm/s]
+  double robotSpeed() const;
+
 private:
   const model::world& world_;
-  std::vector<std::shared_ptr<struct node>> tree_; // 探索木(nodeの集まり)
-  std::shared_ptr<node> nearestNode_;              // 次の目標節点
+  std::vector<node> tree_;           // 探索木(nodeの集まり), 領域は探索ごとに再利用する
+  spatialGrid index_;                // tree_の各ノードの位置の索引
+  std::vector<uint32_t> neighbors_;  // 再接続を調べる近傍ノード
+  uint32_t nearestNode_;             // 次の目標節点のtree_での添字
+  uint32_t iterations_;              // 直前の探索で木を伸ばした回数
+  double speed_;                     // 枝を辿るときのロボットの速さ, 0なら障害物は止まっている
+  std::vector<node> spare_;          // 木を詰め直すときの作業領域
+  std::vector<uint32_t> origin_;     // spare_の各ノードに対応するtree_での添字
+  std::vector<uint32_t> childBegin_; // 各ノードの子がchildren_のどこから始まるか
+  std::vector<uint32_t> children_;   // 各ノードの子の添字を親ごとに並べたもの
+  util::xoshiro random_;             // 探索点を決める乱数生成器
   std::vector<obstacle> defaultObstacles_; // 固定障害物,セットしなくても避ける
   std::vector<obstacle> additionalObstacles_; // 追加障害物,任意にセットして避ける
   std::vector<obstacle> allObstacles_;        // 障害物,上記2つの合算
+  std::vector<position> path_;                // 直前の探索で得られた経路
+  obstacleSet obstacleSet_;                   // allObstacles_を線分との干渉判定用に並べ直したもの
   std::queue<position>
       priorityPoints_; // あるループで生成された最適なルート木，次ループで優先して探索
 
@@ -63,15 +123,51 @@ private:
   /// @param  _margin  避けるときのマージン
   bool obstructed(const position _start, const position _goal, const double _margin = 150.0);
 
-  /// @brief  ペナルティエリア内に点があるか
-  /// @param  _point 見たい座標
+  /// @brief  speed_で枝を辿る間に, 動いている障害物と干渉するか
+  /// @param  _from 枝の始点
+  /// @param  _fromCost 根から_fromまでの距離 (これをspeed_で割った時刻に_fromを出る)
+  /// @param  _to   枝の終点
   /// @param  _margin  避けるときのマージン
-  bool inPenalty(const position _point, const double _margin = 150.0);
+  bool swept(const position _from, const double _fromCost, const position _to,
+             const double _margin = 150.0);
 
-  /// @brief  フィールド外に点があるか
-  /// @param  _point 見たい座標
+  /// @brief  現在のフィールドからペナルティエリアの障害物を求め,
+  ///         変わっていればdefaultObstacles_と障害物の集合を作り直す
+  void updateDefaultObstacles();
+
+  /// @brief  additionalObstacles_とdefaultObstacles_から障害物の集合を作る
+  void rebuildObstacles();
+
+  /// @brief  開始位置が障害物やペナルティエリアの中, フィールドの外にあれば,
+  ///         そこから出るための目標を設定する
+  /// @param  _start 初期位置
   /// @param  _margin  避けるときのマージン
-  bool outField(const position _point, const double _margin = 150.0);
+  /// @return 目標を設定したか
+  bool escape(const position _start, const double _margin);
+
+  /// @brief  ノードの索引を探索範囲に合わせて空にする
+  void resetIndex(const double _maxBranchLength, const double _margin);
+
+  /// @brief  初期位置だけからなる木を作る
+  /// @param  _capacity あらかじめ確保しておくノード数
+  void resetTree(const position _start, const uint32_t _capacity,
+                 const double _maxBranchLength, const double _margin);
+
+  /// @brief  前回の木の根を初期位置に付け替え, 障害物と干渉する枝の先を取り除く
+  /// @return 付け替えられたか
+  bool reroot(const position _start, const uint32_t _maxNodes, const double _maxBranchLength,
+              const double _margin);
+
+  /// @brief  回数の上限か期限に達するまで木を伸ばす
+  void grow(const position _goal, const uint32_t _maxIterations,
+            const util::TimePointType _deadline, const double _maxBranchLength,
+            const double _margin);
+
+  /// @brief  目標位置に最も近いノードから根までの経路をショートカットし, 次の目標を決める
+  void smooth();
+
+  /// @brief  目標位置に最も近いノードから根までを辿ってpath_を作る
+  void buildPath(const position _goal);
 };
 
 } // namespace planner
@@ -0,0 +1,105 @@
+#include <stdexcept>
+
+#include "ai/planner/service.hpp"
+
+namespace ai {
+namespace planner {
+
+namespace {
+
+// フィールドの情報だけを設定したWorldModelを作る
+model::world fieldOnly(const model::field& _field) {
+  model::world world{};
+  world.field(_field);
+  return world;
+}
+
+} // namespace
+
+service::slot::slot(const model::field& _field)
+    : world(fieldOnly(_field)),
+      planner(world),
+      iterations(0),
+      planned(false),
+      busy(false),
+      generation(0) {}
+
+service::service(const model::world& _world, std::size_t _threads)
+    : world_(_world), generation_(0), pending_(0), timeouts_(0), pool_(_threads) {}
+
+std::vector<service::result> service::plan(const std::vector<request>& _requests,
+                                           util::TimePointType _deadline) {
+  for (const auto& r : _requests) {
+    if (r.id >= slots_.size()) throw std::out_of_range("planner::service::plan");
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  ++generation_;
+  pending_ = 0;
+
+  for (const auto& r : _requests) {
+    auto& s = slots_[r.id];
+    if (!s) s = std::make_unique<slot>(world_.field());
+    // 前回の計画が終わっていなければ, 今回の要求は見送る
+    if (s->busy) continue;
+
+    // busyでないslotにはワーカースレッドが触れないので, ロックを外さずに書き換えてよい
+    s->req = r;
+    s->world.field(world_.field());
+    s->busy       = true;
+    s->generation = generation_;
+    ++pending_;
+    pool_.post([this, &s = *s] { run(s); });
+  }
+
+  done_.wait_until(lock, _deadline, [this] { return pending_ == 0; });
+
+  std::vector<result> results;
+  results.reserve(_requests.size());
+  for (const auto& r : _requests) {
+    const auto& s = *slots_[r.id];
+    if (s.generation == generation_) {
+      if (!s.busy) {
+        results.push_back({r.id, s.target, true, s.iterations});
+        continue;
+      }
+      ++timeouts_;
+    }
+    results.push_back(
+        {r.id, s.planned ? s.target : position{r.start.x, r.start.y, r.goal.theta}, false, 0});
+  }
+  return results;
+}
+
+std::size_t service::timeouts() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return timeouts_;
+}
+
+void service::run(slot& _slot) {
+  // busyの間は_slotをこのスレッドだけが使う
+  bool succeeded = false;
+  position target{};
+  try {
+    const auto& r = _slot.req;
+    _slot.planner.obstacles(r.obstacles);
+    _slot.planner.robotSpeed(r.robotSpeed);
+    _slot.planner.search(r.start, r.goal, r.searchNum, r.maxBranchLength, r.margin);
+    target    = _slot.planner.target();
+    succeeded = true;
+  } catch (...) {
+    // 計画に失敗したら前回の結果を使い続ける
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (succeeded) {
+    _slot.target     = target;
+    _slot.iterations = _slot.planner.iterations();
+    _slot.planned    = true;
+  }
+  _slot.busy = false;
+  if (_slot.generation == generation_ && --pending_ == 0) done_.notify_all();
+}
+
+} // namespace planner
+} // namespace ai
@@ -0,0 +1,108 @@
+#ifndef AI_PLANNER_SERVICE_HPP_
+#define AI_PLANNER_SERVICE_HPP_
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+#include "ai/model/world.hpp"
+#include "ai/planner/rrt.hpp"
+#include "ai/util/threadPool.hpp"
+#include "ai/util/time.hpp"
+
+namespace ai {
+namespace planner {
+
+/// @class   service
+/// @brief   複数のロボットの経路計画をワーカースレッドで並列に行う
+///
+/// 制御周期ごとに全ロボットの要求をまとめてplan()に渡すと, 期限までに得られた目標位置を返す.
+/// 期限に間に合わなかったロボットには前回の計画結果が返され,
+/// 間に合わなかった計画はそのまま続けられて次回以降の結果に反映される.
+/// ロボットごとにrrtを持ち続けるので, 前回の経路をもとにした探索が行われる
+class service {
+public:
+  /// 経路計画の要求
+  struct request {
+    uint32_t id;                          // ロボットのID
+    position start;                       // 初期位置
+    position goal;                        // 目標位置
+    std::vector<rrt::obstacle> obstacles; // 障害物
+    uint32_t searchNum     = 100;         // 探索を行う回数
+    double maxBranchLength = 300.0;       // 伸ばす枝の最大距離
+    double margin          = 150.0;       // 避けるときのマージン
+    double robotSpeed      = 0.0;         // 枝を辿る速さ, 正なら障害物の速度を考慮する
+  };
+
+  /// 経路計画の結果
+  struct result {
+    uint32_t id;         // ロボットのID
+    position target;     // 次に向かう位置
+    bool updated;        // 今回の要求に対する結果か (falseなら前回の結果)
+    uint32_t iterations; // 今回の計画で木を伸ばした回数 (updatedがfalseなら0)
+  };
+
+  /// @param world     WorldModelの参照 (フィールドの情報のみ使用する)
+  /// @param threads   ワーカースレッドの数
+  explicit service(const model::world& _world,
+                   std::size_t _threads = std::thread::hardware_concurrency());
+
+  /// @brief           実行中の計画が全て終わるまで待つ
+  ~service() = default;
+
+  /// @brief           要求をまとめて計画し, 期限までに得られた結果を返す
+  /// @param requests  各ロボットの要求 (IDはmodel::world::maxRobots未満でなければならない)
+  /// @param deadline  結果を返す期限
+  /// @return          requestsと同じ順に並んだ結果
+  ///
+  /// 前回の計画がまだ終わっていないロボットの要求は無視される.
+  /// 一度も計画が終わっていないロボットには, 初期位置に目標の向きを合わせたものを返す
+  std::vector<result> plan(const std::vector<request>& _requests,
+                           util::TimePointType _deadline);
+
+  /// @brief           期限に間に合わなかった計画の数の累計を返す
+  std::size_t timeouts() const;
+
+private:
+  /// ロボット1台分の状態
+  struct slot {
+    /// @param field     フィールドの情報 (rrtが固定障害物を決めるのに使う)
+    explicit slot(const model::field& _field);
+
+    model::world world;  // rrtに渡すWorldModel (フィールドの情報のみ更新する)
+    rrt planner;         // このロボット専用のrrt
+    request req;         // 計画中の要求
+    position target;     // 最後に終わった計画の結果
+    uint32_t iterations; // 最後に終わった計画で木を伸ばした回数
+    bool planned;        // 一度でも計画が終わったか
+    bool busy;           // 計画中か
+    uint64_t generation; // 計画を始めたときのgeneration_
+  };
+
+  /// @brief           ワーカースレッドで1台分の計画を行う
+  void run(slot& _slot);
+
+  const model::world& world_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable done_;
+  /// plan()が呼ばれるたびに増える番号
+  uint64_t generation_;
+  /// 今回のplan()で終わっていない計画の数
+  std::size_t pending_;
+  std::size_t timeouts_;
+
+  std::array<std::unique_ptr<slot>, model::world::maxRobots> slots_;
+  /// slots_より先に破棄して, 実行中の計画が終わるのを待つ
+  util::threadPool pool_;
+};
+
+} // namespace planner
+} // namespace ai
+
+#endif // AI_PLANNER_SERVICE_HPP_
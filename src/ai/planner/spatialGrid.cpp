@@ -0,0 +1,87 @@
+#include <cmath>
+#include <limits>
+
+#include "spatialGrid.hpp"
+
+namespace ai {
+namespace planner {
+
+spatialGrid::spatialGrid(double _minX, double _minY, double _maxX, double _maxY,
+                         double _cellSize) {
+  reset(_minX, _minY, _maxX, _maxY, _cellSize);
+}
+
+void spatialGrid::reset(double _minX, double _minY, double _maxX, double _maxY,
+                        double _cellSize) {
+  minX_     = _minX;
+  minY_     = _minY;
+  cellSize_ = _cellSize;
+  nx_       = std::max(1, static_cast<int32_t>(std::ceil((_maxX - _minX) / _cellSize)));
+  ny_       = std::max(1, static_cast<int32_t>(std::ceil((_maxY - _minY) / _cellSize)));
+  heads_.assign(nx_ * ny_, -1);
+  entries_.clear();
+}
+
+void spatialGrid::clear() {
+  std::fill(heads_.begin(), heads_.end(), -1);
+  entries_.clear();
+}
+
+void spatialGrid::reserve(std::size_t _n) {
+  entries_.reserve(_n);
+}
+
+void spatialGrid::insert(uint32_t _index, double _x, double _y) {
+  auto& head = heads_[cellY(_y) * nx_ + cellX(_x)];
+  entries_.push_back({_x, _y, _index, head});
+  head = static_cast<int32_t>(entries_.size() - 1);
+}
+
+std::size_t spatialGrid::size() const {
+  return entries_.size();
+}
+
+std::optional<uint32_t> spatialGrid::nearest(double _x, double _y) const {
+  return nearest(_x, _y, [](uint32_t, double) { return true; });
+}
+
+void spatialGrid::within(double _x, double _y, double _r,
+                         std::vector<uint32_t>& _result) const {
+  const auto x0 = cellX(_x - _r);
+  const auto x1 = cellX(_x + _r);
+  const auto y0 = cellY(_y - _r);
+  const auto y1 = cellY(_y + _r);
+  const auto r2 = _r * _r;
+  for (auto cy = y0; cy <= y1; ++cy) {
+    for (auto cx = x0; cx <= x1; ++cx) {
+      for (auto i = heads_[cy * nx_ + cx]; i >= 0; i = entries_[i].next) {
+        const auto& e = entries_[i];
+        const auto dx = e.x - _x;
+        const auto dy = e.y - _y;
+        if (dx * dx + dy * dy <= r2) _result.push_back(e.index);
+      }
+    }
+  }
+}
+
+int32_t spatialGrid::cellX(double _x) const {
+  const auto c = std::floor((_x - minX_) / cellSize_);
+  return static_cast<int32_t>(std::clamp(c, 0.0, static_cast<double>(nx_ - 1)));
+}
+
+int32_t spatialGrid::cellY(double _y) const {
+  const auto c = std::floor((_y - minY_) / cellSize_);
+  return static_cast<int32_t>(std::clamp(c, 0.0, static_cast<double>(ny_ - 1)));
+}
+
+void spatialGrid::collect(int32_t _cx, int32_t _cy, double _x, double _y) const {
+  const std::greater<candidate> cmp{};
+  for (auto i = heads_[_cy * nx_ + _cx]; i >= 0; i = entries_[i].next) {
+    const auto& e = entries_[i];
+    candidates_.push_back({std::hypot(e.x - _x, e.y - _y), e.index});
+    std::push_heap(candidates_.begin(), candidates_.end(), cmp);
+  }
+}
+
+} // namespace planner
+} // namespace ai
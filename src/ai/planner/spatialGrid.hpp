@@ -0,0 +1,155 @@
+#ifndef AI_PLANNER_SPATIAL_GRID_HPP_
+#define AI_PLANNER_SPATIAL_GRID_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <vector>
+#include <stdint.h>
+
+namespace ai {
+namespace planner {
+
+/// @class   spatialGrid
+/// @brief   平面上の点を一様な格子で管理し, 近傍探索を行う
+///
+/// 点は1つずつ追加でき, 追加した点に対して以下の問い合わせができる.
+/// - 条件を満たす点のうち, 最も近いもの
+/// - 指定した半径の内側にある全ての点
+/// 範囲外の点は端のセルに入れられるので, 範囲はおおよそで構わない.
+/// clear()はメモリを解放しないので, 探索のたびに作り直しても動的なメモリ確保は起こらない
+class spatialGrid {
+public:
+  /// @param minX      範囲のx座標の最小値
+  /// @param minY      範囲のy座標の最小値
+  /// @param maxX      範囲のx座標の最大値
+  /// @param maxY      範囲のy座標の最大値
+  /// @param cellSize  セルの一辺の長さ
+  spatialGrid(double _minX = 0, double _minY = 0, double _maxX = 1, double _maxY = 1,
+              double _cellSize = 1);
+
+  /// @brief           範囲とセルの大きさを変更し, 全ての点を削除する
+  void reset(double _minX, double _minY, double _maxX, double _maxY, double _cellSize);
+
+  /// @brief           全ての点を削除する
+  void clear();
+
+  /// @brief           点n個分の領域をあらかじめ確保する
+  void reserve(std::size_t _n);
+
+  /// @brief           点を追加する
+  /// @param index     点に対応付ける番号 (問い合わせの結果として返される)
+  /// @param x         x座標
+  /// @param y         y座標
+  void insert(uint32_t _index, double _x, double _y);
+
+  /// @brief           追加された点の数を返す
+  std::size_t size() const;
+
+  /// @brief           条件を満たす点のうち, (x, y)に最も近いものを探す
+  /// @param x         x座標
+  /// @param y         y座標
+  /// @param pred      点の番号と距離を受け取り, 条件を満たすときtrueを返す関数
+  /// @return          見つかった点の番号
+  ///
+  /// predは近い点から順に, 条件を満たす点が見つかるまで呼び出される
+  template <class Pred>
+  std::optional<uint32_t> nearest(double _x, double _y, Pred&& _pred) const;
+
+  /// @brief           (x, y)に最も近い点を探す
+  std::optional<uint32_t> nearest(double _x, double _y) const;
+
+  /// @brief           (x, y)から半径r以内にある全ての点を探す
+  /// @param x         x座標
+  /// @param y         y座標
+  /// @param r         半径
+  /// @param result    見つかった点の番号を追加するvector
+  void within(double _x, double _y, double _r, std::vector<uint32_t>& _result) const;
+
+private:
+  /// 追加された点
+  struct entry {
+    double x;
+    double y;
+    uint32_t index;
+    /// 同じセルに入っている次の点 (なければ-1)
+    int32_t next;
+  };
+
+  /// 探索中の候補
+  struct candidate {
+    double dist;
+    uint32_t index;
+
+    bool operator>(const candidate& _rhs) const {
+      return dist > _rhs.dist;
+    }
+  };
+
+  int32_t cellX(double _x) const;
+  int32_t cellY(double _y) const;
+
+  /// @brief           セル(cx, cy)に入っている点を候補に加える
+  void collect(int32_t _cx, int32_t _cy, double _x, double _y) const;
+
+  double minX_;
+  double minY_;
+  double cellSize_;
+  int32_t nx_;
+  int32_t ny_;
+
+  /// 各セルに最後に追加された点 (なければ-1)
+  std::vector<int32_t> heads_;
+  std::vector<entry> entries_;
+
+  /// nearest()で使う候補のヒープ (探索のたびに確保しないように持っておく)
+  mutable std::vector<candidate> candidates_;
+};
+
+template <class Pred>
+std::optional<uint32_t> spatialGrid::nearest(double _x, double _y, Pred&& _pred) const {
+  candidates_.clear();
+  if (entries_.empty()) return std::nullopt;
+
+  const auto qx   = cellX(_x);
+  const auto qy   = cellY(_y);
+  const auto maxK = std::max({qx, nx_ - 1 - qx, qy, ny_ - 1 - qy});
+  const std::greater<candidate> cmp{};
+
+  for (auto k = 0; k <= maxK + 1; ++k) {
+    if (k <= maxK) {
+      // (qx, qy)からチェビシェフ距離がkのセルを走査する
+      const auto x0 = std::max(qx - k, 0);
+      const auto x1 = std::min(qx + k, nx_ - 1);
+      for (auto cy : {qy - k, qy + k}) {
+        if (cy < 0 || cy >= ny_) continue;
+        for (auto cx = x0; cx <= x1; ++cx) collect(cx, cy, _x, _y);
+        if (k == 0) break;
+      }
+      const auto y0 = std::max(qy - k + 1, 0);
+      const auto y1 = std::min(qy + k - 1, ny_ - 1);
+      for (auto cx : {qx - k, qx + k}) {
+        if (k == 0 || cx < 0 || cx >= nx_) continue;
+        for (auto cy = y0; cy <= y1; ++cy) collect(cx, cy, _x, _y);
+      }
+    }
+
+    // まだ走査していないセルの点はk * cellSize_より遠いので,
+    // それより近い候補は距離の順に確定できる
+    const auto bound = k <= maxK ? k * cellSize_ : std::numeric_limits<double>::infinity();
+    while (!candidates_.empty() && candidates_.front().dist <= bound) {
+      std::pop_heap(candidates_.begin(), candidates_.end(), cmp);
+      const auto c = candidates_.back();
+      candidates_.pop_back();
+      if (_pred(c.index, c.dist)) return c.index;
+    }
+  }
+  return std::nullopt;
+}
+
+} // namespace planner
+} // namespace ai
+
+#endif // AI_PLANNER_SPATIAL_GRID_HPP_
@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#include "ai/planner/trajectory.hpp"
+#include "ai/util/math/angle.hpp"
+
+namespace ai {
+namespace planner {
+
+trajectory::trajectory() : aMax_(0.0), goal_{0.0, 0.0, 0.0}, duration_(0.0), length_(0.0) {}
+
+trajectory::trajectory(const std::vector<position>& _path, const limits& _limits, double _v0)
+    : aMax_(_limits.aMax), goal_{0.0, 0.0, 0.0}, duration_(0.0), length_(0.0) {
+  if (_path.empty()) return;
+  goal_ = _path.back();
+
+  // 同じ位置が続く経由点は1つにまとめて区間を作る
+  auto from = _path.front();
+  for (auto i = 1u; i < _path.size(); ++i) {
+    const auto dx = _path[i].x - from.x;
+    const auto dy = _path[i].y - from.y;
+    const auto l  = std::hypot(dx, dy);
+    if (l == 0.0) continue;
+    segments_.push_back(segment{from, dx / l, dy / l, l, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0});
+    from = _path[i];
+  }
+  if (segments_.empty()) return;
+
+  // 各経由点を通る速さの上限 (vs[i]は区間iの始点, 最後は目標位置)
+  const auto n = segments_.size();
+  std::vector<double> vs(n + 1, 0.0);
+  vs[0] = std::clamp(_v0, 0.0, _limits.vMax);
+  for (auto i = 1u; i < n; ++i) {
+    // 曲がる角度が大きいほど遅くする
+    const auto& a = segments_[i - 1];
+    const auto& b = segments_[i];
+    vs[i]         = _limits.vMax * std::max(a.ux * b.ux + a.uy * b.uy, 0.0);
+  }
+  // 前の経由点から加速して届く速さと, 次の経由点までに減速しきれる速さに抑える
+  for (auto i = 0u; i < n; ++i) {
+    vs[i + 1] = std::min(vs[i + 1], std::sqrt(vs[i] * vs[i] + 2 * aMax_ * segments_[i].length));
+  }
+  for (auto i = n; i-- > 0;) {
+    vs[i] = std::min(vs[i], std::sqrt(vs[i + 1] * vs[i + 1] + 2 * aMax_ * segments_[i].length));
+  }
+
+  // 各区間の速さを台形にする (等速で進む距離が無ければ三角形になる)
+  for (auto i = 0u; i < n; ++i) {
+    auto& s          = segments_[i];
+    const auto v0    = vs[i];
+    const auto v1    = vs[i + 1];
+    const auto reach = std::sqrt((2 * aMax_ * s.length + v0 * v0 + v1 * v1) / 2);
+
+    s.start = duration_;
+    s.v0    = v0;
+    s.peak  = std::min(_limits.vMax, reach);
+    s.ta    = (s.peak - v0) / aMax_;
+    s.td    = (s.peak - v1) / aMax_;
+    // 加速と減速で進む距離の残りを等速で進む
+    const auto da = (s.peak * s.peak - v0 * v0) / (2 * aMax_);
+    const auto dd = (s.peak * s.peak - v1 * v1) / (2 * aMax_);
+    s.tc          = s.peak > 0.0 ? std::max(s.length - da - dd, 0.0) / s.peak : 0.0;
+    duration_ += s.ta + s.tc + s.td;
+    length_ += s.length;
+  }
+}
+
+bool trajectory::empty() const {
+  return segments_.empty();
+}
+
+double trajectory::duration() const {
+  return duration_;
+}
+
+double trajectory::length() const {
+  return length_;
+}
+
+trajectory::state trajectory::sample(double _t) const {
+  if (segments_.empty() || _t >= duration_) return state{goal_, velocity{0.0, 0.0, 0.0}};
+  _t = std::max(_t, 0.0);
+
+  // 時刻tを含む区間を探す
+  const auto it =
+      std::upper_bound(segments_.begin(), segments_.end(), _t,
+                       [](double _time, const segment& _s) { return _time < _s.start; });
+  const auto& s = *std::prev(it);
+
+  const auto t = _t - s.start;
+  double d, v;
+  if (t < s.ta) {
+    d = s.v0 * t + aMax_ * t * t / 2;
+    v = s.v0 + aMax_ * t;
+  } else if (t < s.ta + s.tc) {
+    d = (s.v0 + s.peak) * s.ta / 2 + s.peak * (t - s.ta);
+    v = s.peak;
+  } else {
+    const auto td = std::min(t - s.ta - s.tc, s.td);
+    d = (s.v0 + s.peak) * s.ta / 2 + s.peak * s.tc + s.peak * td - aMax_ * td * td / 2;
+    v = s.peak - aMax_ * td;
+  }
+  d = std::min(d, s.length);
+
+  return state{position{s.from.x + s.ux * d, s.from.y + s.uy * d, goal_.theta},
+               velocity{s.ux * v, s.uy * v, 0.0}};
+}
+
+velocity trajectory::follow(const position& _current, double _t, double _gain) const {
+  const auto s = sample(_t);
+  return velocity{s.velocity_.vx + _gain * (s.position_.x - _current.x),
+                  s.velocity_.vy + _gain * (s.position_.y - _current.y),
+                  _gain * util::math::wrapToPi(s.position_.theta - _current.theta)};
+}
+
+} // namespace planner
+} // namespace ai
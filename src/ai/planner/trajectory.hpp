@@ -0,0 +1,88 @@
+#ifndef AI_PLANNER_TRAJECTORY_HPP_
+#define AI_PLANNER_TRAJECTORY_HPP_
+
+#include <vector>
+
+#include "ai/planner/base.hpp"
+
+namespace ai {
+namespace planner {
+
+/// @class   trajectory
+/// @brief   経由点を結ぶ経路を, 速度と加速度の上限の下でできるだけ早く辿る軌道
+///
+/// 経由点の間は直線で結び, 各区間の速さは加速・等速・減速の台形とする.
+/// 経由点では曲がる角度に応じて速さを落とし, 90度以上曲がるときは一度止まる.
+/// 作った後は変更されないので, 任意の時刻の状態を何度でも取り出せる
+class trajectory {
+public:
+  /// 速度と加速度の上限
+  struct limits {
+    double vMax; // 最大速度[mm/s]
+    double aMax; // 最大加速度[mm/s^2]
+  };
+
+  /// ある時刻の状態
+  struct state {
+    position position_; // 位置 (角度は最後の経由点のもの)
+    velocity velocity_; // 速度 (角速度は常に0)
+  };
+
+  /// @brief           長さ0の軌道を作る
+  trajectory();
+
+  /// @param path      経由点 (最初の点が初期位置, 最後の点が目標位置)
+  /// @param limits    速度と加速度の上限
+  /// @param v0        最初の区間の向きの初速[mm/s]
+  ///
+  /// 初速が大きすぎて最初の経由点で止まりきれないときは, 止まれる速さまで落とす
+  trajectory(const std::vector<position>& _path, const limits& _limits, double _v0 = 0.0);
+
+  /// @brief           経由点が2つ未満か
+  bool empty() const;
+
+  /// @brief           目標位置に着くまでの時間[s]
+  double duration() const;
+
+  /// @brief           経路の長さ[mm]
+  double length() const;
+
+  /// @brief           時刻tの状態を求める
+  /// @param t         軌道の開始からの時間[s] (範囲外なら始点か終点の状態)
+  state sample(double _t) const;
+
+  /// @brief           時刻tの状態へ追従するための速度指令を求める
+  /// @param current   現在の位置
+  /// @param t         軌道の開始からの時間[s]
+  /// @param gain      位置の偏差に掛けるゲイン[1/s]
+  ///
+  /// 軌道の速度をフィードフォワードとし, 位置と角度の偏差に比例する分を加える.
+  /// 戻り値はフィールド座標系の速度で, そのままcommand::vel()に渡せる
+  velocity follow(const position& _current, double _t, double _gain = 2.0) const;
+
+private:
+  /// 経由点の間の区間
+  struct segment {
+    position from; // 始点
+    double ux;     // 進む向きの単位ベクトル
+    double uy;
+    double length; // 長さ
+    double start;  // 始点を通る時刻
+    double v0;     // 始点での速さ
+    double peak;   // 最高速度
+    double ta;     // 加速する時間
+    double tc;     // 等速で進む時間
+    double td;     // 減速する時間
+  };
+
+  double aMax_;
+  position goal_;
+  double duration_;
+  double length_;
+  std::vector<segment> segments_;
+};
+
+} // namespace planner
+} // namespace ai
+
+#endif // AI_PLANNER_TRAJECTORY_HPP_
@@ -5,12 +5,18 @@ namespace ai {
 namespace receiver {
 
 refbox::refbox(boost::asio::io_service& _ioService, const std::string& _listenAddr,
-               const std::string& _multicastAddr, uint16_t _port)
-    : receiver_(_ioService, _listenAddr, _multicastAddr, _port) {
+               const std::string& _multicastAddr, uint16_t _port,
+               util::multicast::receiver::receiveMode _mode)
+    : receiver_(_ioService, _listenAddr, _multicastAddr, _port, _mode) {
   GOOGLE_PROTOBUF_VERIFY_VERSION;
 
-  receiver_.onReceive(
-      std::bind(&refbox::parsePacket, this, std::placeholders::_1, std::placeholders::_2));
+  receiver_.onReceive([this](const util::multicast::receiver::Buffer& _buffer,
+                             std::size_t _size) { parsePacket(_buffer.data(), _size); });
+  receiver_.onReceiveBatch([this](const util::multicast::receiver::BatchType& _batch) {
+    for (const auto& b : _batch) {
+      parsePacket(boost::asio::buffer_cast<const void*>(b), boost::asio::buffer_size(b));
+    }
+  });
 }
 
 boost::signals2::connection refbox::onReceive(const ReceiveSignalType::slot_type& _slot) {
@@ -21,10 +27,14 @@ boost::signals2::connection refbox::onError(const ErrorSignalType::slot_type& _s
   return errored_.connect(_slot);
 }
 
-void refbox::parsePacket(const util::multicast::receiver::Buffer& _buffer, std::size_t _size) {
+util::multicast::receiver::statistics refbox::stats() const {
+  return receiver_.stats();
+}
+
+void refbox::parsePacket(const void* _data, std::size_t _size) {
   ssl_protos::refbox::Referee packet;
 
-  if (packet.ParseFromArray(_buffer.data(), _size)) {
+  if (packet.ParseFromArray(_data, static_cast<int>(_size))) {
     received_(packet);
   } else {
     errored_();
@@ -21,12 +21,15 @@ class refbox {
 
 public:
   refbox(boost::asio::io_service& _ioService, const std::string& _listenAddr,
-         const std::string& _multicastAddr, uint16_t _port);
+         const std::string& _multicastAddr, uint16_t _port,
+         util::multicast::receiver::receiveMode _mode =
+             util::multicast::receiver::receiveMode::single);
   boost::signals2::connection onReceive(const ReceiveSignalType::slot_type& _slot);
   boost::signals2::connection onError(const ErrorSignalType::slot_type& _slot);
+  util::multicast::receiver::statistics stats() const;
 
 private:
-  void parsePacket(const util::multicast::receiver::Buffer& _buffer, std::size_t _size);
+  void parsePacket(const void* _data, std::size_t _size);
   util::multicast::receiver receiver_;
 
   ReceiveSignalType received_;
@@ -5,15 +5,23 @@ namespace ai {
 namespace receiver {
 
 vision::vision(boost::asio::io_service& _ioService, const std::string& _listenAddr,
-               const std::string& _multicastAddr, uint16_t _port)
-    : receiver_(_ioService, _listenAddr, _multicastAddr, _port) {
+               const std::string& _multicastAddr, uint16_t _port,
+               util::multicast::receiver::receiveMode _mode)
+    : packets_(initialPoolSize_),
+      receiver_(_ioService, _listenAddr, _multicastAddr, _port, _mode) {
   // Google Protocol Buffersライブラリのバージョンをチェックする
   // 互換性のないバージョンが使われていた場合は例外吐いて落ちる()
   GOOGLE_PROTOBUF_VERIFY_VERSION;
 
   // multicastクライアントとparse_packet()をつなげる
-  receiver_.onReceive(
-      std::bind(&vision::parsePacket, this, std::placeholders::_1, std::placeholders::_2));
+  receiver_.onReceive([this](const util::multicast::receiver::Buffer& _buffer,
+                             std::size_t _size) { parsePacket(_buffer.data(), _size); });
+  // まとめて受信したものは順番にパースする
+  receiver_.onReceiveBatch([this](const util::multicast::receiver::BatchType& _batch) {
+    for (const auto& b : _batch) {
+      parsePacket(boost::asio::buffer_cast<const void*>(b), boost::asio::buffer_size(b));
+    }
+  });
 }
 
 boost::signals2::connection vision::onReceive(const ReceiveSignalType::slot_type& _slot) {
@@ -24,13 +32,20 @@ boost::signals2::connection vision::onError(const ErrorSignalType::slot_type& _s
   return errored_.connect(_slot);
 }
 
-void vision::parsePacket(const util::multicast::receiver::Buffer& _buffer, std::size_t _size) {
-  ssl_protos::vision::WrapperPacket packet;
+util::multicast::receiver::statistics vision::stats() const {
+  return receiver_.stats();
+}
+
+void vision::parsePacket(const void* _data, std::size_t _size) {
+  // 使われていないパケットを取得する
+  // protobufのメッセージはClearされても確保した領域を保持しているので,
+  // 使い回されたパケットへのパースでは (ほとんど) メモリ確保が起こらない
+  auto packet = packets_.acquire();
 
   // パケットをパース
-  if (packet.ParseFromArray(_buffer.data(), _size)) {
+  if (packet->ParseFromArray(_data, static_cast<int>(_size))) {
     // 成功したら登録された関数を呼び出す
-    received_(packet);
+    received_(PacketType{std::move(packet)});
   } else {
     errored_();
   }
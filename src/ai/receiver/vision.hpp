@@ -1,12 +1,14 @@
 #ifndef AI_RECEIVER_VISION_HPP_
 #define AI_RECEIVER_VISION_HPP_
 
+#include <memory>
 #include <string>
 #include <stdint.h>
 #include <boost/asio.hpp>
 #include <boost/signals2.hpp>
 
 #include "ai/util/multicast/receiver.hpp"
+#include "ai/util/pool.hpp"
 
 #include "ssl-protos/vision/wrapper.pb.h"
 
@@ -16,9 +18,15 @@ namespace receiver {
 /// @class   vision
 /// @brief   SSL-Visionからデータを受信するクラス
 class vision {
+public:
+  /// 受信したパケットの型
+  ///
+  /// パケットは使い回されるので, 参照を保持している間だけ値が変わらないことが保証される
+  using PacketType = std::shared_ptr<const ssl_protos::vision::WrapperPacket>;
+
+private:
   // データ受信時に呼ぶシグナルの型
-  using ReceiveSignalType =
-      boost::signals2::signal<void(const ssl_protos::vision::WrapperPacket&)>;
+  using ReceiveSignalType = boost::signals2::signal<void(const PacketType&)>;
   // エラー時に呼ぶシグナルの型
   using ErrorSignalType = boost::signals2::signal<void(void)>;
 
@@ -27,8 +35,13 @@ public:
   /// @param listen_addr      通信に使うインターフェースのIPアドレス
   /// @param multicast_addr   マルチキャストアドレス
   /// @param port             ポート
+  /// @param mode             受信の方式
+  ///
+  /// batchで受信した場合も, パースしたパケットは1つずつonReceiveに登録された関数に渡される
   vision(boost::asio::io_service& _ioService, const std::string& _listenAddr,
-         const std::string& _multicastAddr, uint16_t _port);
+         const std::string& _multicastAddr, uint16_t _port,
+         util::multicast::receiver::receiveMode _mode =
+             util::multicast::receiver::receiveMode::single);
 
   /// @brief                  データ受信時に slot が呼ばれるようにする
   /// @param slot             データ受信時に呼びたい関数オブジェクト
@@ -38,12 +51,23 @@ public:
   /// @param slot             エラー時に呼びたい関数オブジェクト
   boost::signals2::connection onError(const ErrorSignalType::slot_type& _slot);
 
+  /// @brief                  受信に関する統計を取得する
+  util::multicast::receiver::statistics stats() const;
+
 private:
-  void parsePacket(const util::multicast::receiver::Buffer& _buffer, std::size_t _size);
+  /// パケットのプールの初期サイズ
+  /// (updaterがカメラの台数分のパケットを保持することを想定している)
+  static constexpr std::size_t initialPoolSize_ = 16;
+
+  void parsePacket(const void* _data, std::size_t _size);
 
   ReceiveSignalType received_;
   ErrorSignalType errored_;
 
+  /// パース先のパケットのプール
+  /// パケットを使い回すことで, 受信のたびにメッセージを確保しないようにしている
+  util::pool<ssl_protos::vision::WrapperPacket> packets_;
+
   util::multicast::receiver receiver_;
 };
 
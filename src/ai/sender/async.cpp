@@ -0,0 +1,123 @@
+#include <algorithm>
+
+#include "async.hpp"
+
+namespace ai {
+namespace sender {
+
+async::async(std::shared_ptr<base> _sender, std::size_t _capacity)
+    : sender_(std::move(_sender)),
+      queue_(_capacity),
+      waiting_(false),
+      stopping_(false),
+      batches_(0),
+      dropped_(0),
+      thread_([this] { run(); }) {}
+
+async::~async() {
+  stopping_ = true;
+  {
+    std::lock_guard<std::mutex> lock(wakeMutex_);
+    wake_.notify_one();
+  }
+  thread_.join();
+}
+
+void async::sendCommand(const model::command& _command) {
+  incoming_.commands.clear();
+  incoming_.commands.push_back(_command);
+  enqueue();
+}
+
+void async::sendCommands(const std::vector<model::command>& _commands) {
+  // コピー代入なので, incoming_.commandsが十分大きければメモリ確保は起きない
+  incoming_.commands = _commands;
+  enqueue();
+}
+
+async::metrics async::statistics() const {
+  std::lock_guard<std::mutex> lock(metricsMutex_);
+  auto result    = metrics_;
+  result.batches = batches_;
+  result.dropped = dropped_;
+  result.depth   = queue_.size();
+  return result;
+}
+
+void async::enqueue() {
+  incoming_.enqueued = ClockType::now();
+  ++batches_;
+  if (!queue_.tryPush(incoming_)) {
+    // 送信するスレッドがキューを空にできないほど遅れているので, この周期の命令は諦める
+    ++dropped_;
+    return;
+  }
+
+  // 送信するスレッドがwaiting_を立ててからキューを確かめるのと対になる
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waiting_.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(wakeMutex_);
+    wake_.notify_one();
+  }
+}
+
+void async::run() {
+  while (true) {
+    if (flush()) continue;
+    // 止めるときは, キューに残っている命令を送り終えてから抜ける
+    if (stopping_) {
+      if (flush()) continue;
+      return;
+    }
+
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    waiting_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // 知らせを取りこぼしても, 一定時間ごとにキューを確かめる
+    wake_.wait_for(lock, std::chrono::milliseconds(100),
+                   [this] { return !queue_.empty() || stopping_; });
+    waiting_.store(false, std::memory_order_relaxed);
+  }
+}
+
+bool async::flush() {
+  merged_.clear();
+  enqueued_.clear();
+  uint64_t coalesced = 0;
+
+  // キューに溜まっている周期を全て取り出し, 新しい命令で古い命令を上書きする
+  while (queue_.tryPop(outgoing_)) {
+    enqueued_.push_back(outgoing_.enqueued);
+    for (const auto& command : outgoing_.commands) {
+      const auto it = std::find_if(merged_.begin(), merged_.end(), [&command](const auto& _c) {
+        return _c.id() == command.id();
+      });
+      if (it == merged_.end()) {
+        merged_.push_back(command);
+      } else {
+        *it = command;
+        ++coalesced;
+      }
+    }
+  }
+  if (enqueued_.empty()) return false;
+
+  auto error = false;
+  try {
+    if (!merged_.empty()) sender_->sendCommands(merged_);
+  } catch (...) {
+    error = true;
+  }
+  const auto now = ClockType::now();
+
+  std::lock_guard<std::mutex> lock(metricsMutex_);
+  ++metrics_.transmissions;
+  metrics_.coalesced += coalesced;
+  metrics_.errors += error;
+  metrics_.maxDepth = std::max(metrics_.maxDepth, enqueued_.size());
+  for (const auto& t : enqueued_) metrics_.latency.record(now - t);
+  return true;
+}
+
+} // namespace sender
+} // namespace ai
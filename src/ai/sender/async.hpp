@@ -0,0 +1,110 @@
+#ifndef AI_SENDER_ASYNC_HPP_
+#define AI_SENDER_ASYNC_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+#include "ai/model/command.hpp"
+#include "ai/util/histogram.hpp"
+#include "ai/util/spscQueue.hpp"
+
+#include "base.hpp"
+
+namespace ai {
+namespace sender {
+
+/// @class   async
+/// @brief   別のSenderでの送信を専用のスレッドで行い, 呼び出し側を待たせないSender
+///
+/// sendCommand()やsendCommands()は命令をキューに入れるだけで戻り,
+/// 専用のスレッドがキューから取り出してラップしたSenderで送信する.
+/// 送信が遅れてキューに複数の周期の命令が溜まったときは, ロボットごとに最新の命令だけを送る.
+///
+/// sendCommand()とsendCommands()は, 同時に複数のスレッドから呼び出してはならない
+class async final : public base {
+public:
+  /// 送信の統計
+  struct metrics {
+    uint64_t batches{0};       // 受け付けた周期の数
+    uint64_t transmissions{0}; // ラップしたSenderで送信した回数
+    uint64_t dropped{0};       // キューが一杯で捨てた周期の数
+    uint64_t coalesced{0};     // 同じロボットへの新しい命令があったため送らなかった命令の数
+    uint64_t errors{0};        // ラップしたSenderが例外を投げた回数
+    std::size_t depth{0};      // 今キューに入っている周期の数
+    std::size_t maxDepth{0};   // 1回の送信でまとめた周期の数の最大値
+    util::histogram latency;   // キューに入れてから送信し終えるまでの時間
+  };
+
+  /// @param sender    実際に送信するSender
+  /// @param capacity  キューに入れられる周期の数
+  explicit async(std::shared_ptr<base> _sender, std::size_t _capacity = 8);
+
+  async(const async&) = delete;
+  async& operator=(const async&) = delete;
+
+  /// @brief           キューに残っている命令を全て送信してからスレッドを止める
+  ~async();
+
+  void sendCommand(const model::command& _command) override;
+
+  void sendCommands(const std::vector<model::command>& _commands) override;
+
+  /// @brief           送信の統計を取得する
+  metrics statistics() const;
+
+private:
+  using ClockType = std::chrono::steady_clock;
+
+  /// キューに入れる1周期分の命令
+  struct batch {
+    ClockType::time_point enqueued;
+    std::vector<model::command> commands;
+  };
+
+  /// @brief           incoming_をキューに入れ, 眠っている送信するスレッドを起こす
+  void enqueue();
+
+  /// @brief           送信するスレッドの処理
+  void run();
+
+  /// @brief           キューに溜まっている命令をロボットごとに最新のものだけにまとめて送る
+  /// @return          キューから1つでも取り出したか
+  bool flush();
+
+  std::shared_ptr<base> sender_;
+  util::spscQueue<batch> queue_;
+
+  /// キューに入れる命令を組み立てる領域 (呼び出し側のスレッドだけが使う)
+  batch incoming_;
+  /// キューから取り出した命令 (送信するスレッドだけが使う)
+  batch outgoing_;
+  /// ロボットごとに最新の命令だけにまとめたもの (送信するスレッドだけが使う)
+  std::vector<model::command> merged_;
+  /// まとめた各周期をキューに入れた時刻 (送信するスレッドだけが使う)
+  std::vector<ClockType::time_point> enqueued_;
+
+  /// 送信するスレッドが眠っているとき, 命令が入ったことを知らせる
+  std::mutex wakeMutex_;
+  std::condition_variable wake_;
+  std::atomic<bool> waiting_;
+  std::atomic<bool> stopping_;
+
+  std::atomic<uint64_t> batches_;
+  std::atomic<uint64_t> dropped_;
+  mutable std::mutex metricsMutex_;
+  /// 送信するスレッドで更新する統計
+  metrics metrics_;
+
+  std::thread thread_;
+};
+
+} // namespace sender
+} // namespace ai
+
+#endif // AI_SENDER_ASYNC_HPP_
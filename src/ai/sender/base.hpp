@@ -1,6 +1,8 @@
 #ifndef AI_SENDER_BASE_HPP_
 #define AI_SENDER_BASE_HPP_
 
+#include <vector>
+
 #include "ai/model/command.hpp"
 
 namespace ai {
@@ -11,6 +13,14 @@ public:
   virtual ~base() = default;
 
   virtual void sendCommand(const model::command& _command) = 0;
+
+  /// @brief           1周期分の複数のロボットへの命令をまとめて送信する
+  /// @param commands  送信する命令
+  ///
+  /// まとめて送れないSenderでは, sendCommand()を1つずつ呼ぶ
+  virtual void sendCommands(const std::vector<model::command>& _commands) {
+    for (const auto& command : _commands) sendCommand(command);
+  }
 };
 
 } // namespace sender
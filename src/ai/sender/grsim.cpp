@@ -1,71 +1,93 @@
-#include <variant>
-#include <ostream>
 #include <tuple>
+#include <variant>
 
 #include "grsim.hpp"
 
 namespace ai {
 namespace sender {
 
+namespace {
+
+/// 送信バッファの初期の大きさ (1チーム分の命令を1つのパケットに入れても足りる大きさ)
+constexpr std::size_t bufferSize = 1024;
+
+} // namespace
+
 grsim::grsim(boost::asio::io_service& _ioService, const std::string& _grsimAddr, uint16_t _port)
-    : udpSender_(_ioService, _grsimAddr, _port) {
+    : udpSender_(_ioService, _grsimAddr, _port), buffer_(bufferSize) {
   //プロトコルバッファのバージョン確認
   GOOGLE_PROTOBUF_VERIFY_VERSION;
 }
 
-void grsim::sendCommand(const model::command& _command) {
-  ssl_protos::grsim::Packet packet{};
+template <class Iterator>
+void grsim::send(Iterator _first, Iterator _last) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Clear()しても繰り返しフィールドの要素の領域は解放されず, 次のadd_で再利用される
+  packet_.Clear();
 
   //パケットに値をセット
-  auto commands = packet.mutable_commands();
+  auto commands = packet_.mutable_commands();
   commands->set_isteamyellow(true);
   commands->set_timestamp(0.0);
 
-  auto grcommand = commands->add_robot_commands();
+  for (auto it = _first; it != _last; ++it) {
+    const auto& command = *it;
+    auto grcommand      = commands->add_robot_commands();
 
-  grcommand->set_id(_command.id());
+    grcommand->set_id(command.id());
 
-  const auto& kickFlag  = std::get<0>(_command.kick());
-  const auto& kickPower = std::get<1>(_command.kick());
+    // kick()は値を返すので, 要素への参照を取らずに一度受け取っておく
+    const auto kick       = command.kick();
+    const auto& kickFlag  = std::get<0>(kick);
+    const auto& kickPower = std::get<1>(kick);
 
-  using kickType = model::command::kickType;
+    using kickType = model::command::kickType;
 
-  if (kickFlag == kickType::Straight) {
-    grcommand->set_kickspeedx(kickPower);
-    grcommand->set_kickspeedz(0);
-  } else if (kickFlag == kickType::Tip) {
-    grcommand->set_kickspeedx(0);
-    grcommand->set_kickspeedz(kickPower);
-  } else {
-    grcommand->set_kickspeedx(0);
-    grcommand->set_kickspeedz(0);
-  }
+    if (kickFlag == kickType::Straight) {
+      grcommand->set_kickspeedx(kickPower);
+      grcommand->set_kickspeedz(0);
+    } else if (kickFlag == kickType::Tip) {
+      grcommand->set_kickspeedx(0);
+      grcommand->set_kickspeedz(kickPower);
+    } else {
+      grcommand->set_kickspeedx(0);
+      grcommand->set_kickspeedz(0);
+    }
+
+    const auto& setpoint = command.setpoint();
+    if (const auto& velocity = std::get_if<model::command::velocity>(&setpoint)) {
+      // velocity_tへのキャストが成功した時
+      grcommand->set_veltangent(velocity->vx / 1000);
+      grcommand->set_velnormal(velocity->vy / 1000);
+      grcommand->set_velangular(velocity->omega);
+    } else {
+      // velocity_tへのキャストが失敗した時
+      grcommand->set_veltangent(0);
+      grcommand->set_velnormal(0);
+      grcommand->set_velangular(0);
+    }
 
-  const auto& setpoint = _command.setpoint();
-  if (const auto& velocity = std::get_if<model::command::velocity>(&setpoint)) {
-    // velocity_tへのキャストが成功した時
-    grcommand->set_veltangent(velocity->vx / 1000);
-    grcommand->set_velnormal(velocity->vy / 1000);
-    grcommand->set_velangular(velocity->omega);
-  } else {
-    // velocity_tへのキャストが失敗した時
-    grcommand->set_veltangent(0);
-    grcommand->set_velnormal(0);
-    grcommand->set_velangular(0);
+    grcommand->set_spinner(command.dribble() != 0);
+    grcommand->set_wheelsspeed(false);
   }
 
-  grcommand->set_spinner(_command.dribble() != 0);
-  grcommand->set_wheelsspeed(false);
+  // packetをシリアライズし, 使い回しているバッファに書き込む
+  // バッファは足りないときだけ大きくする
+  const auto size = packet_.ByteSizeLong();
+  if (buffer_.size() < size) buffer_.resize(size);
+  packet_.SerializeWithCachedSizesToArray(buffer_.data());
 
-  //送信バッファと、それに書き込むstreamクラスのオブジェクトを作成
-  boost::asio::streambuf buf;
-  std::ostream os(&buf);
+  // bufferを1つのデータグラムとして送信
+  udpSender_.send(buffer_.data(), size);
+}
 
-  // packetをシリアライズし、結果をos経由でbufに書き込む
-  packet.SerializeToOstream(&os);
+void grsim::sendCommand(const model::command& _command) {
+  send(&_command, &_command + 1);
+}
 
-  // bufを送信
-  udpSender_.send(buf.data());
+void grsim::sendCommands(const std::vector<model::command>& _commands) {
+  send(_commands.begin(), _commands.end());
 }
 } // namespace sender
 } // namespace ai
@@ -1,7 +1,9 @@
 #ifndef AI_SENDER_GRSIM_HPP_
 #define AI_SENDER_GRSIM_HPP_
 
+#include <mutex>
 #include <string>
+#include <vector>
 #include <boost/asio.hpp>
 #include <stdint.h>
 
@@ -20,8 +22,21 @@ public:
 
   void sendCommand(const model::command& _command) override;
 
+  /// @brief           全てのロボットへの命令を1つのパケットにまとめて送信する
+  void sendCommands(const std::vector<model::command>& _commands) override;
+
 private:
+  /// @brief           packet_にcommandsを詰めて送信する
+  template <class Iterator>
+  void send(Iterator _first, Iterator _last);
+
   util::multicast::sender udpSender_;
+
+  std::mutex mutex_;
+  /// 送信するパケット (確保した領域を使い回すため, 毎回作り直さない)
+  ssl_protos::grsim::Packet packet_;
+  /// シリアライズしたパケットを書き込むバッファ
+  std::vector<uint8_t> buffer_;
 };
 } // namespace sender
 } // namespace ai
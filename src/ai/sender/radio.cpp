@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <variant>
+
+#include "ai/util/math/crc16.hpp"
+#include "radio.hpp"
+
+namespace ai {
+namespace sender {
+
+namespace {
+
+// 範囲に収めて丸めた値
+template <class T>
+T saturate(double _value) {
+  const auto v = std::round(_value);
+  return static_cast<T>(std::clamp<double>(v, std::numeric_limits<T>::min(),
+                                           std::numeric_limits<T>::max()));
+}
+
+// int16をリトルエンディアンで書き込む
+uint8_t* put(uint8_t* _p, int16_t _value) {
+  const auto v = static_cast<uint16_t>(_value);
+  _p[0]        = static_cast<uint8_t>(v & 0xFF);
+  _p[1]        = static_cast<uint8_t>(v >> 8);
+  return _p + 2;
+}
+
+} // namespace
+
+radio::radio(boost::asio::io_service& _ioService, const std::string& _device,
+             unsigned int _baudRate)
+    : serial_(_ioService, _device), state_(std::make_shared<state>()) {
+  serial_.setBaudRate(_baudRate);
+  state_->serial   = &serial_;
+  state_->sizes    = {{0, 0}};
+  state_->writing  = 0;
+  state_->busy     = false;
+  state_->pending  = false;
+  state_->sequence = 0;
+}
+
+radio::~radio() {
+  // 中止した書き込みのハンドラはstate_を持っているので, 呼ばれるのを待たずに破棄してよい
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  state_->serial  = nullptr;
+  state_->pending = false;
+  serial_.cancel();
+}
+
+void radio::sendCommand(const model::command& _command) {
+  send(&_command, &_command + 1);
+}
+
+void radio::sendCommands(const std::vector<model::command>& _commands) {
+  send(_commands.data(), _commands.data() + _commands.size());
+}
+
+radio::metrics radio::statistics() const {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  return state_->statistics;
+}
+
+std::size_t radio::encode(const model::command* _first, const model::command* _last,
+                          uint8_t _sequence, FrameType& _frame) {
+  const auto num = std::min<std::size_t>(_last - _first, maxRobots);
+
+  auto p = _frame.data();
+  *p++   = startByte0;
+  *p++   = startByte1;
+  *p++   = _sequence;
+  *p++   = static_cast<uint8_t>(num);
+
+  for (auto it = _first; it != _first + num; ++it) {
+    const auto& command = *it;
+    *p++                = static_cast<uint8_t>(command.id());
+
+    const auto kick = std::get<0>(command.kick());
+    uint8_t flags   = static_cast<uint8_t>(static_cast<uint8_t>(kick) << 1);
+
+    const auto& setpoint = command.setpoint();
+    if (const auto position = std::get_if<model::command::position>(&setpoint)) {
+      flags |= 1;
+      *p++ = flags;
+      p    = put(p, saturate<int16_t>(position->x));
+      p    = put(p, saturate<int16_t>(position->y));
+      p    = put(p, saturate<int16_t>(position->theta * 1000));
+    } else {
+      const auto& velocity = std::get<model::command::velocity>(setpoint);
+      *p++                 = flags;
+      p                    = put(p, saturate<int16_t>(velocity.vx));
+      p                    = put(p, saturate<int16_t>(velocity.vy));
+      p                    = put(p, saturate<int16_t>(velocity.omega * 1000));
+    }
+
+    *p++ = kick == model::command::kickType::None
+               ? 0
+               : saturate<uint8_t>(std::get<1>(command.kick()) * 10);
+    *p++ = saturate<uint8_t>(command.dribble());
+  }
+
+  // 開始バイトを除いた部分のCRC
+  const auto crc = util::math::crc16(_frame.data() + 2, p - _frame.data() - 2);
+  *p++           = static_cast<uint8_t>(crc >> 8);
+  *p++           = static_cast<uint8_t>(crc & 0xFF);
+  return p - _frame.data();
+}
+
+void radio::send(const model::command* _first, const model::command* _last) {
+  auto& s = *state_;
+  std::lock_guard<std::mutex> lock(s.mutex);
+
+  // 送信中のフレームには触れず, もう一方のバッファに組み立てる
+  const auto index = 1 - s.writing;
+  s.sizes[index]   = encode(_first, _last, s.sequence++, s.frames[index]);
+
+  if (s.busy) {
+    // 前の周期のフレームがまだ送られていなければ, それは送らずに置き換える
+    if (s.pending) ++s.statistics.skipped;
+    s.pending = true;
+    return;
+  }
+  start(state_, index);
+}
+
+void radio::start(const std::shared_ptr<state>& _state, std::size_t _index) {
+  auto& s   = *_state;
+  s.busy    = true;
+  s.pending = false;
+  s.writing = _index;
+  // ハンドラは使い回す領域に置かせ, 送信ごとのメモリ確保をなくす
+  auto handler = [_state](const boost::system::error_code& _error, std::size_t _bytes) {
+    completed(_state, _error, _bytes);
+  };
+  s.serial->asyncWrite(boost::asio::buffer(s.frames[_index].data(), s.sizes[_index]),
+                       util::makeAllocatedHandler(s.handlerMemory, handler));
+}
+
+void radio::completed(const std::shared_ptr<state>& _state,
+                      const boost::system::error_code& _error, std::size_t _bytes) {
+  auto& s = *_state;
+  std::lock_guard<std::mutex> lock(s.mutex);
+  if (_error) {
+    ++s.statistics.errors;
+  } else {
+    ++s.statistics.frames;
+  }
+  s.statistics.bytes += _bytes;
+
+  // radioが破棄されていれば, 次のフレームは送らない
+  if (s.pending && s.serial) {
+    start(_state, 1 - s.writing);
+  } else {
+    s.busy = false;
+  }
+}
+
+} // namespace sender
+} // namespace ai
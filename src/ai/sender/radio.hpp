@@ -0,0 +1,140 @@
+#ifndef AI_SENDER_RADIO_HPP_
+#define AI_SENDER_RADIO_HPP_
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <boost/asio.hpp>
+#include <stdint.h>
+
+#include "ai/model/command.hpp"
+#include "ai/util/handlerMemory.hpp"
+#include "ai/util/serial.hpp"
+
+#include "base.hpp"
+
+namespace ai {
+namespace sender {
+
+/// @class   radio
+/// @brief   シリアルポートにつないだ無線機で実機のロボットへ命令を送るSender
+///
+/// 1周期分の全てのロボットへの命令を, 次の固定長の形式のフレーム1つにまとめて送る.
+/// 多バイトの値はリトルエンディアン, CRCだけはビッグエンディアンとする.
+///
+///   0xA5 0x5A | 通し番号(1) | 台数n(1) | ロボットごとの命令(10) x n | CRC16(2)
+///
+/// CRCは通し番号から最後のロボットの命令までに対してutil::math::crc16で求める.
+/// ロボットごとの命令の形式は次の通り.
+///
+///   id(1) | フラグ(1) | x(2) | y(2) | theta(2) | キックの強さ(1) | ドリブルの強さ(1)
+///
+///   フラグ       bit0: 位置指令なら1, 速度指令なら0, bit1-2: キックの種類
+///   x, y         位置指令なら[mm], 速度指令なら[mm/s] (int16)
+///   theta        位置指令なら[mrad], 速度指令なら[mrad/s] (int16)
+///   キックの強さ  [0.1m/s] (uint8)
+///
+/// 送信はio_serviceのスレッドで非同期に行い, 呼び出し側はフレームを組み立てるだけで戻る.
+/// 前のフレームの送信中に次の周期の命令が来たときは, 最新の周期の1つだけを次に送る.
+/// フレームは固定長のバッファに組み立てるので, 送信で動的なメモリ確保は行わない
+class radio final : public base {
+public:
+  /// 1つのフレームに入れられるロボットの数 (これを超える分は送らない)
+  static constexpr std::size_t maxRobots = 16;
+  /// ヘッダ(開始バイト, 通し番号, 台数)の大きさ [byte]
+  static constexpr std::size_t headerSize = 4;
+  /// ロボット1台分の命令の大きさ [byte]
+  static constexpr std::size_t robotSize = 10;
+  /// CRCの大きさ [byte]
+  static constexpr std::size_t crcSize = 2;
+  /// フレームの最大の大きさ [byte]
+  static constexpr std::size_t maxFrameSize = headerSize + robotSize * maxRobots + crcSize;
+
+  /// フレームの開始バイト
+  static constexpr uint8_t startByte0 = 0xA5;
+  static constexpr uint8_t startByte1 = 0x5A;
+
+  using FrameType = std::array<uint8_t, maxFrameSize>;
+
+  /// 送信の統計
+  struct metrics {
+    uint64_t frames{0};   // 送信し終えたフレームの数
+    uint64_t bytes{0};    // 送信し終えたバイト数
+    uint64_t skipped{0};  // 送信が間に合わず, 新しいフレームで置き換えたフレームの数
+    uint64_t errors{0};   // 送信に失敗した回数
+  };
+
+  /// @param ioService 送信を行うio_service (別のスレッドでrun()されている必要がある)
+  /// @param device    無線機をつないだシリアルポートのデバイス名
+  /// @param baudRate  ボーレート
+  radio(boost::asio::io_service& _ioService, const std::string& _device,
+        unsigned int _baudRate = 115200);
+
+  radio(const radio&) = delete;
+  radio& operator=(const radio&) = delete;
+
+  /// @brief           送信中のフレームがあれば中止する
+  ///
+  /// 中止した書き込みのハンドラが呼ばれるのは待たない
+  ~radio();
+
+  void sendCommand(const model::command& _command) override;
+
+  /// @brief           全てのロボットへの命令を1つのフレームにまとめて送信する
+  void sendCommands(const std::vector<model::command>& _commands) override;
+
+  /// @brief           送信の統計を取得する
+  metrics statistics() const;
+
+  /// @brief           命令をフレームに変換する
+  /// @param first     最初の命令
+  /// @param last      最後の命令の次
+  /// @param sequence  フレームの通し番号
+  /// @param frame     フレームを書き込むバッファ
+  /// @return          フレームの大きさ [byte]
+  static std::size_t encode(const model::command* _first, const model::command* _last,
+                            uint8_t _sequence, FrameType& _frame);
+
+private:
+  /// 送信の状態
+  /// 書き込みのハンドラにも持たせ, radioを破棄した後にハンドラが呼ばれても使えるようにする
+  struct state {
+    std::mutex mutex;
+    /// 送信に使うシリアルポート (radioが破棄された後はnullptr)
+    util::serial* serial;
+    /// 送信中のフレームと次に送るフレーム (交互に使う)
+    std::array<FrameType, 2> frames;
+    std::array<std::size_t, 2> sizes;
+    /// 送信中のフレームの番号
+    std::size_t writing;
+    /// 送信中か
+    bool busy;
+    /// 送信中のフレームの次に送るフレームがあるか
+    bool pending;
+    uint8_t sequence;
+    metrics statistics;
+    /// 非同期の書き込みのハンドラを置く領域
+    util::handlerMemory handlerMemory;
+  };
+
+  /// @brief           命令をフレームにして, 送信中でなければ送信を始める
+  void send(const model::command* _first, const model::command* _last);
+
+  /// @brief           frames[index]の送信を始める (mutexを取得した状態で呼ぶ)
+  static void start(const std::shared_ptr<state>& _state, std::size_t _index);
+
+  /// @brief           送信し終えたときの処理 (io_serviceのスレッドで呼ばれる)
+  static void completed(const std::shared_ptr<state>& _state,
+                        const boost::system::error_code& _error, std::size_t _bytes);
+
+  util::serial serial_;
+  std::shared_ptr<state> state_;
+};
+
+} // namespace sender
+} // namespace ai
+
+#endif // AI_SENDER_RADIO_HPP_
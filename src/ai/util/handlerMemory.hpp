@@ -0,0 +1,133 @@
+#ifndef AI_UTIL_HANDLER_MEMORY_HPP_
+#define AI_UTIL_HANDLER_MEMORY_HPP_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ai {
+namespace util {
+
+/// @class   handlerMemory
+/// @brief   非同期操作のハンドラを置くための, 使い回す固定長の領域
+///
+/// Boost.Asioは非同期操作を始めるたびにハンドラを包んだオブジェクトの領域を確保する.
+/// 同時に1つの操作しか行わない場合はこの領域を使い回すことで, 動的なメモリ確保をなくせる.
+/// 領域が使用中か足りないときは, 通常のoperator newで確保する
+class handlerMemory {
+public:
+  /// 用意しておく領域の大きさ [byte]
+  static constexpr std::size_t size = 256;
+
+  handlerMemory() : inUse_(false) {}
+
+  handlerMemory(const handlerMemory&) = delete;
+  handlerMemory& operator=(const handlerMemory&) = delete;
+
+  void* allocate(std::size_t _size) {
+    if (!inUse_ && _size <= size) {
+      inUse_ = true;
+      return &storage_;
+    }
+    return ::operator new(_size);
+  }
+
+  void deallocate(void* _pointer) {
+    if (_pointer == &storage_) {
+      inUse_ = false;
+    } else {
+      ::operator delete(_pointer);
+    }
+  }
+
+private:
+  std::aligned_storage_t<size> storage_;
+  bool inUse_;
+};
+
+/// @class   handlerAllocator
+/// @brief   handlerMemoryから領域を確保するアロケータ
+template <class T>
+class handlerAllocator {
+public:
+  using value_type = T;
+
+  explicit handlerAllocator(handlerMemory& _memory) : memory_(&_memory) {}
+
+  template <class U>
+  handlerAllocator(const handlerAllocator<U>& _other) : memory_(_other.memory_) {}
+
+  T* allocate(std::size_t _n) const {
+    return static_cast<T*>(memory_->allocate(sizeof(T) * _n));
+  }
+
+  void deallocate(T* _pointer, std::size_t) const {
+    memory_->deallocate(_pointer);
+  }
+
+  template <class U>
+  bool operator==(const handlerAllocator<U>& _other) const {
+    return memory_ == _other.memory_;
+  }
+
+  template <class U>
+  bool operator!=(const handlerAllocator<U>& _other) const {
+    return memory_ != _other.memory_;
+  }
+
+private:
+  template <class>
+  friend class handlerAllocator;
+
+  handlerMemory* memory_;
+};
+
+/// @class   allocatedHandler
+/// @brief   ハンドラの領域をhandlerMemoryから確保させるためのラッパ
+///
+/// Boost 1.66以降は関連付けられたアロケータ(get_allocator())が, それより前は
+/// asio_handler_allocate/asio_handler_deallocateのフックが使われる
+template <class Handler>
+class allocatedHandler {
+public:
+  using allocator_type = handlerAllocator<Handler>;
+
+  allocatedHandler(handlerMemory& _memory, Handler _handler)
+      : memory_(_memory), handler_(std::move(_handler)) {}
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type{memory_};
+  }
+
+  template <class... Args>
+  void operator()(Args&&... _args) {
+    handler_(std::forward<Args>(_args)...);
+  }
+
+  friend void* asio_handler_allocate(std::size_t _size, allocatedHandler* _this) {
+    return _this->memory_.allocate(_size);
+  }
+
+  friend void asio_handler_deallocate(void* _pointer, std::size_t, allocatedHandler* _this) {
+    _this->memory_.deallocate(_pointer);
+  }
+
+private:
+  handlerMemory& memory_;
+  Handler handler_;
+};
+
+/// @brief           allocatedHandlerを作る
+/// @param memory    ハンドラを置く領域
+/// @param handler   ラップするハンドラ
+template <class Handler>
+allocatedHandler<std::decay_t<Handler>> makeAllocatedHandler(handlerMemory& _memory,
+                                                             Handler&& _handler) {
+  return {_memory, std::forward<Handler>(_handler)};
+}
+
+} // namespace util
+} // namespace ai
+
+#endif // AI_UTIL_HANDLER_MEMORY_HPP_
@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "ai/util/histogram.hpp"
+
+namespace ai {
+namespace util {
+
+histogram::histogram() {
+  clear();
+}
+
+void histogram::record(DurationType _value) {
+  const auto v = static_cast<uint64_t>(std::max<DurationType::rep>(_value.count(), 0));
+  ++counts_[bucketOf(v)];
+  ++count_;
+  min_ = std::min(min_, v);
+  max_ = std::max(max_, v);
+  sum_ += v;
+}
+
+void histogram::clear() {
+  counts_.fill(0);
+  count_ = 0;
+  min_   = std::numeric_limits<uint64_t>::max();
+  max_   = 0;
+  sum_   = 0.0;
+}
+
+uint64_t histogram::count() const {
+  return count_;
+}
+
+histogram::DurationType histogram::min() const {
+  return DurationType{count_ == 0 ? 0 : min_};
+}
+
+histogram::DurationType histogram::max() const {
+  return DurationType{max_};
+}
+
+histogram::DurationType histogram::mean() const {
+  if (count_ == 0) return DurationType{0};
+  return DurationType{static_cast<DurationType::rep>(sum_ / count_)};
+}
+
+histogram::DurationType histogram::percentile(double _p) const {
+  if (count_ == 0) return DurationType{0};
+
+  // 小さい方から数えてtarget番目の値が含まれる階級を探す
+  const auto target = std::max<uint64_t>(
+      static_cast<uint64_t>(std::ceil(std::clamp(_p, 0.0, 1.0) * count_)), 1);
+  auto sum = 0ul;
+  for (auto i = 0u; i < buckets; ++i) {
+    sum += counts_[i];
+    if (sum >= target) return DurationType{std::min(upperOf(i), max_)};
+  }
+  return DurationType{max_};
+}
+
+std::size_t histogram::bucketOf(uint64_t _v) {
+  constexpr uint64_t sub = 1u << subBits;
+  if (_v < sub) return _v;
+  // 最上位ビットの位置で区間を決め, その下のsubBitsビットで区間内の階級を決める
+  const auto e = 63 - __builtin_clzll(_v);
+  if (e >= maxBits) return buckets - 1;
+  return ((e - subBits + 1) << subBits) + ((_v >> (e - subBits)) & (sub - 1));
+}
+
+uint64_t histogram::upperOf(std::size_t _i) {
+  constexpr uint64_t sub = 1u << subBits;
+  if (_i < sub) return _i;
+  const auto shift = (_i >> subBits) - 1;
+  const auto lower = (sub + (_i & (sub - 1))) << shift;
+  return lower + (uint64_t{1} << shift) - 1;
+}
+
+} // namespace util
+} // namespace ai
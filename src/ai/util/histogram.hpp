@@ -0,0 +1,70 @@
+#ifndef AI_UTIL_HISTOGRAM_HPP_
+#define AI_UTIL_HISTOGRAM_HPP_
+
+#include <array>
+#include <chrono>
+#include <stdint.h>
+
+namespace ai {
+namespace util {
+
+/// @class   histogram
+/// @brief   処理時間の分布を記録するヒストグラム
+///
+/// 2のべき乗ごとの区間をさらに8つに分けた階級に数えるので, 百分位数の誤差は12.5%以内になる.
+/// 記録にメモリ確保や分岐の多い処理を伴わないので, 制御周期の中で毎回呼んでもよい.
+/// 最小値, 最大値, 平均値は正確な値を保持する
+class histogram {
+public:
+  using DurationType = std::chrono::nanoseconds;
+
+  histogram();
+
+  /// @brief           時間を1つ記録する (負の値は0として扱う)
+  void record(DurationType _value);
+
+  /// @brief           記録をすべて消す
+  void clear();
+
+  /// @brief           記録した数
+  uint64_t count() const;
+
+  /// @brief           記録した中で最小の値 (記録がなければ0)
+  DurationType min() const;
+
+  /// @brief           記録した中で最大の値 (記録がなければ0)
+  DurationType max() const;
+
+  /// @brief           記録した値の平均 (記録がなければ0)
+  DurationType mean() const;
+
+  /// @brief           百分位数を求める
+  /// @param p         0から1の割合 (0.99なら99パーセンタイル)
+  /// @return          p以上の割合の値がそれ以下になる階級の上端 (最大値を超えない)
+  DurationType percentile(double _p) const;
+
+private:
+  /// 1つの2のべき乗の区間を分ける数のビット数
+  static constexpr int subBits = 3;
+  /// 階級を分ける最大の2のべき乗 (これ以上の値は最後の階級に数える)
+  static constexpr int maxBits = 40;
+  /// 階級の数
+  static constexpr std::size_t buckets = (maxBits - subBits + 1) << subBits;
+
+  /// @brief           値vを数える階級の番号
+  static std::size_t bucketOf(uint64_t _v);
+
+  /// @brief           階級iに数える値の上限
+  static uint64_t upperOf(std::size_t _i);
+
+  std::array<uint64_t, buckets> counts_;
+  uint64_t count_;
+  uint64_t min_;
+  uint64_t max_;
+  double sum_;
+};
+
+} // namespace util
+} // namespace ai
+
+#endif // AI_UTIL_HISTOGRAM_HPP_
@@ -0,0 +1,255 @@
+#ifndef AI_UTIL_ID_MAP_HPP_
+#define AI_UTIL_ID_MAP_HPP_
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <stdint.h>
+
+namespace ai {
+namespace util {
+
+/// @class   idMap
+/// @brief   IDをKeyとする固定長のハッシュテーブル風コンテナ
+///
+/// IDで直接添字付けされる配列と, 要素の有無を表すビットマスクで構成される.
+/// ロボットIDのように値の範囲が小さいKeyに対して, std::unordered_mapとほぼ同じ
+/// インターフェースを提供する.
+/// - 探索はハッシュを計算せず配列を参照するだけで行われる
+/// - コピーは動的なメモリ確保を伴わない
+/// - 走査は常にIDの昇順に行われる
+template <class T, std::size_t Capacity>
+class idMap {
+  static_assert(Capacity > 0 && Capacity <= 64, "Capacity must be in [1, 64]");
+
+  /// 要素の有無を表すビットマスクの型
+  using MaskType = std::conditional_t<(Capacity <= 32), uint32_t, uint64_t>;
+
+public:
+  using key_type        = uint32_t;
+  using mapped_type     = T;
+  /// std::unordered_mapと同じく, イテレータ経由でIDを書き換えられないようにする
+  using value_type      = std::pair<const key_type, mapped_type>;
+  using size_type       = std::size_t;
+  using reference       = value_type&;
+  using const_reference = const value_type&;
+
+  /// 要素の存在するスロットだけを辿るイテレータ
+  template <bool IsConst>
+  class basicIterator {
+    friend class idMap;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = typename idMap::value_type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = std::conditional_t<IsConst, const value_type*, value_type*>;
+    using reference         = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+    basicIterator() : slots_(nullptr), mask_(0), index_(Capacity) {}
+
+    // iteratorからconst_iteratorへの変換
+    template <bool C = IsConst, std::enable_if_t<C, std::nullptr_t> = nullptr>
+    basicIterator(const basicIterator<false>& _it)
+        : slots_(_it.slots_), mask_(_it.mask_), index_(_it.index_) {}
+
+    reference operator*() const {
+      return slots_[index_];
+    }
+
+    pointer operator->() const {
+      return slots_ + index_;
+    }
+
+    basicIterator& operator++() {
+      index_ = next(mask_, index_ + 1);
+      return *this;
+    }
+
+    basicIterator operator++(int) {
+      auto tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const basicIterator& _rhs) const {
+      return index_ == _rhs.index_;
+    }
+
+    bool operator!=(const basicIterator& _rhs) const {
+      return index_ != _rhs.index_;
+    }
+
+  private:
+    friend class basicIterator<true>;
+
+    basicIterator(pointer _slots, MaskType _mask, std::size_t _index)
+        : slots_(_slots), mask_(_mask), index_(_index) {}
+
+    pointer slots_;
+    MaskType mask_;
+    std::size_t index_;
+  };
+
+  using iterator       = basicIterator<false>;
+  using const_iterator = basicIterator<true>;
+
+  idMap() : slots_(makeSlots(std::make_index_sequence<Capacity>{})), mask_(0) {}
+
+  idMap(std::initializer_list<value_type> _values) : idMap() {
+    for (const auto& v : _values) (*this)[v.first] = v.second;
+  }
+
+  idMap(const idMap&) = default;
+  idMap(idMap&&)      = default;
+
+  // IDはconstなので, 値だけを代入する (同じ位置のスロットのIDは常に等しい)
+  idMap& operator=(const idMap& _rhs) {
+    for (auto i = 0u; i < Capacity; ++i) slots_[i].second = _rhs.slots_[i].second;
+    mask_ = _rhs.mask_;
+    return *this;
+  }
+
+  idMap& operator=(idMap&& _rhs) {
+    for (auto i = 0u; i < Capacity; ++i) slots_[i].second = std::move(_rhs.slots_[i].second);
+    mask_ = _rhs.mask_;
+    return *this;
+  }
+
+  /// @brief           格納できるIDの上限(このIDは含まない)を返す
+  static constexpr size_type capacity() {
+    return Capacity;
+  }
+
+  /// @brief           IDが格納可能な範囲にあるか
+  static constexpr bool acceptable(key_type _id) {
+    return _id < Capacity;
+  }
+
+  size_type size() const {
+    return __builtin_popcountll(mask_);
+  }
+
+  bool empty() const {
+    return mask_ == 0;
+  }
+
+  size_type count(key_type _id) const {
+    return acceptable(_id) && (mask_ & bit(_id)) ? 1 : 0;
+  }
+
+  /// @brief           IDに対応する要素を返す
+  ///
+  /// 要素が存在しない場合はstd::out_of_range例外を投げる
+  mapped_type& at(key_type _id) {
+    if (!count(_id)) throw std::out_of_range("idMap::at");
+    return slots_[_id].second;
+  }
+
+  const mapped_type& at(key_type _id) const {
+    if (!count(_id)) throw std::out_of_range("idMap::at");
+    return slots_[_id].second;
+  }
+
+  /// @brief           IDに対応する要素を返す
+  ///
+  /// 要素が存在しない場合は値初期化された要素を追加する.
+  /// IDが格納可能な範囲にない場合はstd::out_of_range例外を投げる
+  mapped_type& operator[](key_type _id) {
+    if (!acceptable(_id)) throw std::out_of_range("idMap::operator[]");
+    if (!(mask_ & bit(_id))) {
+      slots_[_id].second = mapped_type{};
+      mask_ |= bit(_id);
+    }
+    return slots_[_id].second;
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(key_type _id, Args&&... _args) {
+    if (!acceptable(_id)) throw std::out_of_range("idMap::emplace");
+    if (mask_ & bit(_id)) return {iterator{slots_.data(), mask_, _id}, false};
+    slots_[_id].second = mapped_type(std::forward<Args>(_args)...);
+    mask_ |= bit(_id);
+    return {iterator{slots_.data(), mask_, _id}, true};
+  }
+
+  iterator find(key_type _id) {
+    return count(_id) ? iterator{slots_.data(), mask_, _id} : end();
+  }
+
+  const_iterator find(key_type _id) const {
+    return count(_id) ? const_iterator{slots_.data(), mask_, _id} : end();
+  }
+
+  size_type erase(key_type _id) {
+    if (!count(_id)) return 0;
+    mask_ &= ~bit(_id);
+    return 1;
+  }
+
+  iterator erase(const_iterator _it) {
+    const auto id = _it.index_;
+    mask_ &= ~bit(id);
+    return iterator{slots_.data(), mask_, next(mask_, id + 1)};
+  }
+
+  void clear() {
+    mask_ = 0;
+  }
+
+  iterator begin() {
+    return iterator{slots_.data(), mask_, next(mask_, 0)};
+  }
+
+  const_iterator begin() const {
+    return const_iterator{slots_.data(), mask_, next(mask_, 0)};
+  }
+
+  const_iterator cbegin() const {
+    return begin();
+  }
+
+  iterator end() {
+    return iterator{slots_.data(), mask_, Capacity};
+  }
+
+  const_iterator end() const {
+    return const_iterator{slots_.data(), mask_, Capacity};
+  }
+
+  const_iterator cend() const {
+    return end();
+  }
+
+private:
+  static constexpr MaskType bit(std::size_t _id) {
+    return static_cast<MaskType>(1) << _id;
+  }
+
+  /// @brief           firstにIDを入れたスロットを作る
+  template <std::size_t... Ids>
+  static std::array<value_type, Capacity> makeSlots(std::index_sequence<Ids...>) {
+    return {{value_type{static_cast<key_type>(Ids), mapped_type{}}...}};
+  }
+
+  /// @brief           from以降で最初に要素が存在するIDを返す (存在しなければCapacity)
+  static std::size_t next(MaskType _mask, std::size_t _from) {
+    if (_from >= Capacity) return Capacity;
+    const MaskType rest = _mask & ~(bit(_from) - 1);
+    return rest ? __builtin_ctzll(rest) : Capacity;
+  }
+
+  /// IDで添字付けされた要素 (firstには常にIDが入っている)
+  std::array<value_type, Capacity> slots_;
+  /// 要素が存在するIDのビットが立ったマスク
+  MaskType mask_;
+};
+
+} // namespace util
+} // namespace ai
+
+#endif // AI_UTIL_ID_MAP_HPP_
@@ -31,6 +31,23 @@ model::robot transform(const Eigen::Affine3d& _matrix, const model::robot& _robo
   return result;
 }
 
+void transform(const Eigen::Affine3d& _matrix, model::robotStates& _states) {
+  using ColumnType = model::robotStates::ColumnType;
+  const auto& m    = _matrix.matrix();
+
+  // 各列に行列の要素を掛けて, matrix * (x, y, theta) を全スロット同時に計算する
+  const ColumnType x = m(0, 0) * _states.x() + m(0, 1) * _states.y() +
+                       m(0, 2) * _states.theta() + m(0, 3);
+  const ColumnType y = m(1, 0) * _states.x() + m(1, 1) * _states.y() +
+                       m(1, 2) * _states.theta() + m(1, 3);
+  const ColumnType z = m(2, 0) * _states.x() + m(2, 1) * _states.y() +
+                       m(2, 2) * _states.theta() + m(2, 3);
+
+  _states.x()     = x;
+  _states.y()     = y;
+  _states.theta() = z.unaryExpr([](double _r) { return util::math::wrapTo2pi(_r); });
+}
+
 } // namespace math
 } // namespace util
 } // namespace ai
@@ -7,6 +7,7 @@
 
 #include "ai/model/ball.hpp"
 #include "ai/model/robot.hpp"
+#include "ai/model/robotStates.hpp"
 
 namespace ai {
 namespace util {
@@ -24,6 +25,13 @@ model::ball transform(const Eigen::Affine3d& _matrix, const model::ball& _ball);
 /// @return          変換後の値
 model::robot transform(const Eigen::Affine3d& _matrix, const model::robot& _robot);
 
+/// @brief           全ロボットの座標変換をまとめて行う
+/// @param matrix    変換行列
+/// @param states    変換する値. 変換後の値はここに書き込まれる
+///
+/// 全スロットに対して transform(matrix, robot) と同等の変換を行う
+void transform(const Eigen::Affine3d& _matrix, model::robotStates& _states);
+
 namespace detail {
 template <class Vector, std::size_t... Idx>
 auto vectorToTupleImpl(const Vector& _v, std::index_sequence<Idx...>) {
@@ -1,31 +1,40 @@
 #include "crc16.hpp"
-#include <iostream>
+#include <array>
 
 namespace ai {
 namespace util {
 namespace math {
-uint16_t crc16(const std::vector<uint8_t>& _buf) {
-  uint16_t result         = 0xFFFF;
-  constexpr uint16_t poly = 0x8005; // CRC生成多項式
-
-  // 1frameのCRCを計算するためのlambda
-  auto frameCrc = [&result](const uint8_t _frame) -> auto {
-    result ^= (_frame << 8);
+namespace {
+constexpr uint16_t poly = 0x8005; // CRC生成多項式
 
-    for (int i = 0; i < 8; i++) {
-      if (result & 0x8000) {
-        // シフト時にキャリーが発生する場合は多項式でXOR
-        result <<= 1;
-        result ^= poly;
-      } else {
-        result <<= 1;
-      }
+// 上位8bitがiのときに, 1byte分シフトした結果の表
+constexpr std::array<uint16_t, 256> makeTable() {
+  std::array<uint16_t, 256> table{};
+  for (int i = 0; i < 256; i++) {
+    uint16_t result = static_cast<uint16_t>(i << 8);
+    for (int j = 0; j < 8; j++) {
+      // シフト時にキャリーが発生する場合は多項式でXOR
+      result = (result & 0x8000) ? static_cast<uint16_t>((result << 1) ^ poly)
+                                 : static_cast<uint16_t>(result << 1);
     }
-  };
+    table[i] = result;
+  }
+  return table;
+}
+
+constexpr auto table = makeTable();
+} // namespace
+
+uint16_t crc16(const std::vector<uint8_t>& _buf) {
+  return crc16(_buf.data(), _buf.size());
+}
+
+uint16_t crc16(const uint8_t* _data, std::size_t _size) {
+  uint16_t result = 0xFFFF;
 
-  // 全てのframeに対してCRCを計算
-  for (auto buf : _buf) {
-    frameCrc(buf);
+  // 1frameずつ, 表を引いて8bit分のシフトとXORをまとめて行う
+  for (std::size_t i = 0; i < _size; ++i) {
+    result = static_cast<uint16_t>((result << 8) ^ table[(result >> 8) ^ _data[i]]);
   }
 
   return result;
@@ -1,6 +1,7 @@
 #ifndef AI_UTIL_MATH_CRC16_HPP
 #define AI_UTIL_MATH_CRC16_HPP
 
+#include <cstddef>
 #include <functional>
 #include <vector>
 #include <stdint.h>
@@ -12,6 +13,12 @@ namespace math {
 /// @param _buf CRC計算対象のデータを格納したコンテナ
 /// @return CRC計算結果
 uint16_t crc16(const std::vector<uint8_t>& _buf);
+
+/// @brief CRC16を計算する
+/// @param _data CRC計算対象のデータの先頭
+/// @param _size CRC計算対象のデータのバイト数
+/// @return CRC計算結果
+uint16_t crc16(const uint8_t* _data, std::size_t _size);
 } // namespace math
 } // namespace util
 } // namespace ai
@@ -1,4 +1,8 @@
+#include <cerrno>
+#include <cstring>
 #include <functional>
+#include <sys/socket.h>
+#include <sys/uio.h>
 #include "receiver.hpp"
 
 #include <iostream>
@@ -6,43 +10,192 @@
 namespace ai {
 namespace util {
 namespace multicast {
+
+namespace {
+
+/// 制御メッセージを受け取る領域の大きさ (SO_RXQ_OVFLの値が入る)
+constexpr std::size_t controlSize = CMSG_SPACE(sizeof(uint32_t));
+
+#ifdef __linux__
+using messageHeader = ::mmsghdr;
+
+/// @brief           溜まっているデータグラムを1回のシステムコールでまとめて受信する
+int receiveMessages(int _fd, messageHeader* _headers, unsigned int _size) {
+  return ::recvmmsg(_fd, _headers, _size, MSG_DONTWAIT, nullptr);
+}
+#else
+/// recvmmsgが使えない環境でのmmsghdr相当の構造体
+struct messageHeader {
+  ::msghdr msg_hdr;
+  unsigned int msg_len;
+};
+
+/// @brief           溜まっているデータグラムをrecvmsgで1つずつ受信する
+int receiveMessages(int _fd, messageHeader* _headers, unsigned int _size) {
+  unsigned int i = 0;
+  for (; i < _size; ++i) {
+    const auto len = ::recvmsg(_fd, &_headers[i].msg_hdr, MSG_DONTWAIT);
+    if (len < 0) {
+      if (i == 0) return -1;
+      break;
+    }
+    _headers[i].msg_len = static_cast<unsigned int>(len);
+  }
+  return static_cast<int>(i);
+}
+#endif
+
+} // namespace
+
 receiver::receiver(boost::asio::io_service& _ioService, const std::string& _listen,
-                   const std::string& _multicast, uint16_t _port)
+                   const std::string& _multicast, uint16_t _port, receiveMode _mode)
     : receiver(_ioService, boost::asio::ip::address::from_string(_listen),
-               boost::asio::ip::address::from_string(_multicast), _port) {}
+               boost::asio::ip::address::from_string(_multicast), _port, _mode) {}
 
 receiver::receiver(boost::asio::io_service& _ioService, const boost::asio::ip::address& _listen,
-                   const boost::asio::ip::address& _multicast, uint16_t _port)
-    : socket(_ioService), endPoint(_listen, _port) {
+                   const boost::asio::ip::address& _multicast, uint16_t _port,
+                   receiveMode _mode)
+    : socket(_ioService),
+      endPoint(_listen, _port),
+      wakeups(0),
+      packets(0),
+      maxPacketsPerWakeup(0),
+      truncated(0),
+      dropped(0) {
   socket.open(endPoint.protocol());
   socket.set_option(UDP::socket::reuse_address(true));
   socket.bind(endPoint);
   socket.set_option(boost::asio::ip::multicast::join_group(_multicast));
-  boost::asio::spawn(socket.get_io_service(),
-                     std::bind(&receiver::receive, this, std::placeholders::_1));
+
+  if (_mode == receiveMode::batch) {
+#ifdef SO_RXQ_OVFL
+    // カーネルが破棄したデータグラムの数を制御メッセージで受け取る
+    // 失敗しても受信には影響しないので, 結果は無視する
+    const int on = 1;
+    ::setsockopt(socket.native_handle(), SOL_SOCKET, SO_RXQ_OVFL, &on, sizeof(on));
+#endif
+    boost::asio::spawn(socket.get_io_service(),
+                       std::bind(&receiver::receiveBatch, this, std::placeholders::_1));
+  } else {
+    boost::asio::spawn(socket.get_io_service(),
+                       std::bind(&receiver::receive, this, std::placeholders::_1));
+  }
 }
 
 boost::signals2::connection receiver::onReceive(const ReceiveSignal::slot_type& _slot) {
   return received.connect(_slot);
 }
 
+boost::signals2::connection receiver::onReceiveBatch(
+    const ReceiveBatchSignal::slot_type& _slot) {
+  return receivedBatch.connect(_slot);
+}
+
 boost::signals2::connection receiver::onError(const ErrorSignal::slot_type& _slot) {
   return errored.connect(_slot);
 }
 
+receiver::statistics receiver::stats() const {
+  return {wakeups.load(std::memory_order_relaxed), packets.load(std::memory_order_relaxed),
+          maxPacketsPerWakeup.load(std::memory_order_relaxed),
+          truncated.load(std::memory_order_relaxed), dropped.load(std::memory_order_relaxed)};
+}
+
 void receiver::receive(boost::asio::yield_context _yield) {
   boost::system::error_code errorCode;
 
   while (true) {
-    Buffer buf;
     const auto rxSize =
-        socket.async_receive_from(boost::asio::buffer(buf), endPoint, _yield[errorCode]);
+        socket.async_receive_from(boost::asio::buffer(buffer), endPoint, _yield[errorCode]);
 
     if (errorCode) {
       errored(errorCode);
     } else {
-      received(buf, rxSize);
+      count(1);
+      received(buffer, rxSize);
+    }
+  }
+}
+
+void receiver::receiveBatch(boost::asio::yield_context _yield) {
+  boost::system::error_code errorCode;
+
+  // 受信に使う領域はここで一度だけ確保し, 以降は使い回す
+  std::vector<Buffer> buffers(maxBatchSize);
+  std::vector<std::array<char, controlSize>> controls(maxBatchSize);
+  std::vector<::iovec> iovecs(maxBatchSize);
+  std::vector<messageHeader> headers(maxBatchSize);
+  BatchType batch{};
+  batch.reserve(maxBatchSize);
+
+  while (true) {
+    // データグラムを読み出さずに, 受信可能になるまで待つ
+    socket.async_receive(boost::asio::null_buffers(), _yield[errorCode]);
+    if (errorCode) {
+      errored(errorCode);
+      continue;
     }
+
+    // 溜まっているデータグラムがなくなるまで受信する
+    uint64_t num = 0;
+    while (true) {
+      for (auto i = 0u; i < maxBatchSize; ++i) {
+        iovecs[i]        = {buffers[i].data(), bufferSize};
+        auto& h          = headers[i].msg_hdr;
+        h.msg_name       = nullptr;
+        h.msg_namelen    = 0;
+        h.msg_iov        = &iovecs[i];
+        h.msg_iovlen     = 1;
+        h.msg_control    = controls[i].data();
+        h.msg_controllen = controlSize;
+        h.msg_flags      = 0;
+      }
+
+      const auto n = receiveMessages(socket.native_handle(), headers.data(), maxBatchSize);
+      if (n < 0) {
+        // 溜まっているデータグラムがなくなった場合以外はエラーとして通知する
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+          errored(boost::system::error_code(errno, boost::system::system_category()));
+        }
+        break;
+      }
+
+      batch.clear();
+      for (auto i = 0; i < n; ++i) {
+        auto& h = headers[i].msg_hdr;
+#ifdef SO_RXQ_OVFL
+        // 受信までにカーネルが破棄したデータグラムの累計
+        for (auto c = CMSG_FIRSTHDR(&h); c != nullptr; c = CMSG_NXTHDR(&h, c)) {
+          if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SO_RXQ_OVFL) {
+            uint32_t value;
+            std::memcpy(&value, CMSG_DATA(c), sizeof(value));
+            dropped.store(value, std::memory_order_relaxed);
+          }
+        }
+#endif
+        // バッファに収まらなかったデータグラムは正しくパースできないので破棄する
+        if (h.msg_flags & MSG_TRUNC) {
+          truncated.fetch_add(1, std::memory_order_relaxed);
+          continue;
+        }
+        batch.emplace_back(buffers[i].data(), headers[i].msg_len);
+      }
+
+      num += n;
+      if (!batch.empty()) receivedBatch(batch);
+      if (static_cast<std::size_t>(n) < maxBatchSize) break;
+    }
+
+    count(num);
+  }
+}
+
+void receiver::count(uint64_t _packets) {
+  // 値を更新するのは受信を行うコルーチンだけなので, 読み出しと書き込みは分けてよい
+  wakeups.fetch_add(1, std::memory_order_relaxed);
+  packets.fetch_add(_packets, std::memory_order_relaxed);
+  if (_packets > maxPacketsPerWakeup.load(std::memory_order_relaxed)) {
+    maxPacketsPerWakeup.store(_packets, std::memory_order_relaxed);
   }
 }
 } // namespace multicast
@@ -2,7 +2,9 @@
 #define AI_UTIL_MULTICAST_RECEIVER_HPP
 
 #include <array>
+#include <atomic>
 #include <string>
+#include <vector>
 #include <stdint.h>
 #include <boost/asio.hpp>
 #include <boost/asio/spawn.hpp>
@@ -14,28 +16,73 @@ namespace multicast {
 class receiver {
 public:
   static constexpr std::size_t bufferSize = 8192;
+  /// バッチ受信で一度のシステムコールで受信するデータグラムの最大数
+  static constexpr std::size_t maxBatchSize = 16;
 
-  using Buffer        = std::array<uint8_t, bufferSize>;
-  using ReceiveSignal = boost::signals2::signal<void(const Buffer&, std::size_t)>;
-  using ErrorSignal   = boost::signals2::signal<void(const boost::system::error_code&)>;
-  using UDP           = boost::asio::ip::udp;
+  /// 受信の方式
+  enum class receiveMode {
+    /// データグラムを1つずつ受信し, onReceiveに登録された関数を呼ぶ
+    single,
+    /// 受信可能になったときに溜まっているデータグラムをまとめて受信し,
+    /// onReceiveBatchに登録された関数を呼ぶ (Linuxではrecvmmsgを使う)
+    batch
+  };
+
+  /// 受信に関する統計
+  struct statistics {
+    /// 受信待ちから復帰した回数
+    uint64_t wakeups;
+    /// 受信したデータグラムの数
+    uint64_t packets;
+    /// 1回の復帰で受信したデータグラムの最大数
+    uint64_t maxPacketsPerWakeup;
+    /// バッファに収まらず切り詰められたため破棄したデータグラムの数
+    uint64_t truncated;
+    /// ソケットの受信バッファが溢れてカーネルが破棄したデータグラムの数 (batchのみ)
+    uint64_t dropped;
+  };
+
+  using Buffer = std::array<uint8_t, bufferSize>;
+  /// まとめて受信したデータグラムの列
+  using BatchType          = std::vector<boost::asio::const_buffer>;
+  using ReceiveSignal      = boost::signals2::signal<void(const Buffer&, std::size_t)>;
+  using ReceiveBatchSignal = boost::signals2::signal<void(const BatchType&)>;
+  using ErrorSignal        = boost::signals2::signal<void(const boost::system::error_code&)>;
+  using UDP                = boost::asio::ip::udp;
 
 private:
   UDP::socket socket;
   UDP::endpoint endPoint;
   ReceiveSignal received;
+  ReceiveBatchSignal receivedBatch;
   ErrorSignal errored;
+  // 受信バッファ (受信のたびに確保しないようにメンバとして持つ)
+  Buffer buffer;
+
+  std::atomic<uint64_t> wakeups;
+  std::atomic<uint64_t> packets;
+  std::atomic<uint64_t> maxPacketsPerWakeup;
+  std::atomic<uint64_t> truncated;
+  std::atomic<uint64_t> dropped;
 
 public:
   receiver(boost::asio::io_service& _ioService, const std::string& _listen,
-           const std::string& _multicast, uint16_t _port);
+           const std::string& _multicast, uint16_t _port,
+           receiveMode _mode = receiveMode::single);
   receiver(boost::asio::io_service& _ioService, const boost::asio::ip::address& _listen,
-           const boost::asio::ip::address& _multicast, uint16_t _port);
+           const boost::asio::ip::address& _multicast, uint16_t _port,
+           receiveMode _mode = receiveMode::single);
   boost::signals2::connection onReceive(const ReceiveSignal::slot_type& _slot);
+  boost::signals2::connection onReceiveBatch(const ReceiveBatchSignal::slot_type& _slot);
   boost::signals2::connection onError(const ErrorSignal::slot_type& _slot);
 
+  /// @brief           受信に関する統計を取得する
+  statistics stats() const;
+
 private:
   void receive(boost::asio::yield_context _yield);
+  void receiveBatch(boost::asio::yield_context _yield);
+  void count(uint64_t _packets);
 };
 } // namespace multicast
 } // namespace util
@@ -0,0 +1,69 @@
+#ifndef AI_UTIL_POOL_HPP_
+#define AI_UTIL_POOL_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace ai {
+namespace util {
+
+/// @class   pool
+/// @brief   オブジェクトを使い回すためのプール
+///
+/// acquire()で取得したオブジェクトは, 全ての参照が破棄されると再び取得できるようになる.
+/// オブジェクトはプールが所有し続けるので, 返却時にデストラクタは呼ばれず,
+/// 取得と返却のどちらでも(プールを拡張するときを除いて)動的なメモリ確保は行われない.
+///
+/// 参照の破棄はどのスレッドから行ってもよいが,
+/// acquire()は同時に複数のスレッドから呼び出してはならない.
+template <class T>
+class pool {
+public:
+  /// @param size      最初に確保しておくオブジェクトの数
+  explicit pool(std::size_t _size) : next_(0) {
+    objects_.reserve(_size);
+    for (auto i = 0u; i < _size; ++i) objects_.push_back(std::make_shared<T>());
+  }
+
+  pool(const pool&) = delete;
+  pool& operator=(const pool&) = delete;
+
+  /// @brief           使われていないオブジェクトを取得する
+  ///
+  /// 使われていないオブジェクトがなければ, 新たにオブジェクトを確保してプールを拡張する.
+  /// 取得したオブジェクトは前回使われたときの状態のままなので, 必要なら呼び出し側で初期化する
+  std::shared_ptr<T> acquire() {
+    const auto n = objects_.size();
+    for (auto i = 0u; i < n; ++i) {
+      const auto index = (next_ + i) % n;
+      // プール以外に参照を持っているものがいなければ再利用できる
+      if (objects_[index].use_count() == 1) {
+        // 最後に参照を破棄したスレッドでの操作が全て見えるようにする
+        std::atomic_thread_fence(std::memory_order_acquire);
+        next_ = (index + 1) % n;
+        return objects_[index];
+      }
+    }
+
+    objects_.push_back(std::make_shared<T>());
+    next_ = 0;
+    return objects_.back();
+  }
+
+  /// @brief           確保しているオブジェクトの数を返す
+  std::size_t size() const {
+    return objects_.size();
+  }
+
+private:
+  std::vector<std::shared_ptr<T>> objects_;
+  /// 次に探索を始める位置
+  std::size_t next_;
+};
+
+} // namespace util
+} // namespace ai
+
+#endif // AI_UTIL_POOL_HPP_
@@ -0,0 +1,32 @@
+#include <cerrno>
+#include <system_error>
+#include <pthread.h>
+#include <sched.h>
+
+#include "ai/util/realtime.hpp"
+
+namespace ai {
+namespace util {
+
+void realtimePriority(int _priority) {
+  sched_param param{};
+  param.sched_priority = _priority;
+  if (const auto e = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param)) {
+    throw std::system_error(e, std::generic_category(), "realtimePriority");
+  }
+}
+
+void cpuAffinity(int _cpu) {
+  if (_cpu < 0 || _cpu >= CPU_SETSIZE) {
+    throw std::system_error(EINVAL, std::generic_category(), "cpuAffinity");
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(_cpu, &set);
+  if (const auto e = pthread_setaffinity_np(pthread_self(), sizeof(set), &set)) {
+    throw std::system_error(e, std::generic_category(), "cpuAffinity");
+  }
+}
+
+} // namespace util
+} // namespace ai
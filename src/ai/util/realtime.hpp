@@ -0,0 +1,22 @@
+#ifndef AI_UTIL_REALTIME_HPP_
+#define AI_UTIL_REALTIME_HPP_
+
+namespace ai {
+namespace util {
+
+/// @brief           呼び出したスレッドをSCHED_FIFOで動かす
+/// @param priority  SCHED_FIFOの優先度 (1から99)
+///
+/// 権限が足りない(CAP_SYS_NICEが無い)ときなど, 変更できなければstd::system_errorを投げる
+void realtimePriority(int _priority);
+
+/// @brief           呼び出したスレッドを1つのCPUでだけ動かす
+/// @param cpu       CPUの番号
+///
+/// 変更できなければstd::system_errorを投げる
+void cpuAffinity(int _cpu);
+
+} // namespace util
+} // namespace ai
+
+#endif // AI_UTIL_REALTIME_HPP_
@@ -56,5 +56,9 @@ void serial::setParity(serial::Parity _parity) {
 void serial::setStopBits(serial::StopBits _bits) {
   _serial.set_option(boost::asio::serial_port::stop_bits(_bits));
 }
+
+void serial::cancel() {
+  _serial.cancel();
+}
 } // namespace util
 } // namespace ai
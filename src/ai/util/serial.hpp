@@ -53,6 +53,18 @@ public:
     return write(boost::asio::buffer(std::forward<Buffer>(_buffer), _size));
   }
 
+  /// @brief           バッファの内容を全て非同期に書き込む
+  /// @param buffer    書き込むデータ (handlerが呼ばれるまで有効でなければならない)
+  /// @param handler   書き込み終えたとき, io_serviceのスレッドで
+  ///                  (const boost::system::error_code&, std::size_t)を引数に呼ばれる
+  template <class ConstBufferSequence, class Handler>
+  void asyncWrite(const ConstBufferSequence& _buffer, Handler&& _handler) {
+    boost::asio::async_write(_serial, _buffer, std::forward<Handler>(_handler));
+  }
+
+  /// @brief           実行中の非同期操作を中止する
+  void cancel();
+
 private:
   boost::asio::serial_port _serial;
 };
@@ -0,0 +1,89 @@
+#ifndef AI_UTIL_SPSC_QUEUE_HPP_
+#define AI_UTIL_SPSC_QUEUE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace ai {
+namespace util {
+
+/// @class   spscQueue
+/// @brief   1つのスレッドが追加し, 別の1つのスレッドが取り出す固定長のキュー
+///
+/// ロックを使わずに追加と取り出しができる.
+/// 要素は作るときに全て確保しておき, 追加ではコピー代入, 取り出しではswapで受け渡すので,
+/// std::vectorのような要素も一度大きくなった後は動的なメモリ確保なしで使い回せる.
+///
+/// tryPush()を呼ぶスレッドとtryPop()を呼ぶスレッドは, それぞれ1つでなければならない
+template <class T>
+class spscQueue {
+public:
+  /// @param capacity  キューに入れられる要素の数 (0なら1として扱う)
+  explicit spscQueue(std::size_t _capacity)
+      : slots_(std::max<std::size_t>(_capacity, 1) + 1), head_(0), tail_(0) {}
+
+  spscQueue(const spscQueue&) = delete;
+  spscQueue& operator=(const spscQueue&) = delete;
+
+  /// @brief           キューに入れられる要素の数を返す
+  std::size_t capacity() const {
+    return slots_.size() - 1;
+  }
+
+  /// @brief           キューに入っている要素の数を返す
+  ///
+  /// 他のスレッドが操作している間は, 呼び出した時点前後のいずれかの値になる
+  std::size_t size() const {
+    const auto tail = tail_.load(std::memory_order_acquire);
+    const auto head = head_.load(std::memory_order_acquire);
+    return tail >= head ? tail - head : tail + slots_.size() - head;
+  }
+
+  /// @brief           キューが空か
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+  }
+
+  /// @brief           要素を末尾に追加する
+  /// @return          キューが一杯で追加できなければfalse
+  bool tryPush(const T& _value) {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto next = increment(tail);
+    if (next == head_.load(std::memory_order_acquire)) return false;
+    slots_[tail] = _value;
+    tail_.store(next, std::memory_order_release);
+    return true;
+  }
+
+  /// @brief           先頭の要素を取り出す
+  /// @param value     取り出した要素 (元の値はキューの領域に残り, 次の追加で上書きされる)
+  /// @return          キューが空で取り出せなければfalse
+  bool tryPop(T& _value) {
+    const auto head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) return false;
+    using std::swap;
+    swap(_value, slots_[head]);
+    head_.store(increment(head), std::memory_order_release);
+    return true;
+  }
+
+private:
+  std::size_t increment(std::size_t _index) const {
+    return _index + 1 == slots_.size() ? 0 : _index + 1;
+  }
+
+  /// 1つは空けておき, headとtailが等しいときを空, tailの次がheadのときを一杯とする
+  std::vector<T> slots_;
+  /// 次に取り出す位置 (取り出すスレッドだけが書き換える)
+  alignas(64) std::atomic<std::size_t> head_;
+  /// 次に追加する位置 (追加するスレッドだけが書き換える)
+  alignas(64) std::atomic<std::size_t> tail_;
+};
+
+} // namespace util
+} // namespace ai
+
+#endif // AI_UTIL_SPSC_QUEUE_HPP_
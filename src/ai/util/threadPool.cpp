@@ -0,0 +1,51 @@
+#include <algorithm>
+
+#include "ai/util/threadPool.hpp"
+
+namespace ai {
+namespace util {
+
+threadPool::threadPool(std::size_t _threads) : stopping_(false) {
+  const auto n = std::max<std::size_t>(_threads, 1);
+  workers_.reserve(n);
+  for (auto i = 0u; i < n; ++i) workers_.emplace_back([this] { run(); });
+}
+
+threadPool::~threadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  for (auto& w : workers_) w.join();
+}
+
+std::size_t threadPool::size() const {
+  return workers_.size();
+}
+
+void threadPool::post(std::function<void()> _task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(_task));
+  }
+  cv_.notify_one();
+}
+
+void threadPool::run() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+      // 停止要求があっても, 残っている処理は全て実行する
+      if (tasks_.empty()) return;
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+} // namespace util
+} // namespace ai
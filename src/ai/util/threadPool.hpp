@@ -0,0 +1,50 @@
+#ifndef AI_UTIL_THREAD_POOL_HPP_
+#define AI_UTIL_THREAD_POOL_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ai {
+namespace util {
+
+/// @class   threadPool
+/// @brief   固定数のワーカースレッドで処理を実行する
+///
+/// post()された処理は, 空いているワーカーによって追加された順に実行される.
+/// デストラクタはキューに残っている処理を全て実行し終えるまで待つ
+class threadPool {
+public:
+  /// @param threads   ワーカースレッドの数 (0なら1として扱う)
+  explicit threadPool(std::size_t _threads);
+
+  threadPool(const threadPool&) = delete;
+  threadPool& operator=(const threadPool&) = delete;
+
+  ~threadPool();
+
+  /// @brief           ワーカースレッドの数を返す
+  std::size_t size() const;
+
+  /// @brief           処理を追加する
+  /// @param task      ワーカースレッドで実行する処理 (例外を投げてはならない)
+  void post(std::function<void()> _task);
+
+private:
+  void run();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool stopping_;
+  std::vector<std::thread> workers_;
+};
+
+} // namespace util
+} // namespace ai
+
+#endif // AI_UTIL_THREAD_POOL_HPP_
@@ -0,0 +1,77 @@
+#ifndef AI_UTIL_XOSHIRO_HPP_
+#define AI_UTIL_XOSHIRO_HPP_
+
+#include <array>
+#include <limits>
+#include <stdint.h>
+
+namespace ai {
+namespace util {
+
+/// @class   xoshiro
+/// @brief   xoshiro256**による擬似乱数生成器
+///
+/// std::mt19937より状態が小さく高速で, UniformRandomBitGeneratorの要件を満たす.
+/// 同じシードからは常に同じ系列が得られるので, 探索の再現に使える
+class xoshiro {
+public:
+  using result_type = uint64_t;
+
+  /// @param seed      シード (splitmix64で256bitの状態に展開する)
+  explicit xoshiro(uint64_t _seed = 0) {
+    seed(_seed);
+  }
+
+  /// @param state     内部状態 (全て0であってはならない)
+  explicit xoshiro(const std::array<uint64_t, 4>& _state) : state_(_state) {}
+
+  /// @brief           シードを設定し直す
+  void seed(uint64_t _seed) {
+    for (auto& s : state_) {
+      _seed += 0x9e3779b97f4a7c15;
+      auto z = _seed;
+      z      = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+      z      = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+      s      = z ^ (z >> 31);
+    }
+  }
+
+  static constexpr result_type min() {
+    return std::numeric_limits<result_type>::min();
+  }
+
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() {
+    const auto result = rotl(state_[1] * 5, 7) * 9;
+    const auto t      = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = rotl(state_[3], 45);
+    return result;
+  }
+
+  /// @brief           [min, max)の一様乱数を返す
+  ///
+  /// 上位53bitから作るので, 標準ライブラリの実装によらず同じ値になる
+  double uniform(double _min, double _max) {
+    return _min + (_max - _min) * ((*this)() >> 11) * 0x1.0p-53;
+  }
+
+private:
+  static constexpr uint64_t rotl(uint64_t _x, int _k) {
+    return (_x << _k) | (_x >> (64 - _k));
+  }
+
+  std::array<uint64_t, 4> state_;
+};
+
+} // namespace util
+} // namespace ai
+
+#endif // AI_UTIL_XOSHIRO_HPP_
@@ -19,7 +19,9 @@
 #include "ai/model/updater/refbox.hpp"
 #include "ai/receiver/refbox.hpp"
 #include "ai/receiver/vision.hpp"
+#include "ai/sender/async.hpp"
 #include "ai/sender/grsim.hpp"
+#include "ai/sender/radio.hpp"
 #include "ai/game/action/move.hpp"
 #include "ai/filter/va.hpp"
 #include "ai/filter/observer/ball.hpp"
@@ -52,10 +54,14 @@ static constexpr short localRefboxPort      = 10088;
 static constexpr bool isGrsim           = true;
 static constexpr char grsimAddress[]    = "127.0.0.1";
 static constexpr short grsimCommandPort = 20011;
+static constexpr char radioDevice[]     = "/dev/ttyUSB0";
+static constexpr unsigned int radioBaud = 115200;
 
 // 周期の設定
 using fps60 = std::chrono::duration<util::TimePointType::rep, std::ratio<1, 60>>;
 static constexpr auto cycle = std::chrono::duration_cast<util::DurationType>(fps60{1});
+// Controllerを並列に計算するスレッドの数
+static constexpr std::size_t controllerThreads = 4;
 
 class gameRunner {
 public:
@@ -69,7 +75,7 @@ public:
         updaterRefbox_(_refbox),
         isGlobalRefbox_{true},
         sender_(_sender),
-        driver_(driverIo_, cycle, updaterWorld_, teamColor_),
+        driver_(driverIo_, cycle, updaterWorld_, teamColor_, controllerThreads),
         activeRobots_({
             0u,
             1u,
@@ -196,9 +202,16 @@ private:
         } else {
           std::unique_lock<std::shared_timed_mutex> lock(mutex_);
           const auto prevCmd = refbox_.command();
-          world_             = updaterWorld_.value();
           refbox_            = updaterRefbox_.value();
 
+          // Driverが送信期限まで予測したWorldModelを使い, 制御と時刻を揃える
+          // 新しい予測が公開されていたときだけ更新する
+          auto predicted = driver_.predicted();
+          if (predicted != predicted_) {
+            world_     = *predicted;
+            predicted_ = std::move(predicted);
+          }
+
           const auto currentCmd  = refbox_.command();
           const auto penaltyKick = teamColor_ == model::teamColor::Yellow
                                        ? model::refbox::gameCommand::PreparePenaltyYellow
@@ -247,6 +260,7 @@ private:
   ai::driver driver_;
 
   model::world world_;
+  std::shared_ptr<const model::world> predicted_;
   model::refbox refbox_;
   std::vector<uint32_t> activeRobots_;
 };
@@ -531,7 +545,9 @@ auto main(int argc, char** argv) -> int {
 
     // Vision receiverの設定
     std::atomic<bool> visionReceived{false};
-    receiver::vision vision{receiverIo, "0.0.0.0", visionAddress, visionPort};
+    // 複数のカメラのパケットはほぼ同時に届くので, まとめて受信する
+    receiver::vision vision{receiverIo, "0.0.0.0", visionAddress, visionPort,
+                            util::multicast::receiver::receiveMode::batch};
     vision.onReceive([&updaterWorld, &visionReceived](auto&& p) {
       if (!visionReceived) {
         // 最初に受信したときにメッセージを表示する
@@ -570,9 +586,18 @@ auto main(int argc, char** argv) -> int {
 
     // Senderの設定
     std::shared_ptr<sender::base> sender{};
-    sender = std::make_shared<sender::grsim>(receiverIo, grsimAddress, grsimCommandPort);
-    std::cout << boost::format("sender: grSim (%1%:%2%)") % grsimAddress % grsimCommandPort
-              << std::endl;
+    if (isGrsim) {
+      sender = std::make_shared<sender::grsim>(receiverIo, grsimAddress, grsimCommandPort);
+      // 制御周期のスレッドが送信を待たないよう, 送信は専用のスレッドで行う
+      sender = std::make_shared<sender::async>(sender);
+      std::cout << boost::format("sender: grSim (%1%:%2%)") % grsimAddress % grsimCommandPort
+                << std::endl;
+    } else {
+      // 無線機への書き込みはreceiverIoのスレッドで非同期に行われる
+      sender = std::make_shared<sender::radio>(receiverIo, radioDevice, radioBaud);
+      std::cout << boost::format("sender: radio (%1%, %2% bps)") % radioDevice % radioBaud
+                << std::endl;
+    }
 
     auto app = Gtk::Application::create(argc, argv, "org.gtkmm.example");
     gameRunner runner{updaterWorld, updaterRefbox, sender};
@@ -1,8 +1,13 @@
 #define BOOST_TEST_DYN_LINK
 
+#include <atomic>
 #include <chrono>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 #include <boost/asio.hpp>
 #include <boost/test/unit_test.hpp>
 
@@ -10,6 +15,8 @@
 #include "ai/driver.hpp"
 #include "ai/model/teamColor.hpp"
 #include "ai/model/updater/world.hpp"
+#include "ai/sender/base.hpp"
+#include "ssl-protos/vision/wrapper.pb.h"
 
 using namespace std::chrono_literals;
 namespace controller = ai::controller;
@@ -114,4 +121,185 @@ BOOST_AUTO_TEST_CASE(velocityLimit) {
   BOOST_TEST(c2.velocityLimit() == std::numeric_limits<double>::max());
 }
 
+// 制御周期の処理の統計が取れる
+BOOST_AUTO_TEST_CASE(statistics) {
+  boost::asio::io_service ioService{};
+  ai::model::updater::world wu{};
+  ai::driver d{ioService, 10ms, wu, model::teamColor::Blue};
+  d.realtime(0, 0);
+
+  std::thread t{[&ioService] { ioService.run(); }};
+  std::this_thread::sleep_for(200ms);
+  // 制御周期を回すスレッドを止めて, 周期を飛ばさせる
+  ioService.post([] { std::this_thread::sleep_for(55ms); });
+  std::this_thread::sleep_for(200ms);
+  ioService.stop();
+  t.join();
+
+  const auto s = d.statistics();
+  BOOST_TEST(!s.realtime);
+  BOOST_TEST(s.overruns >= 1u);
+  BOOST_TEST(s.skipped >= 3u);
+  // 周期の開始時刻は処理の遅れに関わらず一定の間隔で進む
+  BOOST_TEST(s.cycles + s.skipped >= 30u);
+  BOOST_TEST(s.cycles + s.skipped <= 42u);
+  for (const auto* h : {&s.wakeup, &s.snapshot, &s.controller, &s.send, &s.signal, &s.total}) {
+    BOOST_TEST(h->count() == s.cycles);
+  }
+  BOOST_TEST((s.wakeup.max() >= 40ms));
+
+  d.resetStatistics();
+  BOOST_TEST(d.statistics().cycles == 0u);
+  BOOST_TEST(d.statistics().total.count() == 0u);
+}
+
+// 計算したスレッドを記録し, 少し時間のかかるController
+struct slowController : public controller::base {
+  std::mutex& mutex;
+  std::set<std::thread::id>& threads;
+  bool fail;
+
+  slowController(std::mutex& _mutex, std::set<std::thread::id>& _threads, bool _fail = false)
+      : mutex(_mutex), threads(_threads), fail(_fail) {}
+
+protected:
+  controller::velocity update(const model::robot&, const controller::position&) {
+    return {};
+  }
+  controller::velocity update(const model::robot&, const controller::velocity&) {
+    if (fail) throw std::runtime_error("slowController");
+    std::this_thread::sleep_for(2ms);
+    std::lock_guard<std::mutex> lock(mutex);
+    threads.insert(std::this_thread::get_id());
+    return {1.0, 2.0, 3.0};
+  }
+};
+
+// 送信された命令とまとめて送信された回数を数えるSender
+struct countingSender : public ai::sender::base {
+  std::atomic<int> count{0};
+  std::atomic<int> batches{0};
+
+  void sendCommand(const model::command& _command) {
+    BOOST_TEST(std::get<model::command::velocity>(_command.setpoint()).vx == 1.0);
+    ++count;
+  }
+
+  void sendCommands(const std::vector<model::command>& _commands) {
+    ++batches;
+    ai::sender::base::sendCommands(_commands);
+  }
+};
+
+// 青ロボットを11台検出させる
+static void detect(ai::model::updater::world& _wu) {
+  ssl_protos::vision::WrapperPacket p;
+  auto md = p.mutable_detection();
+  md->set_camera_id(0);
+  for (auto id = 0; id < 11; ++id) {
+    auto r = md->add_robots_blue();
+    r->set_robot_id(id);
+    r->set_x(500 * id);
+    r->set_y(0);
+    r->set_orientation(0);
+    r->set_confidence(90.0);
+  }
+  _wu.update(p);
+}
+
+// ワーカースレッドを指定すると, 各ロボットのControllerを並列に計算する
+BOOST_AUTO_TEST_CASE(parallel) {
+  boost::asio::io_service ioService{};
+  ai::model::updater::world wu{};
+  detect(wu);
+  ai::driver d{ioService, 50ms, wu, model::teamColor::Blue, 4};
+
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  auto sender = std::make_shared<countingSender>();
+  for (auto id = 0u; id < 11; ++id) {
+    d.registerRobot(id, std::make_unique<slowController>(mutex, threads), sender);
+    ai::model::command command{id};
+    command.vel({0.0, 0.0, 0.0});
+    d.updateCommand(command);
+  }
+
+  std::thread t{[&ioService] { ioService.run(); }};
+  std::this_thread::sleep_for(300ms);
+  ioService.stop();
+  const auto loop = t.get_id();
+  t.join();
+
+  // 全てのロボットの命令が1周期に1回まとめて送信される
+  const auto s = d.statistics();
+  BOOST_TEST(s.cycles >= 3u);
+  BOOST_TEST(sender->count == static_cast<int>(11 * s.cycles));
+  BOOST_TEST(sender->batches == static_cast<int>(s.cycles));
+  // 計算はメインループとは別の複数のスレッドで行われる
+  BOOST_TEST(threads.size() > 1u);
+  BOOST_TEST(threads.count(loop) == 0u);
+  // 順に計算すれば22ms以上かかる
+  BOOST_TEST((s.controller.percentile(0.5) < 15ms));
+}
+
+// シグナルで呼ばれた関数の中からDriverを操作しても, 周期の処理と競合しない
+BOOST_AUTO_TEST_CASE(reentrant, *boost::unit_test::timeout(10)) {
+  boost::asio::io_service ioService{};
+  ai::model::updater::world wu{};
+  detect(wu);
+  ai::driver d{ioService, 10ms, wu, model::teamColor::Blue};
+
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  auto sender = std::make_shared<countingSender>();
+  for (auto id = 0u; id < 2; ++id) {
+    d.registerRobot(id, std::make_unique<slowController>(mutex, threads), sender);
+    ai::model::command command{id};
+    command.vel({0.0, 0.0, 0.0});
+    d.updateCommand(command);
+  }
+
+  // 周期の処理の中から命令を更新し, 計算の終わったロボットの登録を解除する
+  std::atomic<int> unregistered{0};
+  d.onCommandUpdated([&d, &unregistered](const model::command& _command) {
+    if (!d.registered(_command.id())) return;
+    if (_command.id() == 1) {
+      d.unregisterRobot(1);
+      ++unregistered;
+    } else {
+      d.updateCommand(_command);
+    }
+  });
+
+  std::thread t{[&ioService] { ioService.run(); }};
+  std::this_thread::sleep_for(100ms);
+  ioService.stop();
+  t.join();
+
+  const auto s = d.statistics();
+  BOOST_TEST(s.cycles >= 2u);
+  BOOST_TEST(d.registered(0));
+  BOOST_TEST(!d.registered(1));
+  BOOST_TEST(unregistered == 1);
+  // 登録を解除したロボットの命令は最初の周期でしか送られない
+  BOOST_TEST(sender->count == static_cast<int>(s.cycles + 1));
+}
+
+// ワーカースレッドで投げられた例外はio_serviceを回しているスレッドで投げ直される
+BOOST_AUTO_TEST_CASE(parallel_exception) {
+  boost::asio::io_service ioService{};
+  ai::model::updater::world wu{};
+  detect(wu);
+  ai::driver d{ioService, 10ms, wu, model::teamColor::Blue, 2};
+
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  d.registerRobot(0, std::make_unique<slowController>(mutex, threads, true), nullptr);
+  ai::model::command command{0};
+  command.vel({0.0, 0.0, 0.0});
+  d.updateCommand(command);
+
+  BOOST_CHECK_THROW(ioService.run(), std::runtime_error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
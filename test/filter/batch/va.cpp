@@ -0,0 +1,89 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <array>
+#include <random>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/filter/batch/va.hpp"
+#include "ai/filter/va.hpp"
+#include "ai/model/robotStates.hpp"
+
+using namespace std::chrono_literals;
+
+namespace filter = ai::filter;
+namespace model  = ai::model;
+
+BOOST_AUTO_TEST_SUITE(batch_va)
+
+BOOST_AUTO_TEST_CASE(compare_with_scalar) {
+  constexpr auto capacity = model::robotStates::capacity;
+
+  std::mt19937 mt{0};
+  std::uniform_real_distribution<double> pos(-6000, 6000);
+  std::uniform_real_distribution<double> angle(-10, 10);
+  std::bernoulli_distribution isUpdated(0.7);
+
+  // スロットごとにスカラー版のfilter::vaを用意し, 同じ値を与えて結果を比較する
+  std::array<filter::va<model::robot>, capacity> scalar{};
+  filter::batch::va batch{};
+  model::robotStates states{};
+
+  auto t = ai::util::TimePointType{} + 1s;
+  for (auto frame = 0; frame < 100; ++frame) {
+    // 同じ時刻に2回更新されるケースも含める
+    if (frame % 10 != 5) t += 16ms;
+
+    model::robotStates::MaskType updated;
+    std::array<model::robot, capacity> expected{};
+    for (auto i = 0u; i < capacity; ++i) {
+      updated(i) = isUpdated(mt);
+      if (!updated(i)) continue;
+      const model::robot r{i, pos(mt), pos(mt), angle(mt)};
+      states.set(i, r);
+      expected[i] = scalar[i].update(r, t);
+    }
+
+    batch.update(states, updated, t);
+
+    for (auto i = 0u; i < capacity; ++i) {
+      if (!updated(i)) continue;
+      const auto r = states.get(i);
+      BOOST_TEST(r.x() == expected[i].x());
+      BOOST_TEST(r.y() == expected[i].y());
+      BOOST_TEST(r.theta() == expected[i].theta());
+      BOOST_TEST(r.vx() == expected[i].vx());
+      BOOST_TEST(r.vy() == expected[i].vy());
+      BOOST_TEST(r.omega() == expected[i].omega());
+      BOOST_TEST(r.ax() == expected[i].ax());
+      BOOST_TEST(r.ay() == expected[i].ay());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(reset) {
+  filter::batch::va batch{};
+  model::robotStates states{};
+  model::robotStates::MaskType updated;
+  updated.setConstant(false);
+  updated(3) = true;
+
+  auto t = ai::util::TimePointType{};
+  states.set(3, model::robot{3, 0, 0, 0});
+  batch.update(states, updated, t);
+
+  t += 1s;
+  states.set(3, model::robot{3, 100, 200, 0});
+  batch.update(states, updated, t);
+  BOOST_TEST(states.vx()(3) == 100);
+  BOOST_TEST(states.vy()(3) == 200);
+
+  // resetされたスロットは初めて更新されたときと同様に扱われる
+  batch.reset(3);
+  t += 1s;
+  states.set(3, model::robot{3, 300, 400, 0});
+  batch.update(states, updated, t);
+  BOOST_TEST(states.vx()(3) == 0);
+  BOOST_TEST(states.vy()(3) == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,104 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <cmath>
+#include <random>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/filter/kalman/ball.hpp"
+#include "ai/model/updater/ball.hpp"
+
+using namespace std::chrono_literals;
+
+namespace filter = ai::filter;
+namespace model  = ai::model;
+namespace util   = ai::util;
+
+BOOST_AUTO_TEST_SUITE(kalman_ball)
+
+// 静止しているボールの位置がそのまま推定できる
+BOOST_AUTO_TEST_CASE(rest) {
+  filter::kalman::ball kf{};
+
+  std::mt19937 mt{0};
+  std::normal_distribution<double> noise(0, 3.0);
+
+  auto t = util::TimePointType{};
+  model::ball result{};
+  for (auto i = 0; i < 120; ++i) {
+    result = kf.update(model::ball{1000 + noise(mt), -2000 + noise(mt)}, t);
+    t += std::chrono::duration_cast<util::DurationType>(1s) / 60;
+  }
+
+  BOOST_TEST(result.x() == 1000, boost::test_tools::tolerance(0.005));
+  BOOST_TEST(result.y() == -2000, boost::test_tools::tolerance(0.005));
+  BOOST_TEST(std::hypot(result.vx(), result.vy()) < 50);
+}
+
+// 蹴られたボールの速度に追従し, 滑りから転がりに変わったあと止まる
+BOOST_AUTO_TEST_CASE(kick) {
+  filter::kalman::ball kf{};
+
+  // 4000mm/sでx方向に蹴り, 3500mm/s^2で減速したあと5/7の速さから350mm/s^2で減速する
+  const auto v0 = 4000.0;
+  const auto v1 = v0 * 5 / 7;
+  const auto t1 = (v0 - v1) / 3500;
+  const auto x1 = (v0 + v1) / 2 * t1;
+  const auto t2 = t1 + v1 / 350;
+  auto truth    = [=](double _t) {
+    if (_t < 0) return 0.0;
+    if (_t < t1) return v0 * _t - 3500 * _t * _t / 2;
+    if (_t < t2) return x1 + v1 * (_t - t1) - 350 * (_t - t1) * (_t - t1) / 2;
+    return x1 + v1 * v1 / 700;
+  };
+
+  auto t = util::TimePointType{};
+  auto sliding = false;
+  model::ball result{};
+  for (auto i = -30; i < 60 * 10; ++i) {
+    const auto s = i / 60.0;
+    result       = kf.update(model::ball{truth(s), 0}, t);
+    t += std::chrono::duration_cast<util::DurationType>(1s) / 60;
+
+    // 蹴られてから少し経てば速度に追従している
+    if (s > 0.1 && s < t1) {
+      BOOST_TEST(result.vx() == v0 - 3500 * s, boost::test_tools::tolerance(0.1));
+      sliding |= kf.currentPhase() == filter::kalman::ball::phase::sliding;
+    }
+    if (s > t1 + 0.2 && s < t2 - 0.2) {
+      BOOST_TEST((kf.currentPhase() == filter::kalman::ball::phase::rolling));
+    }
+  }
+  BOOST_TEST(sliding);
+
+  // 最後は止まっている
+  BOOST_TEST(result.x() == truth(t2), boost::test_tools::tolerance(0.005));
+  BOOST_TEST(std::abs(result.vx()) < 10);
+  BOOST_TEST(std::abs(result.ax()) <= 350);
+}
+
+// updater::ballのFilterとして使える
+BOOST_AUTO_TEST_CASE(set_filter, *boost::unit_test::tolerance(0.05)) {
+  model::updater::ball bu;
+  bu.setFilter<filter::kalman::ball>(1.0);
+
+  for (auto i = 0; i < 120; ++i) {
+    ssl_protos::vision::DetectionFrame f;
+    f.set_camera_id(0);
+    f.set_t_capture(i / 64.0);
+
+    auto b = f.add_balls();
+    b->set_x(100);
+    b->set_y(200);
+    b->set_z(0);
+    b->set_confidence(90.0);
+
+    bu.update(f);
+  }
+
+  const auto b = bu.value();
+  BOOST_TEST(b.x() == 100.0);
+  BOOST_TEST(b.y() == 200.0);
+  BOOST_TEST(b.vx() == 0.0, boost::test_tools::tolerance(1.0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
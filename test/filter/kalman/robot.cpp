@@ -0,0 +1,122 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <cmath>
+#include <random>
+#include <boost/math/constants/constants.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/filter/kalman/robot.hpp"
+#include "ai/model/updater/robot.hpp"
+
+using namespace std::chrono_literals;
+
+namespace filter = ai::filter;
+namespace model  = ai::model;
+namespace util   = ai::util;
+
+BOOST_AUTO_TEST_SUITE(kalman_robot)
+
+// 初めてupdateが呼ばれたときは観測値をそのまま返し, 速度と加速度は0になる
+BOOST_AUTO_TEST_CASE(first_update) {
+  filter::kalman::robot kf{};
+
+  model::robot r{1, 100, 200, 0.5};
+  r.vx(1);
+  r.vy(2);
+  r.omega(3);
+  r.ax(4);
+  r.ay(5);
+  const auto result = kf.update(r, util::TimePointType{});
+
+  BOOST_TEST(result.id() == 1);
+  BOOST_TEST(result.x() == 100);
+  BOOST_TEST(result.y() == 200);
+  BOOST_TEST(result.theta() == 0.5);
+  BOOST_TEST(result.vx() == 0);
+  BOOST_TEST(result.vy() == 0);
+  BOOST_TEST(result.omega() == 0);
+  BOOST_TEST(result.ax() == 0);
+  BOOST_TEST(result.ay() == 0);
+
+  // 同じ時刻に呼ばれた場合は直前の値を返す
+  const auto same = kf.update(model::robot{1, 500, 500, 0}, util::TimePointType{});
+  BOOST_TEST(same.x() == 100);
+  BOOST_TEST(same.y() == 200);
+
+  // 初めての観測の角度も[0, 2pi)に正規化される
+  filter::kalman::robot negative{};
+  const auto wrapped = negative.update(model::robot{1, 0, 0, -0.5}, util::TimePointType{});
+  BOOST_TEST(wrapped.theta() == 2 * boost::math::double_constants::pi - 0.5);
+}
+
+// 雑音の乗った等速直線運動から速度が推定でき, 加速度はほぼ0になる
+BOOST_AUTO_TEST_CASE(constant_velocity) {
+  filter::kalman::robot kf{};
+
+  std::mt19937 mt{0};
+  std::normal_distribution<double> noise(0, 2.0);
+
+  auto t = util::TimePointType{};
+  model::robot result{};
+  for (auto i = 0; i < 180; ++i) {
+    const auto s = i / 60.0;
+    model::robot r{0, 1000 * s + noise(mt), -500 * s + noise(mt), 0};
+    result = kf.update(r, t);
+    t += std::chrono::duration_cast<util::DurationType>(1s) / 60;
+  }
+
+  BOOST_TEST(result.x() == 1000 * 179 / 60.0, boost::test_tools::tolerance(0.005));
+  BOOST_TEST(result.vx() == 1000, boost::test_tools::tolerance(0.05));
+  BOOST_TEST(result.vy() == -500, boost::test_tools::tolerance(0.05));
+  BOOST_TEST(std::abs(result.ax()) < 500);
+  BOOST_TEST(std::abs(result.ay()) < 500);
+}
+
+// 角度が-pi, piの境界をまたいでも角速度が正しく推定でき, 推定値は[0, 2pi)で返る
+BOOST_AUTO_TEST_CASE(angle_wrap) {
+  using boost::math::double_constants::pi;
+  filter::kalman::robot kf{};
+
+  auto t = util::TimePointType{};
+  for (auto i = 0; i < 300; ++i) {
+    const auto theta = std::remainder(2.0 + 3.0 * i / 60.0, 2 * pi);
+    const auto r     = kf.update(model::robot{0, 0, 0, theta}, t);
+    t += std::chrono::duration_cast<util::DurationType>(1s) / 60;
+
+    BOOST_TEST(r.theta() >= 0.0);
+    BOOST_TEST(r.theta() < 2 * pi);
+    if (i > 60) {
+      BOOST_TEST(r.omega() == 3.0, boost::test_tools::tolerance(0.01));
+      BOOST_TEST(std::remainder(r.theta() - theta, 2 * pi) == 0.0,
+                 boost::test_tools::tolerance(0.01));
+    }
+  }
+}
+
+// updater::robotのデフォルトのFilterとして使える
+BOOST_AUTO_TEST_CASE(default_filter, *boost::unit_test::tolerance(0.05)) {
+  model::updater::robot<model::teamColor::Blue> ru;
+  ru.setDefaultFilter<filter::kalman::robot>(1.0, 0.01);
+
+  for (auto i = 0; i < 120; ++i) {
+    ssl_protos::vision::DetectionFrame f;
+    f.set_camera_id(0);
+    f.set_t_capture(i / 64.0);
+
+    auto r = f.add_robots_blue();
+    r->set_robot_id(3);
+    r->set_x(10 + 640 * i / 64.0);
+    r->set_y(20);
+    r->set_orientation(0);
+    r->set_confidence(90.0);
+
+    ru.update(f);
+  }
+
+  const auto robots = ru.value();
+  BOOST_TEST(robots.count(3) == 1);
+  BOOST_TEST(robots.at(3).vx() == 640.0);
+  BOOST_TEST(robots.at(3).vy() == 0.0, boost::test_tools::tolerance(1.0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
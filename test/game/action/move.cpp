@@ -0,0 +1,55 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <cmath>
+#include <variant>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/game/action/move.hpp"
+#include "ai/model/world.hpp"
+
+namespace action = ai::game::action;
+namespace model  = ai::model;
+
+BOOST_AUTO_TEST_SUITE(move)
+
+// (-600, 0)の青ロボットと目標位置(600, 0)の中間に, 黄ロボットが速度(0, vy)で動いている状況
+static model::world worldWith(double _vy) {
+  model::world world{};
+  world.robotsBlue(model::world::RobotsList{{0, model::robot{0, -600.0, 0.0}}});
+  model::robot enemy{1, 0.0, 0.0};
+  enemy.vy(_vy);
+  world.robotsYellow(model::world::RobotsList{{1, enemy}});
+  world.ball(model::ball{0.0, -3000.0});
+  return world;
+}
+
+// 目標位置へ向かうときに最初に向かう位置が, 目標位置の近くになった回数
+// (遮るものがなければ最初に向かう位置は目標位置に最も近いノードになる)
+static int straightCount(const model::world& _world) {
+  auto count = 0;
+  for (auto i = 0; i < 20; ++i) {
+    action::move move{_world, false, 0};
+    move.moveTo(600.0, 0.0);
+    const auto command = move.execute();
+    BOOST_TEST(!move.finished());
+    const auto& target = std::get<model::command::position>(command.setpoint());
+    // 自身を障害物として扱っていれば, 抜け出すために(-400, 0)へ向かってしまう
+    BOOST_TEST(std::hypot(target.x + 400.0, target.y) > 1.0);
+    if (std::hypot(target.x - 600.0, target.y) < 500.0) ++count;
+  }
+  return count;
+}
+
+// 直線上で止まっているロボットは避ける
+BOOST_AUTO_TEST_CASE(static_obstacle) {
+  BOOST_TEST(straightCount(worldWith(0.0)) == 0);
+}
+
+// 今は直線上にいても, 通る頃には離れているロボットは避けなくてよい
+BOOST_AUTO_TEST_CASE(moving_obstacle) {
+  // 1500mm/sで直進すると, 0.14s後に最も近づくが中心間の距離は480mmある
+  static_assert(action::move::robotSpeed == 1500.0);
+  BOOST_TEST(straightCount(worldWith(2000.0)) >= 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,159 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/model/field.hpp"
+#include "ai/model/fieldMap.hpp"
+#include "ai/model/world.hpp"
+
+namespace model = ai::model;
+
+BOOST_AUTO_TEST_SUITE(field_map)
+
+// 既定のフィールド (12000x9000, ペナルティエリアは1200x2400)
+BOOST_AUTO_TEST_CASE(distance, *boost::unit_test::tolerance(1e-3)) {
+  const model::fieldMap map{model::field{}};
+  BOOST_TEST(map.resolution() == 50.0);
+
+  // 中央は短辺側の境界に近い
+  BOOST_TEST(map.boundary(0.0, 0.0) == 4500.0);
+  BOOST_TEST(map.penalty(0.0, 0.0) == 4800.0);
+  BOOST_TEST(map.distance(0.0, 0.0) == 4500.0);
+
+  // ペナルティエリアの中は負になる
+  BOOST_TEST(map.penalty(5500.0, 0.0) == -700.0);
+  BOOST_TEST(map.penalty(-5500.0, 1000.0) == -200.0);
+  BOOST_TEST(map.distance(5500.0, 0.0) == -700.0);
+  // ペナルティエリアの角の外側
+  BOOST_TEST(map.penalty(4500.0, 1600.0) == 500.0);
+
+  // フィールドの外は負になる
+  BOOST_TEST(map.boundary(6500.0, 0.0) == -500.0);
+  BOOST_TEST(map.boundary(0.0, -4700.0) == -200.0);
+  // 格子の外でも求められる
+  BOOST_TEST(map.boundary(0.0, 10000.0) == -5500.0);
+  BOOST_TEST(map.penalty(0.0, 10000.0) == std::hypot(4800.0, 8800.0));
+}
+
+// 格子点の間でも, 直接計算した距離との差は小さい
+BOOST_AUTO_TEST_CASE(interpolation) {
+  const model::field field{};
+  const model::fieldMap map{field};
+
+  std::mt19937 mt{0};
+  std::uniform_real_distribution<double> x(-8000.0, 8000.0);
+  std::uniform_real_distribution<double> y(-6000.0, 6000.0);
+  for (auto i = 0; i < 10000; ++i) {
+    const auto px = x(mt);
+    const auto py = y(mt);
+    const auto ax = std::abs(px) - field.xMax();
+    const auto ay = std::abs(py) - field.yMax();
+
+    // 直接計算した境界までの距離
+    const auto boundary = ax <= 0.0 && ay <= 0.0
+                              ? -std::max(ax, ay)
+                              : -std::hypot(std::max(ax, 0.0), std::max(ay, 0.0));
+    // 角の近くでは双線形補間の誤差が格子の間隔程度になる
+    BOOST_TEST(std::abs(map.boundary(px, py) - boundary) < map.resolution());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(gradient, *boost::unit_test::tolerance(1e-6)) {
+  const model::fieldMap map{model::field{}};
+
+  // 境界から離れる向きを指す
+  const auto g1 = map.gradient(0.0, 4000.0);
+  BOOST_TEST(g1.x() == 0.0);
+  BOOST_TEST(g1.y() == -1.0);
+  const auto g2 = map.gradient(-5900.0, 3000.0);
+  BOOST_TEST(g2.x() == 1.0);
+  BOOST_TEST(g2.y() == 0.0);
+  // ペナルティエリアの中では外へ向かう
+  const auto g3 = map.gradient(5000.0, 25.0);
+  BOOST_TEST(g3.x() == -1.0);
+  BOOST_TEST(g3.y() == 0.0);
+  // 格子の外
+  const auto g4 = map.gradient(0.0, -10000.0);
+  BOOST_TEST(g4.x() == 0.0);
+  BOOST_TEST(g4.y() == 1.0);
+}
+
+// 長方形としての判定は, 角の付近でも軸ごとの比較になる
+BOOST_AUTO_TEST_CASE(rectangle) {
+  const model::fieldMap map{model::field{}};
+
+  BOOST_TEST(!map.outside(0.0, 0.0, 100.0));
+  BOOST_TEST(!map.outside(6080.0, 4580.0, 100.0));
+  BOOST_TEST(map.outside(6120.0, 0.0, 100.0));
+  BOOST_TEST(map.outside(0.0, -4620.0, 100.0));
+  // 角からの距離は113mmだが, 長方形の内側
+  BOOST_TEST(map.boundary(6080.0, 4580.0) < -100.0);
+
+  BOOST_TEST(map.inPenalty(5000.0, 0.0, 0.0));
+  BOOST_TEST(!map.inPenalty(4700.0, 0.0, 0.0));
+  BOOST_TEST(map.inPenalty(-4720.0, 1280.0, 100.0));
+  BOOST_TEST(!map.inPenalty(-4720.0, 1320.0, 100.0));
+  // 角からの距離は113mmだが, 長方形の内側
+  BOOST_TEST(map.penalty(4720.0, 1280.0) > 100.0);
+  BOOST_TEST(map.inPenalty(4720.0, 1280.0, 100.0));
+}
+
+// 同じ形状のフィールドには同じマップが使われる
+BOOST_AUTO_TEST_CASE(update) {
+  model::field f1{};
+  const auto m1 = model::fieldMap::standard();
+  BOOST_TEST(m1 == model::fieldMap::standard());
+  BOOST_TEST(m1->sameGeometry(f1));
+  BOOST_TEST(model::fieldMap::update(m1, f1) == m1);
+
+  // 距離に関係しない値が変わっても作り直さない
+  f1.centerRadius(100);
+  BOOST_TEST(model::fieldMap::update(m1, f1) == m1);
+
+  model::field f2{};
+  f2.length(9000);
+  f2.width(6000);
+  const auto m2 = model::fieldMap::update(m1, f2);
+  BOOST_TEST(m1 != m2);
+  BOOST_TEST(!m1->sameGeometry(f2));
+  BOOST_TEST(m2->field().length() == 9000);
+  BOOST_TEST(m2->boundary(0.0, 0.0) == 3000.0);
+  BOOST_TEST(model::fieldMap::update(nullptr, f2) != nullptr);
+}
+
+// WorldModelは設定されているフィールドのマップを持ち, コピーしたもの同士で共有する
+BOOST_AUTO_TEST_CASE(world_map) {
+  model::world w1{};
+  BOOST_TEST(w1.fieldMap() == model::fieldMap::standard());
+
+  model::field f2{};
+  f2.length(9000);
+  f2.width(6000);
+  w1.field(f2);
+  const auto m2 = w1.fieldMap();
+  BOOST_TEST(m2 != model::fieldMap::standard());
+  BOOST_TEST(m2->field().width() == 6000);
+
+  // 形状が同じなら作り直さない
+  f2.goalWidth(1200);
+  w1.field(f2);
+  BOOST_TEST(w1.fieldMap() == m2);
+
+  const model::world w2{w1};
+  BOOST_TEST(w2.fieldMap() == m2);
+  model::world w3{};
+  w3 = w1;
+  BOOST_TEST(w3.fieldMap() == m2);
+
+  // 渡したマップの形状が違えば, フィールドに合わせて作り直す
+  const model::world w4{model::field{f2}, model::ball{}, {}, {}, m2};
+  BOOST_TEST(w4.fieldMap() == m2);
+  const model::world w5{model::field{}, model::ball{}, {}, {}, m2};
+  BOOST_TEST(w5.fieldMap() != m2);
+  BOOST_TEST(w5.fieldMap()->sameGeometry(model::field{}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,167 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <chrono>
+#include <boost/math/constants/constants.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/model/predictor.hpp"
+
+using namespace std::chrono_literals;
+
+namespace model = ai::model;
+namespace util  = ai::util;
+
+// 時間[s]をutil::DurationTypeに変換する
+util::DurationType sec(double _t) {
+  return std::chrono::duration_cast<util::DurationType>(std::chrono::duration<double>{_t});
+}
+
+BOOST_AUTO_TEST_SUITE(predictor)
+
+// 予測する時刻がキャプチャ時刻以前なら値を変えない
+BOOST_AUTO_TEST_CASE(no_horizon) {
+  model::predictor p{};
+
+  model::world w{};
+  model::robot r{1, 100, 200, 0.5};
+  r.vx(1000);
+  w.robotsBlue(model::world::RobotsList{{1, r}});
+  const auto t0 = util::TimePointType{} + 10s;
+  w.captureTime(t0);
+
+  const auto result = p.predict(w, model::teamColor::Blue, t0 - 1ms);
+  BOOST_TEST(result.robotsBlue().at(1).x() == 100);
+  BOOST_TEST((result.captureTime() == t0 - 1ms));
+}
+
+// 指令の履歴がないロボットは等速度で, ボールは減速しながら進む
+BOOST_AUTO_TEST_CASE(constant_velocity, *boost::unit_test::tolerance(0.0000001)) {
+  model::predictor p{};
+
+  model::world w{};
+  model::robot r{3, 100, 200, 6.0};
+  r.vx(1000);
+  r.vy(-500);
+  r.omega(2.0);
+  w.robotsYellow(model::world::RobotsList{{3, r}});
+
+  model::ball b{0, 0};
+  b.vx(600);
+  b.vy(800);
+  w.ball(b);
+
+  const auto t0 = util::TimePointType{} + 10s;
+  w.captureTime(t0);
+
+  const auto result = p.predict(w, model::teamColor::Blue, t0 + 250ms);
+  BOOST_TEST((result.captureTime() == t0 + 250ms));
+
+  const auto r2 = result.robotsYellow().at(3);
+  BOOST_TEST(r2.x() == 350);
+  BOOST_TEST(r2.y() == 75);
+  // 角度は観測値と同じく[0, 2pi)に正規化される
+  BOOST_TEST(r2.theta() == 6.5 - 2 * boost::math::double_constants::pi);
+  BOOST_TEST(r2.vx() == 1000);
+
+  // 1000mm/sで進むボールは350mm/s^2で減速する
+  const auto b2 = result.ball();
+  BOOST_TEST(b2.vx() == 600 * (1000 - 350 * 0.25) / 1000);
+  BOOST_TEST(b2.vy() == 800 * (1000 - 350 * 0.25) / 1000);
+  BOOST_TEST(b2.x() == 0.6 * (1000 * 0.25 - 350 * 0.25 * 0.25 / 2));
+
+  // 減速しきったボールはそこで止まる
+  b.vx(70);
+  b.vy(0);
+  w.ball(b);
+  const auto stopped = p.predict(w, model::teamColor::Blue, t0 + 500ms).ball();
+  BOOST_TEST(stopped.vx() == 0);
+  BOOST_TEST(stopped.x() == 70 * 0.2 / 2);
+
+  // 上限を超えた時間は進めない
+  const auto far = p.predict(w, model::teamColor::Blue, t0 + 10s).robotsYellow().at(3);
+  BOOST_TEST(far.x() == 600);
+}
+
+// 味方のロボットは送信した指令に従って加速する
+BOOST_AUTO_TEST_CASE(command_history) {
+  using boost::math::double_constants::half_pi;
+  model::predictor p{};
+
+  model::world w{};
+  // y軸正の方向を向いて静止しているロボット
+  w.robotsBlue(model::world::RobotsList{{2, model::robot{2, 0, 0, half_pi}}});
+  const auto t0 = util::TimePointType{} + 10s;
+  w.captureTime(t0);
+
+  // キャプチャより前に前進する指令を送っていた
+  model::command c{2};
+  c.vel({1000, 0, 0});
+  p.record(c, t0 - 50ms);
+
+  {
+    // 十分時間が経てば指令した速度に近づく
+    const auto r = p.predict(w, model::teamColor::Blue, t0 + 300ms).robotsBlue().at(2);
+    BOOST_TEST(r.vy() == 1000, boost::test_tools::tolerance(0.01));
+    BOOST_TEST(std::abs(r.vx()) < 1e-6);
+    BOOST_TEST(r.y() > 0);
+    BOOST_TEST(r.y() < 300);
+  }
+
+  {
+    // 相手チームとして予測した場合は指令を使わないので止まったまま
+    const auto r = p.predict(w, model::teamColor::Yellow, t0 + 300ms).robotsBlue().at(2);
+    BOOST_TEST(r.y() == 0);
+  }
+
+  {
+    // 止まる指令を後から送ると, それ以降は減速する
+    c.vel({0, 0, 0});
+    p.record(c, t0 + 100ms);
+    const auto r = p.predict(w, model::teamColor::Blue, t0 + 400ms).robotsBlue().at(2);
+    BOOST_TEST(std::abs(r.vy()) < 10);
+  }
+
+  {
+    // 記録を消去すると等速度で進める
+    p.clear(2);
+    const auto r = p.predict(w, model::teamColor::Blue, t0 + 300ms).robotsBlue().at(2);
+    BOOST_TEST(r.y() == 0);
+  }
+
+  {
+    // 指令に従って回転した角度も[0, 2pi)に正規化される
+    model::world turning{};
+    turning.robotsBlue(model::world::RobotsList{{2, model::robot{2, 0, 0, 0.1}}});
+    turning.captureTime(t0);
+    c.vel({0, 0, -3.0});
+    p.record(c, t0 - 500ms);
+    const auto r = p.predict(turning, model::teamColor::Blue, t0 + 300ms).robotsBlue().at(2);
+    BOOST_TEST(r.omega() < -1.0);
+    BOOST_TEST(r.theta() > boost::math::double_constants::pi);
+    BOOST_TEST(r.theta() < 2 * boost::math::double_constants::pi);
+  }
+}
+
+// 指令の時刻が予測する区間の途中なら, その時刻から効き始める
+BOOST_AUTO_TEST_CASE(command_timing) {
+  model::predictor p{};
+
+  model::world w{};
+  w.robotsBlue(model::world::RobotsList{{0, model::robot{0, 0, 0, 0}}});
+  const auto t0 = util::TimePointType{} + 10s;
+  w.captureTime(t0);
+
+  model::command c{0};
+  c.vel({2000, 0, 0});
+  p.record(c, t0 + sec(0.1));
+
+  // 指令を送る前までは動かない
+  const auto before = p.predict(w, model::teamColor::Blue, t0 + sec(0.1)).robotsBlue().at(0);
+  BOOST_TEST(before.x() == 0);
+  BOOST_TEST(before.vx() == 0);
+
+  const auto after = p.predict(w, model::teamColor::Blue, t0 + sec(0.2)).robotsBlue().at(0);
+  BOOST_TEST(after.vx() > 1000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,72 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include "ai/model/robotStates.hpp"
+#include "ai/util/math/affine.hpp"
+
+namespace model = ai::model;
+
+BOOST_AUTO_TEST_SUITE(robot_states)
+
+BOOST_AUTO_TEST_CASE(load_and_store) {
+  model::robotStates states{};
+  BOOST_TEST(!states.mask().any());
+
+  const model::world::RobotsList blue{{1, {1, 10, 20, 0.5}}, {4, {4, 30, 40, 1.5}}};
+  const model::world::RobotsList yellow{{0, {0, -10, -20, 2.5}}};
+  states.load(model::teamColor::Blue, blue);
+  states.load(model::teamColor::Yellow, yellow);
+
+  BOOST_TEST(states.mask().count() == 3);
+  const auto b4 = model::robotStates::index(model::teamColor::Blue, 4);
+  const auto y0 = model::robotStates::index(model::teamColor::Yellow, 0);
+  BOOST_TEST(states.exists(b4));
+  BOOST_TEST(states.exists(y0));
+  BOOST_TEST(states.x()(b4) == 30);
+  BOOST_TEST(states.theta()(y0) == 2.5);
+
+  // 取り出したリストは元のリストと一致する
+  const auto blue2 = states.robots(model::teamColor::Blue);
+  BOOST_TEST(blue2.size() == 2);
+  BOOST_TEST(blue2.at(1).x() == 10);
+  BOOST_TEST(blue2.at(4).y() == 40);
+  BOOST_TEST(blue2.at(4).id() == 4);
+  BOOST_TEST(states.robots(model::teamColor::Yellow).at(0).id() == 0);
+
+  // 読み込み直すと, そのチームのスロットだけが置き換えられる
+  states.load(model::teamColor::Blue, {{2, {2, 0, 0, 0}}});
+  BOOST_TEST(!states.exists(b4));
+  BOOST_TEST(states.exists(y0));
+
+  states.erase(y0);
+  BOOST_TEST(!states.exists(y0));
+  states.clear();
+  BOOST_TEST(!states.mask().any());
+}
+
+BOOST_AUTO_TEST_CASE(transform, *boost::unit_test::tolerance(1e-9)) {
+  model::robotStates states{};
+  for (auto i = 0u; i < model::robotStates::capacity; ++i) {
+    const auto id = static_cast<uint32_t>(i % model::world::maxRobots);
+    model::robot r{id, 100.0 * i - 1500, 3000.0 - 200.0 * i, 0.4 * i - 6};
+    r.vx(10.0 * i);
+    states.set(i, r);
+  }
+  const auto original = states;
+
+  const auto mat = ai::util::math::makeTransformationMatrix(1000.0, -500.0, 0.7);
+  ai::util::math::transform(mat, states);
+
+  // スカラー版と同じ結果になる
+  for (auto i = 0u; i < model::robotStates::capacity; ++i) {
+    const auto expected = ai::util::math::transform(mat, original.get(i));
+    const auto r        = states.get(i);
+    BOOST_TEST(r.x() == expected.x());
+    BOOST_TEST(r.y() == expected.y());
+    BOOST_TEST(r.theta() == expected.theta());
+    BOOST_TEST(r.vx() == expected.vx());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,6 @@
 #define BOOST_TEST_DYN_LINK
 
+#include <vector>
 #include <boost/math/constants/constants.hpp>
 #include <boost/test/unit_test.hpp>
 
@@ -372,4 +373,110 @@ BOOST_AUTO_TEST_CASE(clear_filter) {
   BOOST_TEST(!fp5.expired());
 }
 
+BOOST_AUTO_TEST_CASE(weighted_fusion, *boost::unit_test::tolerance(0.0000001)) {
+  model::updater::ball bu;
+  bu.fusion(model::updater::fusionMode::weighted);
+  bu.fusionWindow(500ms);
+
+  const auto makeFrame = [](uint32_t _camera, double _t, double _x, double _confidence) {
+    ssl_protos::vision::DetectionFrame f;
+    f.set_camera_id(_camera);
+    f.set_t_capture(_t);
+    auto b = f.add_balls();
+    b->set_x(_x);
+    b->set_y(10);
+    b->set_z(0);
+    b->set_confidence(_confidence);
+    return f;
+  };
+
+  bu.update(makeFrame(0, 1.0, 0, 1.0));
+  BOOST_TEST(bu.value().x() == 0);
+
+  // 同じ時刻に検出された値はconfidenceで重み付けされる
+  bu.update(makeFrame(1, 1.0, 100, 3.0));
+  BOOST_TEST(bu.value().x() == 75);
+  BOOST_TEST(bu.value().y() == 10);
+
+  // 古い観測値ほど重みが小さくなる (250ms前の値の重みは半分)
+  bu.update(makeFrame(1, 1.25, 100, 1.0));
+  BOOST_TEST(bu.value().x() == 100.0 / 1.5);
+
+  // 時間窓の外にある観測値は使われない
+  bu.update(makeFrame(1, 2.0, 200, 1.0));
+  BOOST_TEST(bu.value().x() == 200);
+}
+
+BOOST_AUTO_TEST_CASE(tracking, *boost::unit_test::tolerance(0.0000001)) {
+  model::updater::ball bu;
+  bu.tracking(true);
+
+  struct detection {
+    double x;
+    double y;
+    double confidence;
+  };
+  const auto makeFrame = [](uint32_t _camera, double _t, std::vector<detection> _balls) {
+    ssl_protos::vision::DetectionFrame f;
+    f.set_camera_id(_camera);
+    f.set_t_capture(_t);
+    for (const auto& d : _balls) {
+      auto b = f.add_balls();
+      b->set_x(d.x);
+      b->set_y(d.y);
+      b->set_z(0);
+      b->set_confidence(d.confidence);
+    }
+    return f;
+  };
+
+  // ボールが移動しながら検出され続ける
+  auto t = 1.0;
+  for (auto i = 0; i < 10; ++i, t += 1.0 / 60) {
+    bu.update(makeFrame(0, t, {{10.0 * i, 0, 0.8}}));
+  }
+  BOOST_TEST(bu.tracks() == 1);
+  BOOST_TEST(bu.value().x() == 90);
+
+  // 観客席などでの誤検出が, confidenceが高くても最終的な値を乗っ取らない
+  bu.update(makeFrame(1, t, {{100, 0, 0.8}, {5000, 4000, 0.99}}));
+  BOOST_TEST(bu.tracks() == 2);
+  BOOST_TEST(bu.value().x() == 100);
+  BOOST_TEST(bu.value().y() == 0);
+  t += 1.0 / 60;
+
+  // 他のカメラで検出された同じボールは同じ候補に割り当てられる
+  bu.update(makeFrame(0, t, {{110, 0, 0.8}, {112, 2, 0.5}}));
+  BOOST_TEST(bu.tracks() == 2);
+  BOOST_TEST(bu.value().x() == 110);
+
+  // 検出されなくなった候補は追跡が打ち切られる
+  for (auto i = 0; i < 70; ++i) {
+    t += 1.0 / 60;
+    bu.update(makeFrame(0, t, {{110, 0, 0.8}}));
+  }
+  BOOST_TEST(bu.tracks() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(track_filter) {
+  model::updater::ball bu;
+  bu.tracking(true);
+  bu.setTrackFilter<mockFilter1>(1, 2);
+
+  ssl_protos::vision::DetectionFrame f;
+  f.set_camera_id(0);
+  f.set_t_capture(2.0);
+  auto b = f.add_balls();
+  b->set_x(10);
+  b->set_y(20);
+  b->set_z(0);
+  b->set_confidence(0.9);
+  bu.update(f);
+
+  // 候補のFilterを通した値が使われる
+  const auto v = bu.value();
+  BOOST_TEST(v.vx() == 20);
+  BOOST_TEST(v.ay() == 60);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
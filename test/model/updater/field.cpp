@@ -44,6 +44,11 @@ BOOST_AUTO_TEST_CASE(normal) {
     BOOST_TEST(f.width() == 6000);
     BOOST_TEST(f.goalWidth() == 1000);
     BOOST_TEST(f.centerRadius() == 200);
+
+    // 受け取った形状の距離マップが作られている
+    const auto map = fu.map();
+    BOOST_TEST(map->field().length() == 9000);
+    BOOST_TEST(map->field().width() == 6000);
   }
 
   {
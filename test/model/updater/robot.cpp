@@ -646,4 +646,93 @@ BOOST_AUTO_TEST_CASE(clear_filter) {
   BOOST_TEST(fp9.expired());
 }
 
+// 同じカメラで同じIDが複数検出された場合や, 扱えないカメラIDのパケット
+BOOST_AUTO_TEST_CASE(duplicated_and_invalid_camera) {
+  model::updater::robot<model::teamColor::Blue> rbu;
+
+  const auto addRobot = [](ssl_protos::vision::DetectionFrame& _f, uint32_t _id, double _x,
+                           double _confidence) {
+    auto r = _f.add_robots_blue();
+    r->set_robot_id(_id);
+    r->set_x(_x);
+    r->set_y(0);
+    r->set_orientation(0);
+    r->set_confidence(_confidence);
+  };
+
+  {
+    // 同じカメラで検出された中から, 最もconfidenceの高いものが選ばれる
+    ssl_protos::vision::DetectionFrame f;
+    f.set_camera_id(0);
+    addRobot(f, 1, 10, 80.0);
+    addRobot(f, 1, 20, 95.0);
+    addRobot(f, 1, 30, 90.0);
+    rbu.update(f);
+
+    BOOST_TEST(rbu.value().at(1).x() == 20);
+  }
+
+  {
+    // 扱えるカメラの数を超えるカメラIDのパケットは無視される
+    ssl_protos::vision::DetectionFrame f;
+    f.set_camera_id(model::updater::robot<model::teamColor::Blue>::maxCameras);
+    addRobot(f, 1, 40, 99.0);
+    addRobot(f, 2, 50, 99.0);
+    rbu.update(f);
+
+    const auto rb = rbu.value();
+    BOOST_TEST(rb.size() == 1);
+    BOOST_TEST(rb.at(1).x() == 20);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(weighted_fusion, *boost::unit_test::tolerance(0.0000001)) {
+  model::updater::robot<model::teamColor::Blue> rbu;
+  rbu.fusion(model::updater::fusionMode::weighted);
+  rbu.fusionWindow(50ms);
+
+  const auto makeFrame = [](uint32_t _camera, double _t, double _x, double _theta) {
+    ssl_protos::vision::DetectionFrame f;
+    f.set_camera_id(_camera);
+    f.set_t_capture(_t);
+    if (_x >= 0) {
+      auto r = f.add_robots_blue();
+      r->set_robot_id(1);
+      r->set_x(_x);
+      r->set_y(20);
+      r->set_orientation(_theta);
+      r->set_confidence(90.0);
+    }
+    return f;
+  };
+
+  // カメラの重なる領域で検出された値は平均される
+  // 角度は境界をまたいでも正しく平均される
+  rbu.update(makeFrame(0, 1.0, 0, rad(350)));
+  rbu.update(makeFrame(1, 1.0, 100, rad(30)));
+  {
+    const auto r = rbu.value().at(1);
+    BOOST_TEST(r.x() == 50);
+    BOOST_TEST(r.y() == 20);
+    // orientationはfloatで送られてくるので, その分の誤差は許容する
+    BOOST_TEST(r.theta() == rad(10), boost::test_tools::tolerance(1e-6));
+  }
+
+  // 現在のカメラで検出されなかったときは前の値を引き継ぐ
+  rbu.update(makeFrame(2, 1.01, -1, 0));
+  BOOST_TEST(rbu.value().at(1).x() == 50);
+
+  // 時間窓の外にある観測値は使われない
+  rbu.update(makeFrame(0, 1.1, 10, rad(90)));
+  {
+    const auto r = rbu.value().at(1);
+    BOOST_TEST(r.x() == 10);
+    BOOST_TEST(r.theta() == rad(90), boost::test_tools::tolerance(1e-6));
+  }
+
+  // 時間窓内にどのカメラでも検出されなかったIDは取り除かれる
+  rbu.update(makeFrame(1, 1.2, -1, 0));
+  BOOST_TEST(rbu.value().count(1) == 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,7 @@
 #define BOOST_TEST_DYN_LINK
 
+#include <chrono>
+#include <memory>
 #include <stdexcept>
 #include <boost/math/constants/constants.hpp>
 #include <boost/test/unit_test.hpp>
@@ -208,6 +210,10 @@ BOOST_AUTO_TEST_CASE(geometry) {
     BOOST_TEST(f.goalWidth() == 1000);
     BOOST_TEST(f.centerRadius() == 200);
 
+    // 距離マップも新しい形状で作り直されている
+    BOOST_TEST(w.fieldMap()->field().length() == 9000);
+    BOOST_TEST(wu.snapshot()->fieldMap() == w.fieldMap());
+
     // ボールやロボットは検出されていない
     const auto b = w.ball();
     BOOST_TEST(b.x() == 0);
@@ -334,4 +340,106 @@ BOOST_AUTO_TEST_CASE(disabling_camera) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(snapshot) {
+  ai::model::updater::world wu{};
+
+  // 初期状態でもスナップショットは存在する
+  const auto s0 = wu.snapshot();
+  BOOST_TEST(static_cast<bool>(s0));
+  BOOST_TEST(s0->robotsBlue().size() == 0);
+  const auto v0 = wu.version();
+
+  {
+    ssl_protos::vision::WrapperPacket p;
+
+    auto md = p.mutable_detection();
+    md->set_camera_id(0);
+
+    auto rb1 = md->add_robots_blue();
+    rb1->set_robot_id(1);
+    rb1->set_x(10);
+    rb1->set_y(11);
+    rb1->set_confidence(94.0);
+
+    wu.update(p);
+  }
+
+  // updateのたびに新しいスナップショットが公開され, 版数が増える
+  const auto s1 = wu.snapshot();
+  BOOST_TEST(wu.version() == v0 + 1);
+  BOOST_TEST(s1 != s0);
+  BOOST_TEST(s1->robotsBlue().size() == 1);
+
+  // フィールドの形状が変わらなければ, 距離マップは作り直さずに共有する
+  BOOST_TEST(s1->fieldMap() == s0->fieldMap());
+
+  // 新しいスナップショットが公開されても, 取得済みのものは変化しない
+  BOOST_TEST(s0->robotsBlue().size() == 0);
+
+  // 更新がなければ同じスナップショットが返る
+  BOOST_TEST(wu.snapshot() == s1);
+
+  // 無効化されたカメラのパケットでは公開されない
+  wu.disableCamera(0);
+  {
+    ssl_protos::vision::WrapperPacket p;
+    p.mutable_detection()->set_camera_id(0);
+    wu.update(p);
+  }
+  BOOST_TEST(wu.version() == v0 + 1);
+  BOOST_TEST(wu.snapshot() == s1);
+}
+
+BOOST_AUTO_TEST_CASE(shared_packet) {
+  ai::model::updater::world wu{};
+
+  const auto makePacket = [](double _x) {
+    auto p  = std::make_shared<ssl_protos::vision::WrapperPacket>();
+    auto md = p->mutable_detection();
+    md->set_camera_id(0);
+    auto rb = md->add_robots_blue();
+    rb->set_robot_id(1);
+    rb->set_x(_x);
+    rb->set_y(0);
+    rb->set_orientation(0);
+    rb->set_confidence(90.0);
+    return std::shared_ptr<const ssl_protos::vision::WrapperPacket>{std::move(p)};
+  };
+
+  auto p1 = makePacket(10);
+  wu.update(p1);
+  BOOST_TEST(wu.value().robotsBlue().at(1).x() == 10);
+  // 必要な値は取り出されるので, パケットの参照は保持されない
+  // (receiver::visionはすぐにパケットを再利用できる)
+  BOOST_TEST(p1.use_count() == 1);
+
+  auto p2 = makePacket(20);
+  wu.update(p2);
+  BOOST_TEST(wu.value().robotsBlue().at(1).x() == 20);
+  BOOST_TEST(p2.use_count() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(capture_time) {
+  ai::model::updater::world wu{};
+
+  // 何も受け取っていないときは初期値
+  BOOST_TEST((wu.snapshot()->captureTime() == ai::util::TimePointType{}));
+
+  ssl_protos::vision::WrapperPacket p;
+  auto md = p.mutable_detection();
+  md->set_frame_number(1);
+  md->set_t_capture(2.0);
+  md->set_t_sent(2.25);
+  md->set_camera_id(0);
+
+  const auto before = ai::util::ClockType::now();
+  wu.update(p);
+  const auto after = ai::util::ClockType::now();
+
+  // 受信した時刻からVisionでの処理時間を引いた時刻がキャプチャ時刻になる
+  const auto t = wu.snapshot()->captureTime();
+  BOOST_TEST((before - std::chrono::milliseconds{250} <= t));
+  BOOST_TEST((t <= after - std::chrono::milliseconds{250}));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,170 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/model/world.hpp"
+#include "ai/planner/astar.hpp"
+
+namespace model   = ai::model;
+namespace planner = ai::planner;
+
+// 点pと線分abの距離
+static double segmentDistance(double _px, double _py, double _ax, double _ay, double _bx,
+                              double _by) {
+  const auto dx = _bx - _ax;
+  const auto dy = _by - _ay;
+  const auto t =
+      std::clamp(((_px - _ax) * dx + (_py - _ay) * dy) / (dx * dx + dy * dy), 0.0, 1.0);
+  return std::hypot(_ax + t * dx - _px, _ay + t * dy - _py);
+}
+
+BOOST_AUTO_TEST_SUITE(astar)
+
+// 障害物のない場合は目標位置へ直接向かう
+BOOST_AUTO_TEST_CASE(free) {
+  model::world world{};
+  planner::astar astar{world};
+
+  for (auto jps : {false, true}) {
+    astar.jumpPointSearch(jps);
+    astar.search({-2000.0, 0.0, 0.0}, {2000.0, 500.0, 1.0});
+    const auto& path = astar.path();
+    BOOST_TEST(path.size() == 2u);
+    BOOST_TEST(path.front().x == -2000.0);
+    BOOST_TEST(path.back().x == 2000.0);
+    BOOST_TEST(path.back().y == 500.0);
+    BOOST_TEST(astar.target().theta == 1.0);
+  }
+}
+
+// 経路は障害物とマージンを避ける
+BOOST_AUTO_TEST_CASE(avoid) {
+  model::world world{};
+  planner::astar astar{world};
+  astar.obstacles({{{0.0, 0.0, 0.0}, 300.0}, {{0.0, 600.0, 0.0}, 300.0}});
+
+  for (auto jps : {false, true}) {
+    astar.jumpPointSearch(jps);
+    astar.search({-2000.0, 0.0, 0.0}, {2000.0, 0.0, 0.0}, 100.0);
+    const auto& path = astar.path();
+    BOOST_TEST(path.size() > 2u);
+    BOOST_TEST(path.back().x == 2000.0);
+    for (auto i = 1u; i < path.size(); ++i) {
+      const auto& a = path[i - 1];
+      const auto& b = path[i];
+      BOOST_TEST(segmentDistance(0.0, 0.0, a.x, a.y, b.x, b.y) > 300.0);
+      BOOST_TEST(segmentDistance(0.0, 600.0, a.x, a.y, b.x, b.y) > 300.0);
+    }
+    // 格子上の経路は直線より長く, 大回りはしない
+    BOOST_TEST(astar.cost() > 4000.0);
+    BOOST_TEST(astar.cost() < 5000.0);
+  }
+}
+
+// JPSは通常のA*と同じ長さの経路を, より少ない展開数で求める
+BOOST_AUTO_TEST_CASE(jump_point_search) {
+  model::world world{};
+  planner::astar astar{world};
+  std::mt19937 mt{0};
+  std::uniform_real_distribution<double> x(-4500.0, 4500.0);
+  std::uniform_real_distribution<double> y(-3000.0, 3000.0);
+
+  auto reached = 0;
+  for (auto scene = 0; scene < 20; ++scene) {
+    std::vector<planner::obstacle> obstacles;
+    for (auto i = 0; i < 22; ++i) obstacles.push_back({{x(mt), y(mt), 0.0}, 90.0});
+    astar.obstacles(obstacles);
+    const planner::position start{x(mt), y(mt), 0.0};
+    const planner::position goal{x(mt), y(mt), 0.0};
+
+    astar.jumpPointSearch(false);
+    astar.search(start, goal);
+    const auto cost     = astar.cost();
+    const auto expanded = astar.expanded();
+    const auto path     = astar.path();
+
+    astar.jumpPointSearch(true);
+    astar.search(start, goal);
+    // 辿り着けない場合に向かう位置は展開した格子によるので, 辿り着ける場合だけ比べる
+    if (path.back().x == goal.x && path.back().y == goal.y) {
+      ++reached;
+      BOOST_TEST(astar.cost() == cost, boost::test_tools::tolerance(1e-3));
+      BOOST_TEST(astar.expanded() <= expanded);
+      BOOST_TEST(astar.path().back().x == goal.x);
+    }
+
+    // 同じ入力からは同じ経路が得られる
+    const auto again = astar.path();
+    astar.search(start, goal);
+    BOOST_TEST(astar.path().size() == again.size());
+    for (auto i = 0u; i < again.size(); ++i) {
+      BOOST_TEST(astar.path()[i].x == again[i].x);
+      BOOST_TEST(astar.path()[i].y == again[i].y);
+    }
+  }
+  BOOST_TEST(reached >= 15);
+}
+
+// 目標位置に辿り着けなければ, 辿り着ける範囲で最も近い位置へ向かう
+BOOST_AUTO_TEST_CASE(unreachable) {
+  model::world world{};
+  planner::astar astar{world};
+  astar.obstacles({{{2000.0, 0.0, 0.0}, 500.0}});
+
+  astar.search({-2000.0, 0.0, 0.0}, {2000.0, 0.0, 0.0}, 100.0);
+  const auto& path = astar.path();
+  BOOST_TEST(path.size() >= 2u);
+  const auto d = std::hypot(path.back().x - 2000.0, path.back().y);
+  BOOST_TEST(d > 500.0);
+  BOOST_TEST(d < 800.0);
+}
+
+// 初期位置が障害物の中にあれば, 最も近い通れる位置から探索する
+BOOST_AUTO_TEST_CASE(escape) {
+  model::world world{};
+  planner::astar astar{world};
+  astar.obstacles({{{0.0, 0.0, 0.0}, 300.0}});
+
+  astar.search({100.0, 0.0, 0.0}, {2000.0, 0.0, 0.0}, 100.0);
+  const auto& path = astar.path();
+  BOOST_TEST(path.size() >= 2u);
+  BOOST_TEST(path.front().x == 100.0);
+  BOOST_TEST(path.back().x == 2000.0);
+  // 最初の経由点は障害物の外にある
+  BOOST_TEST(std::hypot(path[1].x, path[1].y) > 300.0);
+}
+
+// 最初の探索の後にフィールドの寸法が変わっても, 新しいペナルティエリアを避ける
+BOOST_AUTO_TEST_CASE(field_changed) {
+  model::world world{};
+  model::field field{};
+  field.penaltyLength(300);
+  world.field(field);
+  planner::astar astar{world};
+
+  // ペナルティエリアが小さいうちは直進する
+  astar.search({4500.0, 2500.0, 0.0}, {4500.0, -2500.0, 0.0}, 100.0);
+  BOOST_TEST(astar.path().size() == 2u);
+
+  // ペナルティエリアが大きくなると, 直線上に入るので回り込む
+  field.penaltyLength(2500);
+  world.field(field);
+  astar.search({4500.0, 2500.0, 0.0}, {4500.0, -2500.0, 0.0}, 100.0);
+  const auto& path = astar.path();
+  BOOST_TEST(path.size() > 2u);
+  BOOST_TEST(path.back().y == -2500.0);
+  // 経由点は新しいペナルティエリアの外にある
+  // ショートカットの干渉判定は近似なので, 線分は直進したとき(1500mm)より離れていればよい
+  for (auto i = 1u; i < path.size(); ++i) {
+    BOOST_TEST(std::hypot(path[i].x - field.xMax(), path[i].y) > 2500.0);
+    const auto d = segmentDistance(field.xMax(), 0.0, path[i - 1].x, path[i - 1].y, path[i].x,
+                                   path[i].y);
+    BOOST_TEST(d > 2000.0);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
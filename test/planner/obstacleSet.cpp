@@ -0,0 +1,160 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <random>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/planner/obstacleSet.hpp"
+
+namespace planner = ai::planner;
+
+BOOST_AUTO_TEST_SUITE(obstacle_set)
+
+BOOST_AUTO_TEST_CASE(basic) {
+  planner::obstacleSet s{};
+  BOOST_TEST(s.size() == 0);
+  BOOST_TEST(!s.obstructed(-1000, 0, 1000, 0, 0));
+
+  s.add(0, 0, 100);
+  BOOST_TEST(s.size() == 1);
+  // 障害物を横切る線分
+  BOOST_TEST(s.obstructed(-1000, 0, 1000, 0, 0));
+  // マージンを加えると干渉する線分
+  BOOST_TEST(!s.obstructed(-1000, -800, 1000, 1200, 0));
+  BOOST_TEST(s.obstructed(-1000, -800, 1000, 1200, 100));
+  // 障害物から離れた線分
+  BOOST_TEST(!s.obstructed(-1000, 1000, 1000, 1000, 100));
+  // 始点と終点が一致する場合は干渉しない
+  BOOST_TEST(!s.obstructed(0, 0, 0, 0, 100));
+
+  s.clear();
+  BOOST_TEST(s.size() == 0);
+  BOOST_TEST(!s.obstructed(-1000, 0, 1000, 0, 0));
+}
+
+// 乱数で生成した入力に対して, SIMD実装とスカラー実装の結果が完全に一致するか
+BOOST_AUTO_TEST_CASE(random) {
+  std::mt19937 mt{0};
+  std::uniform_real_distribution<double> pos(-5000, 5000);
+  std::uniform_real_distribution<double> radius(0, 500);
+  std::uniform_real_distribution<double> margin(0, 300);
+  std::uniform_int_distribution<int> num(0, 30);
+  std::uniform_int_distribution<int> grid(-50, 50);
+
+  std::size_t hits = 0;
+  std::size_t total = 0;
+  for (auto k = 0; k < 2000; ++k) {
+    planner::obstacleSet s{};
+    const auto n = num(mt);
+    for (auto i = 0; i < n; ++i) s.add(pos(mt), pos(mt), radius(mt));
+    BOOST_TEST(s.size() == static_cast<std::size_t>(n));
+
+    for (auto i = 0; i < 100; ++i) {
+      double sx, sy, gx, gy;
+      if (i % 4 == 0) {
+        // 境界付近や軸に平行な線分, 長さ0の線分が現れやすいように格子上の点も使う
+        sx = 100.0 * grid(mt);
+        sy = 100.0 * grid(mt);
+        gx = i % 8 == 0 ? sx : 100.0 * grid(mt);
+        gy = 100.0 * grid(mt);
+      } else {
+        sx = pos(mt);
+        sy = pos(mt);
+        gx = pos(mt);
+        gy = pos(mt);
+      }
+      const auto m = i % 3 == 0 ? 0.0 : margin(mt);
+
+      const auto expected = s.obstructedReference(sx, sy, gx, gy, m);
+      BOOST_TEST(s.obstructed(sx, sy, gx, gy, m) == expected);
+      hits += expected;
+      ++total;
+    }
+  }
+  // どちらの結果も十分な数だけ現れていること
+  BOOST_TEST(hits > total / 10);
+  BOOST_TEST(hits < total - total / 10);
+}
+
+BOOST_AUTO_TEST_CASE(swept) {
+  planner::obstacleSet s{};
+  BOOST_TEST(!s.sweptObstructed(-1000, 0, 0, 1000, 0, 2, 0));
+
+  // 止まっている障害物は, 線分との最短距離で判定する
+  s.add(0, 0, 100);
+  BOOST_TEST(s.sweptObstructed(-1000, 0, 0, 1000, 0, 2, 0));
+  BOOST_TEST(!s.sweptObstructed(-1000, 200, 0, 1000, 200, 2, 50));
+  BOOST_TEST(s.sweptObstructed(-1000, 200, 0, 1000, 200, 2, 150));
+  // 線分の延長線上にあっても, 端点から離れていれば干渉しない
+  BOOST_TEST(!s.sweptObstructed(-1000, 0, 0, -300, 0, 2, 150));
+  // 止まっているロボットも判定できる
+  BOOST_TEST(s.sweptObstructed(50, 50, 0, 50, 50, 2, 0));
+
+  // y方向に1000mm/sで動く障害物
+  s.clear();
+  s.add(0, -2000, 100, 0, 1000);
+  BOOST_TEST(s.size() == 1);
+  // 2秒後に原点を通る障害物とちょうど出会う
+  BOOST_TEST(s.sweptObstructed(-2000, 0, 0, 2000, 0, 4, 0));
+  // 障害物が通り過ぎてから横切れば干渉しない
+  BOOST_TEST(!s.sweptObstructed(-2000, 0, 2, 2000, 0, 6, 0));
+  // 障害物が来る前に横切れば干渉しない
+  BOOST_TEST(!s.sweptObstructed(-2000, 0, 0, 2000, 0, 1, 0));
+  // 同じ速さで並んで進めば, 距離が変わらない
+  BOOST_TEST(!s.sweptObstructed(200, -2000, 0, 200, 0, 2, 50));
+  BOOST_TEST(s.sweptObstructed(200, -2000, 0, 200, 0, 2, 150));
+}
+
+// 乱数で生成した入力に対して, 障害物の移動を考慮した判定の結果も完全に一致するか
+BOOST_AUTO_TEST_CASE(swept_random) {
+  std::mt19937 mt{0};
+  std::uniform_real_distribution<double> pos(-5000, 5000);
+  std::uniform_real_distribution<double> vel(-3000, 3000);
+  std::uniform_real_distribution<double> radius(0, 500);
+  std::uniform_real_distribution<double> margin(0, 300);
+  std::uniform_real_distribution<double> time(0, 3);
+  std::uniform_int_distribution<int> num(0, 30);
+  std::uniform_int_distribution<int> grid(-50, 50);
+
+  std::size_t hits  = 0;
+  std::size_t total = 0;
+  for (auto k = 0; k < 2000; ++k) {
+    planner::obstacleSet s{};
+    const auto n = num(mt);
+    for (auto i = 0; i < n; ++i) {
+      // 止まっている障害物も混ぜる
+      if (i % 3 == 0) {
+        s.add(pos(mt), pos(mt), radius(mt));
+      } else {
+        s.add(pos(mt), pos(mt), radius(mt), vel(mt), vel(mt));
+      }
+    }
+
+    for (auto i = 0; i < 100; ++i) {
+      double sx, sy, gx, gy;
+      if (i % 4 == 0) {
+        // 長さ0の線分や, 障害物と相対的に止まる場合が現れやすいように格子上の点も使う
+        sx = 100.0 * grid(mt);
+        sy = 100.0 * grid(mt);
+        gx = i % 8 == 0 ? sx : 100.0 * grid(mt);
+        gy = i % 8 == 0 ? sy : 100.0 * grid(mt);
+      } else {
+        sx = pos(mt);
+        sy = pos(mt);
+        gx = pos(mt);
+        gy = pos(mt);
+      }
+      const auto t0 = i % 5 == 0 ? 0.0 : time(mt);
+      const auto t1 = i % 7 == 0 ? t0 : t0 + time(mt);
+      const auto m  = i % 3 == 0 ? 0.0 : margin(mt);
+
+      const auto expected = s.sweptObstructedReference(sx, sy, t0, gx, gy, t1, m);
+      BOOST_TEST(s.sweptObstructed(sx, sy, t0, gx, gy, t1, m) == expected);
+      hits += expected;
+      ++total;
+    }
+  }
+  BOOST_TEST(hits > total / 10);
+  BOOST_TEST(hits < total - total / 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
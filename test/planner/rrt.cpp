@@ -0,0 +1,202 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/model/world.hpp"
+#include "ai/planner/obstacleSet.hpp"
+#include "ai/planner/rrt.hpp"
+#include "ai/util/time.hpp"
+
+namespace model   = ai::model;
+namespace planner = ai::planner;
+namespace util    = ai::util;
+
+using namespace std::chrono_literals;
+
+// 点pと線分abの距離
+static double segmentDistance(double _px, double _py, double _ax, double _ay, double _bx,
+                              double _by) {
+  const auto dx = _bx - _ax;
+  const auto dy = _by - _ay;
+  const auto t =
+      std::clamp(((_px - _ax) * dx + (_py - _ay) * dy) / (dx * dx + dy * dy), 0.0, 1.0);
+  return std::hypot(_ax + t * dx - _px, _ay + t * dy - _py);
+}
+
+BOOST_AUTO_TEST_SUITE(rrt)
+
+// 障害物のない場合は目標位置の近くへ直接向かう
+BOOST_AUTO_TEST_CASE(free) {
+  model::world world{};
+  planner::rrt rrt{world};
+  rrt.obstacles({});
+
+  rrt.search({-2000.0, 0.0, 0.0}, {2000.0, 0.0, 1.0}, 1000);
+  BOOST_TEST(std::hypot(rrt.target().x - 2000.0, rrt.target().y) < 1000.0);
+  BOOST_TEST(rrt.target().theta == 1.0);
+}
+
+// 同じインスタンスで繰り返し探索しても, 最初の経由点が障害物を通らない
+BOOST_AUTO_TEST_CASE(reuse) {
+  model::world world{};
+  planner::rrt rrt{world};
+  const std::vector<planner::rrt::obstacle> obstacles{{{0.0, 0.0, 0.0}, 200.0}};
+  rrt.obstacles(obstacles);
+
+  for (auto num : {1000u, 100u, 3000u, 500u}) {
+    rrt.search({-2000.0, 0.0, 0.0}, {2000.0, 0.0, 0.0}, num);
+    const auto target = rrt.target();
+    BOOST_TEST(segmentDistance(0.0, 0.0, -2000.0, 0.0, target.x, target.y) > 200.0);
+  }
+}
+
+// 回数を指定した探索では, 指定した回数だけ木を伸ばす
+BOOST_AUTO_TEST_CASE(iterations) {
+  model::world world{};
+  planner::rrt rrt{world};
+  rrt.obstacles({});
+  BOOST_TEST(rrt.iterations() == 0);
+
+  rrt.search({-2000.0, 0.0, 0.0}, {2000.0, 0.0, 0.0}, 123);
+  BOOST_TEST(rrt.iterations() == 123);
+}
+
+// 期限を過ぎていても1回は木を伸ばし, 期限に余裕があればノード数の上限まで伸ばす
+BOOST_AUTO_TEST_CASE(anytime) {
+  model::world world{};
+  planner::rrt rrt{world};
+  const std::vector<planner::rrt::obstacle> obstacles{{{0.0, 0.0, 0.0}, 200.0}};
+  rrt.obstacles(obstacles);
+
+  rrt.search({-2000.0, 0.0, 0.0}, {2000.0, 0.0, 1.0}, util::ClockType::now(), 200);
+  BOOST_TEST(rrt.iterations() == 1);
+  BOOST_TEST(rrt.target().theta == 1.0);
+
+  // 新しく作った木は根だけなので, 上限まで199回伸ばせる
+  planner::rrt fresh{world};
+  fresh.obstacles(obstacles);
+  fresh.search({-2000.0, 0.0, 0.0}, {2000.0, 0.0, 0.0}, util::ClockType::now() + 10s, 200);
+  BOOST_TEST(fresh.iterations() == 199);
+
+  // 前回の木のうち上限の半分までを引き継ぐので, 残りの分だけ伸ばす
+  for (auto i = 1; i <= 10; ++i) {
+    const planner::position start{-2000.0 + 50.0 * i, 10.0 * i, 0.0};
+    fresh.search(start, {2000.0, 0.0, 0.0}, util::ClockType::now() + 10s, 200);
+    BOOST_TEST(fresh.iterations() >= 100u);
+    BOOST_TEST(fresh.iterations() <= 199u);
+    const auto target = fresh.target();
+    BOOST_TEST(segmentDistance(0.0, 0.0, start.x, start.y, target.x, target.y) > 200.0);
+  }
+}
+
+// 同じシードと入力からは同じ結果が得られる
+BOOST_AUTO_TEST_CASE(seed) {
+  model::world world{};
+  const std::vector<planner::rrt::obstacle> obstacles{{{0.0, 0.0, 0.0}, 200.0},
+                                                      {{1000.0, 300.0, 0.0}, 200.0}};
+  // 回数を指定した探索と, ノード数の上限で止まる探索を交互に行う
+  auto run = [&obstacles](planner::rrt& _rrt) {
+    std::vector<planner::position> targets;
+    _rrt.obstacles(obstacles);
+    for (auto i = 0; i < 6; ++i) {
+      const planner::position start{-2000.0 + 100.0 * i, 0.0, 0.0};
+      if (i % 2 == 0) {
+        _rrt.search(start, {2000.0, 0.0, 0.0}, 300);
+      } else {
+        _rrt.search(start, {2000.0, 0.0, 0.0}, util::ClockType::now() + 10s, 300);
+      }
+      targets.push_back(_rrt.target());
+    }
+    return targets;
+  };
+
+  planner::rrt a{world, 1};
+  planner::rrt b{world, 1};
+  planner::rrt c{world, 2};
+  const auto ta = run(a);
+  const auto tb = run(b);
+  const auto tc = run(c);
+  bool differ = false;
+  for (auto i = 0u; i < ta.size(); ++i) {
+    BOOST_TEST(ta[i].x == tb[i].x);
+    BOOST_TEST(ta[i].y == tb[i].y);
+    differ |= ta[i].x != tc[i].x;
+  }
+  BOOST_TEST(differ);
+
+  // シードを設定し直せば, 同じインスタンスでも最初から再生できる
+  a.seed(1);
+  const auto replayed = run(a);
+  for (auto i = 0u; i < ta.size(); ++i) {
+    BOOST_TEST(ta[i].x == replayed[i].x);
+    BOOST_TEST(ta[i].y == replayed[i].y);
+  }
+}
+
+// 経路は初期位置から目標位置まで, 障害物を通らずにつながる
+BOOST_AUTO_TEST_CASE(path) {
+  model::world world{};
+  planner::rrt rrt{world, 0};
+  const std::vector<planner::rrt::obstacle> obstacles{{{0.0, 0.0, 0.0}, 200.0}};
+  rrt.obstacles(obstacles);
+
+  rrt.search({-2000.0, 0.0, 0.0}, {2000.0, 0.0, 1.0}, 1000);
+  const auto& path = rrt.path();
+  BOOST_TEST(path.size() >= 3u);
+  BOOST_TEST(path.front().x == -2000.0);
+  BOOST_TEST(path.front().y == 0.0);
+  BOOST_TEST(path.back().x == 2000.0);
+  BOOST_TEST(path.back().y == 0.0);
+  for (auto i = 0u; i + 1 < path.size(); ++i) {
+    BOOST_TEST(path[i].theta == 1.0);
+    BOOST_TEST(segmentDistance(0.0, 0.0, path[i].x, path[i].y, path[i + 1].x, path[i + 1].y) >
+               200.0);
+  }
+
+  // 障害物がなければ直接目標位置へ向かう
+  rrt.obstacles({});
+  rrt.search({-2000.0, 0.0, 0.0}, {2000.0, 0.0, 1.0}, 100);
+  BOOST_TEST(rrt.path().size() == 2u);
+}
+
+// 障害物の速度を考慮すると, 障害物がこれから来る位置へは向かわない
+BOOST_AUTO_TEST_CASE(moving_obstacle) {
+  model::world world{};
+  // 2秒後に原点を通るように, y方向に1000mm/sで動く障害物
+  const std::vector<planner::rrt::obstacle> obstacles{
+      {{0.0, -2000.0, 0.0}, 100.0, {0.0, 1000.0, 0.0}}};
+  planner::obstacleSet set{};
+  set.add(0.0, -2000.0, 100.0, 0.0, 1000.0);
+
+  // 最初の経由点へ1000mm/sで進む間に障害物と干渉するか
+  const planner::position start{-2000.0, 0.0, 0.0};
+  auto collides = [&set, &start](const planner::position& _target) {
+    const auto t = std::hypot(_target.x - start.x, _target.y - start.y) / 1000.0;
+    return set.sweptObstructed(start.x, start.y, 0.0, _target.x, _target.y, t, 100.0);
+  };
+
+  bool collided = false;
+  for (auto seed = 0u; seed < 10; ++seed) {
+    planner::rrt rrt{world, seed};
+    rrt.obstacles(obstacles);
+    BOOST_TEST(rrt.robotSpeed() == 0.0);
+
+    // 今いる位置だけを避けると, 原点を通る経路になる
+    rrt.search(start, {2000.0, 0.0, 0.0}, 1000);
+    collided |= collides(rrt.target());
+
+    rrt.robotSpeed(1000.0);
+    BOOST_TEST(rrt.robotSpeed() == 1000.0);
+    rrt.search(start, {2000.0, 0.0, 0.0}, 1000);
+    const auto target = rrt.target();
+    BOOST_TEST(std::hypot(target.x - start.x, target.y - start.y) > 0.0);
+    BOOST_TEST(!collides(target));
+  }
+  BOOST_TEST(collided);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,131 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/model/world.hpp"
+#include "ai/planner/service.hpp"
+#include "ai/util/time.hpp"
+
+namespace model   = ai::model;
+namespace planner = ai::planner;
+namespace util    = ai::util;
+
+using namespace std::chrono_literals;
+
+// 各ロボットが横一列に並び, 正面の障害物を避けて反対側へ向かう要求を作る
+static std::vector<planner::service::request> makeRequests(uint32_t _num, uint32_t _searchNum) {
+  std::vector<planner::service::request> requests;
+  for (auto id = 0u; id < _num; ++id) {
+    const double y = -2500.0 + 500.0 * id;
+    planner::service::request r{};
+    r.id        = id;
+    r.start     = {-3000.0, y, 0.0};
+    r.goal      = {3000.0, y, 0.5};
+    r.obstacles = {{{0.0, y, 0.0}, 100.0}};
+    r.searchNum = _searchNum;
+    requests.push_back(r);
+  }
+  return requests;
+}
+
+BOOST_AUTO_TEST_SUITE(service)
+
+BOOST_AUTO_TEST_CASE(plan) {
+  model::world world{};
+  planner::service s{world, 4};
+
+  const auto requests = makeRequests(11, 500);
+  const auto results  = s.plan(requests, util::ClockType::now() + 10s);
+  BOOST_TEST(results.size() == requests.size());
+  for (auto i = 0u; i < results.size(); ++i) {
+    // 要求と同じ順に並んでいる
+    BOOST_TEST(results[i].id == requests[i].id);
+    BOOST_TEST(results[i].updated);
+    BOOST_TEST(results[i].iterations == 500u);
+    // 初期位置とは異なる経由点が得られる
+    BOOST_TEST(std::hypot(results[i].target.x - requests[i].start.x,
+                          results[i].target.y - requests[i].start.y) > 0.0);
+    BOOST_TEST(results[i].target.theta == 0.5);
+  }
+  BOOST_TEST(s.timeouts() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(timeout) {
+  model::world world{};
+  planner::service s{world, 1};
+
+  const auto requests = makeRequests(1, 3000);
+  const auto& start   = requests.front().start;
+
+  // 期限が過ぎていれば, 一度も計画が終わっていないロボットには初期位置が返る
+  const auto first = s.plan(requests, util::ClockType::now());
+  BOOST_TEST(!first.front().updated);
+  BOOST_TEST(first.front().target.x == start.x);
+  BOOST_TEST(first.front().target.y == start.y);
+  BOOST_TEST(first.front().target.theta == 0.5);
+  BOOST_TEST(s.timeouts() == 1);
+
+  // 間に合わなかった計画は続けられ, 終わればその結果が返るようになる
+  bool planned = false;
+  for (auto i = 0; i < 1000 && !planned; ++i) {
+    std::this_thread::sleep_for(10ms);
+    const auto r = s.plan(requests, util::ClockType::now());
+    planned      = r.front().target.x != start.x;
+  }
+  BOOST_TEST(planned);
+}
+
+// 点pと線分abの距離
+static double segmentDistance(const planner::position& _p, const planner::position& _a,
+                              const planner::position& _b) {
+  const auto dx = _b.x - _a.x;
+  const auto dy = _b.y - _a.y;
+  const auto t  = std::clamp(((_p.x - _a.x) * dx + (_p.y - _a.y) * dy) / (dx * dx + dy * dy),
+                            0.0, 1.0);
+  return std::hypot(_a.x + t * dx - _p.x, _a.y + t * dy - _p.y);
+}
+
+// 最初の計画の後にフィールドの寸法が変わっても, 新しいペナルティエリアを避ける
+BOOST_AUTO_TEST_CASE(field_changed) {
+  model::world world{};
+  model::field field{};
+  field.penaltyLength(300);
+  world.field(field);
+  planner::service s{world, 1};
+
+  planner::service::request r{};
+  r.id        = 0;
+  r.start     = {4500.0, 2500.0, 0.0};
+  r.goal      = {4500.0, -2500.0, 0.0};
+  r.searchNum = 1000;
+
+  // ペナルティエリアが小さければ, 目標位置の近くへ直接向かう
+  const auto before = s.plan({r}, util::ClockType::now() + 10s).front();
+  BOOST_TEST(before.updated);
+  BOOST_TEST(std::hypot(before.target.x - r.goal.x, before.target.y - r.goal.y) < 500.0);
+  const planner::position center{field.xMax(), 0.0, 0.0};
+  BOOST_TEST(segmentDistance(center, r.start, before.target) < 2500.0);
+
+  // ペナルティエリアが大きくなると, 直線上に入るので回り込む
+  field.penaltyLength(2500);
+  world.field(field);
+  const auto after = s.plan({r}, util::ClockType::now() + 10s).front();
+  BOOST_TEST(after.updated);
+  BOOST_TEST(segmentDistance(center, r.start, after.target) > 2500.0);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_id) {
+  model::world world{};
+  planner::service s{world, 1};
+
+  auto requests       = makeRequests(1, 100);
+  requests.front().id = model::world::maxRobots;
+  BOOST_CHECK_THROW(s.plan(requests, util::ClockType::now() + 1s), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
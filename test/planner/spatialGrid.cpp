@@ -0,0 +1,90 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/planner/spatialGrid.hpp"
+
+namespace planner = ai::planner;
+
+BOOST_AUTO_TEST_SUITE(spatial_grid)
+
+BOOST_AUTO_TEST_CASE(empty) {
+  planner::spatialGrid g{0, 0, 100, 100, 10};
+  BOOST_TEST(g.size() == 0);
+  BOOST_TEST(!g.nearest(50, 50));
+
+  std::vector<uint32_t> result;
+  g.within(50, 50, 1000, result);
+  BOOST_TEST(result.empty());
+}
+
+// 全探索と同じ結果になるか (範囲外の点や問い合わせも含める)
+BOOST_AUTO_TEST_CASE(random) {
+  std::mt19937 mt{0};
+  std::uniform_real_distribution<double> pos(-1200, 1200);
+  std::uniform_real_distribution<double> radius(0, 500);
+
+  planner::spatialGrid g{-1000, -1000, 1000, 1000, 150};
+  for (auto trial = 0; trial < 3; ++trial) {
+    g.clear();
+    std::vector<std::pair<double, double>> points;
+    for (auto i = 0u; i < 500; ++i) {
+      points.emplace_back(pos(mt), pos(mt));
+      g.insert(i, points.back().first, points.back().second);
+    }
+    BOOST_TEST(g.size() == 500);
+
+    for (auto q = 0; q < 200; ++q) {
+      const auto x = pos(mt);
+      const auto y = pos(mt);
+      auto dist    = [&](uint32_t _i) {
+        return std::hypot(points[_i].first - x, points[_i].second - y);
+      };
+
+      // 最近傍
+      uint32_t expected = 0;
+      for (auto i = 1u; i < points.size(); ++i) {
+        if (dist(i) < dist(expected)) expected = i;
+      }
+      const auto found = g.nearest(x, y);
+      BOOST_TEST(found.has_value());
+      BOOST_TEST(dist(*found) == dist(expected));
+
+      // 条件付きの最近傍 (番号が3の倍数のものだけ)
+      uint32_t expected3 = 0;
+      for (auto i = 3u; i < points.size(); i += 3) {
+        if (dist(i) < dist(expected3)) expected3 = i;
+      }
+      auto calls        = 0u;
+      const auto found3 = g.nearest(x, y, [&](uint32_t _i, double _d) {
+        ++calls;
+        BOOST_TEST(_d == dist(_i));
+        return _i % 3 == 0;
+      });
+      BOOST_TEST(found3.has_value());
+      BOOST_TEST(dist(*found3) == dist(expected3));
+      // 条件を満たすものが見つかったらそれ以上は調べない
+      BOOST_TEST(calls < points.size());
+
+      // 半径内
+      const auto r = radius(mt);
+      std::vector<uint32_t> within;
+      g.within(x, y, r, within);
+      std::sort(within.begin(), within.end());
+      std::vector<uint32_t> expectedWithin;
+      for (auto i = 0u; i < points.size(); ++i) {
+        if (dist(i) <= r) expectedWithin.push_back(i);
+      }
+      BOOST_TEST(within == expectedWithin, boost::test_tools::per_element());
+    }
+  }
+
+  // 条件を満たすものがなければnullopt
+  BOOST_TEST(!g.nearest(0, 0, [](uint32_t, double) { return false; }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
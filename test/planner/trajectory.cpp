@@ -0,0 +1,125 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <cmath>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/planner/trajectory.hpp"
+
+namespace planner = ai::planner;
+
+BOOST_AUTO_TEST_SUITE(trajectory)
+
+BOOST_AUTO_TEST_CASE(empty) {
+  const planner::trajectory t0{};
+  BOOST_TEST(t0.empty());
+  BOOST_TEST(t0.duration() == 0.0);
+
+  // 経由点が1つなら, その場に止まり続ける
+  const planner::trajectory t1{{{100.0, 200.0, 1.0}}, {2000.0, 4000.0}};
+  BOOST_TEST(t1.empty());
+  const auto s = t1.sample(0.5);
+  BOOST_TEST(s.position_.x == 100.0);
+  BOOST_TEST(s.position_.y == 200.0);
+  BOOST_TEST(s.position_.theta == 1.0);
+  BOOST_TEST(s.velocity_.vx == 0.0);
+}
+
+// 加速・等速・減速の台形になる
+BOOST_AUTO_TEST_CASE(trapezoid, *boost::unit_test::tolerance(1e-9)) {
+  // 0.5秒で2000mm/sまで加速して500mm進み, 1000mmを0.5秒で進んでから0.5秒で止まる
+  const planner::trajectory t{{{0.0, 0.0, 0.0}, {2000.0, 0.0, 0.5}}, {2000.0, 4000.0}};
+  BOOST_TEST(!t.empty());
+  BOOST_TEST(t.length() == 2000.0);
+  BOOST_TEST(t.duration() == 1.5);
+
+  const auto s1 = t.sample(0.25);
+  BOOST_TEST(s1.position_.x == 125.0);
+  BOOST_TEST(s1.velocity_.vx == 1000.0);
+  BOOST_TEST(s1.position_.theta == 0.5);
+  const auto s2 = t.sample(0.75);
+  BOOST_TEST(s2.position_.x == 1000.0);
+  BOOST_TEST(s2.velocity_.vx == 2000.0);
+  const auto s3 = t.sample(1.25);
+  BOOST_TEST(s3.position_.x == 1875.0);
+  BOOST_TEST(s3.velocity_.vx == 1000.0);
+
+  // 範囲外の時刻では始点か終点にいる
+  BOOST_TEST(t.sample(-1.0).position_.x == 0.0);
+  BOOST_TEST(t.sample(10.0).position_.x == 2000.0);
+  BOOST_TEST(t.sample(10.0).velocity_.vx == 0.0);
+}
+
+// 最高速度に達しないほど短ければ三角形になる
+BOOST_AUTO_TEST_CASE(triangle, *boost::unit_test::tolerance(1e-9)) {
+  const planner::trajectory t{{{0.0, 0.0, 0.0}, {0.0, -500.0, 0.0}}, {2000.0, 4000.0}};
+  const auto peak = std::sqrt(4000.0 * 500.0);
+  BOOST_TEST(t.duration() == 2 * peak / 4000.0);
+  BOOST_TEST(t.sample(t.duration() / 2).velocity_.vy == -peak);
+  BOOST_TEST(t.sample(t.duration() / 2).position_.y == -250.0);
+
+  // 初速があれば, その分早く着く
+  const planner::trajectory fast{
+      {{0.0, 0.0, 0.0}, {0.0, -500.0, 0.0}}, {2000.0, 4000.0}, 1000.0};
+  BOOST_TEST(fast.sample(0.0).velocity_.vy == -1000.0);
+  BOOST_TEST(fast.duration() < t.duration());
+}
+
+// 直角に曲がるときは経由点で一度止まり, 速度と加速度の上限を超えない
+BOOST_AUTO_TEST_CASE(corner) {
+  const std::vector<planner::position> path{
+      {0.0, 0.0, 0.0}, {1000.0, 0.0, 0.0}, {1000.0, 0.0, 0.0}, {1000.0, 1000.0, 0.0}};
+  const planner::trajectory t{path, {2000.0, 4000.0}};
+  BOOST_TEST(t.length() == 2000.0);
+
+  // 1000mm進んで止まるのを2回繰り返す
+  const planner::trajectory half{{path[0], path[1]}, {2000.0, 4000.0}};
+  BOOST_TEST(t.duration() == 2 * half.duration(), boost::test_tools::tolerance(1e-9));
+  const auto c = t.sample(half.duration());
+  BOOST_TEST(std::abs(c.position_.x - 1000.0) < 1e-6);
+  BOOST_TEST(std::abs(c.position_.y) < 1e-6);
+  BOOST_TEST(std::hypot(c.velocity_.vx, c.velocity_.vy) < 1e-6);
+
+  const auto dt = 1e-3;
+  auto prev     = t.sample(0.0);
+  for (auto time = dt; time <= t.duration() + dt; time += dt) {
+    const auto s = t.sample(time);
+    const auto v = std::hypot(s.velocity_.vx, s.velocity_.vy);
+    BOOST_TEST(v <= 2000.0 + 1e-6);
+    const auto dvx = s.velocity_.vx - prev.velocity_.vx;
+    const auto dvy = s.velocity_.vy - prev.velocity_.vy;
+    BOOST_TEST(std::hypot(dvx, dvy) <= 4000.0 * dt + 1e-6);
+    const auto dx = s.position_.x - prev.position_.x;
+    const auto dy = s.position_.y - prev.position_.y;
+    BOOST_TEST(std::hypot(dx, dy) <= 2000.0 * dt + 1e-6);
+    prev = s;
+  }
+  BOOST_TEST(prev.position_.x == 1000.0);
+  BOOST_TEST(prev.position_.y == 1000.0);
+}
+
+// 浅い角度で曲がるときは止まらずに通り過ぎる
+BOOST_AUTO_TEST_CASE(shallow_corner) {
+  const std::vector<planner::position> path{
+      {0.0, 0.0, 0.0}, {1000.0, 0.0, 0.0}, {2000.0, 200.0, 0.0}};
+  const planner::trajectory t{path, {2000.0, 4000.0}};
+  const planner::trajectory stop{{path[0], path[1]}, {2000.0, 4000.0}};
+  const planner::trajectory stop2{{path[1], path[2]}, {2000.0, 4000.0}};
+  BOOST_TEST(t.duration() < stop.duration() + stop2.duration());
+}
+
+BOOST_AUTO_TEST_CASE(follow, *boost::unit_test::tolerance(1e-9)) {
+  const planner::trajectory t{{{0.0, 0.0, 0.0}, {2000.0, 0.0, 0.5}}, {2000.0, 4000.0}};
+  // 軌道上にいれば軌道の速度をそのまま返す
+  const auto v1 = t.follow({1000.0, 0.0, 0.5}, 0.75);
+  BOOST_TEST(v1.vx == 2000.0);
+  BOOST_TEST(v1.vy == 0.0);
+  BOOST_TEST(v1.omega == 0.0);
+  // ずれていれば戻る向きの速度を加える
+  const auto v2 = t.follow({900.0, 100.0, 0.0}, 0.75, 2.0);
+  BOOST_TEST(v2.vx == 2200.0);
+  BOOST_TEST(v2.vy == -200.0);
+  BOOST_TEST(v2.omega == 1.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
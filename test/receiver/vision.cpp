@@ -4,6 +4,7 @@
 #include <future>
 #include <string>
 #include <thread>
+#include <vector>
 #include <boost/asio.hpp>
 #include <boost/test/unit_test.hpp>
 
@@ -48,7 +49,7 @@ BOOST_AUTO_TEST_CASE(send_and_receive, *boost::unit_test::timeout(30)) {
   std::this_thread::sleep_for(50ms);
 
   {
-    slotTestingHelper<ssl_protos::vision::WrapperPacket> wrapper{&vision::onReceive, v};
+    slotTestingHelper<vision::PacketType> wrapper{&vision::onReceive, v};
 
     // ダミーパケットを送信
     boost::asio::streambuf buf;
@@ -58,12 +59,13 @@ BOOST_AUTO_TEST_CASE(send_and_receive, *boost::unit_test::timeout(30)) {
 
     // 受信したデータを取得
     const auto f = std::get<0>(wrapper.result());
+    BOOST_REQUIRE(f);
 
     // 受信したデータがダミーパケットと一致するか確認する
-    BOOST_TEST(f.has_detection());
-    BOOST_TEST(!f.has_geometry());
+    BOOST_TEST(f->has_detection());
+    BOOST_TEST(!f->has_geometry());
 
-    const auto& d = f.detection();
+    const auto& d = f->detection();
     BOOST_TEST(d.frame_number() == dummyFrame.frame_number());
     BOOST_TEST(d.t_capture() == dummyFrame.t_capture());
     BOOST_TEST(d.t_sent() == dummyFrame.t_sent());
@@ -108,4 +110,58 @@ BOOST_AUTO_TEST_CASE(non_protobuf_data, *boost::unit_test::timeout(30)) {
   t.join();
 }
 
+BOOST_AUTO_TEST_CASE(batch_receive, *boost::unit_test::timeout(30)) {
+  constexpr auto num = 5u;
+
+  boost::asio::io_service ioService;
+
+  // SSL-Vision受信クラスの初期化 (まとめて受信する)
+  // listen_addr = 0.0.0.0, multicast_addr = 224.5.23.5, port = 10012
+  vision v(ioService, "0.0.0.0", "224.5.23.5", 10012,
+           ai::util::multicast::receiver::receiveMode::batch);
+
+  // 送信クラスの初期化
+  // multicast_addr = 224.5.23.5, port = 10012
+  sender s(ioService, "224.5.23.5", 10012);
+
+  std::vector<uint32_t> frames{};
+  std::promise<void> done{};
+  v.onReceive([&](const vision::PacketType& _p) {
+    frames.push_back(_p->detection().frame_number());
+    if (frames.size() == num) done.set_value();
+  });
+
+  // 受信を開始する前にパケットを送信しておく
+  for (auto i = 0u; i < num; ++i) {
+    ssl_protos::vision::WrapperPacket packet;
+    auto md = packet.mutable_detection();
+    md->set_frame_number(i);
+    md->set_t_capture(0.0);
+    md->set_t_sent(0.0);
+    md->set_camera_id(i);
+    boost::asio::streambuf buf;
+    std::ostream os(&buf);
+    packet.SerializeToOstream(&os);
+    s.send(buf.data());
+  }
+  // バッファに収まらないデータグラムは破棄される
+  s.send(std::string(ai::util::multicast::receiver::bufferSize + 1, 'a'));
+
+  std::thread t([&] { ioService.run(); });
+  done.get_future().wait();
+
+  // 送信した順に全て受信できる
+  BOOST_TEST(frames.size() == num);
+  for (auto i = 0u; i < frames.size(); ++i) BOOST_TEST(frames[i] == i);
+
+  ioService.stop();
+  t.join();
+
+  // 溜まっていたデータグラムは一度にまとめて受信される
+  const auto stats = v.stats();
+  BOOST_TEST(stats.packets == num + 1);
+  BOOST_TEST(stats.maxPacketsPerWakeup > 1);
+  BOOST_TEST(stats.truncated == 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
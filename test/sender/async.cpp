@@ -0,0 +1,165 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/model/command.hpp"
+#include "ai/sender/async.hpp"
+
+namespace model = ai::model;
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_SUITE(async_sender)
+
+// 受け取った命令と送信したスレッドを記録するSender
+struct recordingSender : public ai::sender::base {
+  std::chrono::milliseconds delay{0};
+  bool fail{false};
+
+  std::mutex mutex;
+  std::vector<std::vector<model::command>> sent;
+  std::vector<std::thread::id> threads;
+
+  void sendCommand(const model::command& _command) override {
+    sendCommands({_command});
+  }
+
+  void sendCommands(const std::vector<model::command>& _commands) override {
+    std::this_thread::sleep_for(delay);
+    std::lock_guard<std::mutex> lock(mutex);
+    sent.push_back(_commands);
+    threads.push_back(std::this_thread::get_id());
+    if (fail) throw std::runtime_error{"send failed"};
+  }
+};
+
+// ロボットid0からnum-1への, 速度x成分がvの命令
+static std::vector<model::command> commandsOf(unsigned int _num, double _v) {
+  std::vector<model::command> commands;
+  for (auto id = 0u; id < _num; ++id) {
+    model::command command{id};
+    command.vel({_v, 0.0, 0.0});
+    commands.push_back(command);
+  }
+  return commands;
+}
+
+static double vx(const model::command& _command) {
+  return std::get<model::command::velocity>(_command.setpoint()).vx;
+}
+
+// 送信するスレッドがnum回の送信を終えるまで待つ
+static void waitFor(const ai::sender::async& _sender, uint64_t _num) {
+  while (_sender.statistics().transmissions < _num) std::this_thread::sleep_for(1ms);
+}
+
+// 命令は呼び出し側とは別のスレッドで送信される
+BOOST_AUTO_TEST_CASE(send, *boost::unit_test::timeout(30)) {
+  auto inner = std::make_shared<recordingSender>();
+  {
+    ai::sender::async s{inner};
+    s.sendCommands(commandsOf(3, 1.0));
+    waitFor(s, 1);
+    s.sendCommand(commandsOf(1, 2.0).front());
+    waitFor(s, 2);
+
+    const auto m = s.statistics();
+    BOOST_TEST(m.batches == 2u);
+    BOOST_TEST(m.transmissions == 2u);
+    BOOST_TEST(m.dropped == 0u);
+    BOOST_TEST(m.coalesced == 0u);
+    BOOST_TEST(m.depth == 0u);
+    BOOST_TEST(m.latency.count() == 2u);
+  }
+
+  BOOST_TEST(inner->sent.size() == 2u);
+  BOOST_TEST(inner->sent[0].size() == 3u);
+  BOOST_TEST(inner->sent[1].size() == 1u);
+  BOOST_TEST(vx(inner->sent[1][0]) == 2.0);
+  for (const auto& id : inner->threads) BOOST_TEST((id != std::this_thread::get_id()));
+}
+
+// 送信が遅れて溜まった命令は, ロボットごとに最新のものだけが送られる
+BOOST_AUTO_TEST_CASE(coalesce, *boost::unit_test::timeout(30)) {
+  auto inner   = std::make_shared<recordingSender>();
+  inner->delay = 50ms;
+  ai::sender::async::metrics m{};
+  {
+    ai::sender::async s{inner, 4};
+    // 1周期目を送っている間に, 残りの周期がキューに溜まる
+    s.sendCommands(commandsOf(2, 0.0));
+    std::this_thread::sleep_for(10ms);
+    for (auto i = 1; i <= 3; ++i) {
+      // 2周期目だけはid2への命令も含める
+      s.sendCommands(commandsOf(i == 2 ? 3 : 2, i));
+    }
+
+    // 呼び出し側は送信を待たない
+    const auto start = std::chrono::steady_clock::now();
+    s.sendCommands(commandsOf(2, 4.0));
+    BOOST_TEST((std::chrono::steady_clock::now() - start < 10ms));
+    // 送り終えてからデストラクタを呼ぶ
+    waitFor(s, 2);
+    m = s.statistics();
+  }
+
+  BOOST_TEST(inner->sent.size() == 2u);
+  const auto& last = inner->sent.back();
+  BOOST_TEST(last.size() == 3u);
+  BOOST_TEST(last[0].id() == 0u);
+  BOOST_TEST(vx(last[0]) == 4.0);
+  BOOST_TEST(vx(last[1]) == 4.0);
+  // id2への命令は2周期目にしかない
+  BOOST_TEST(last[2].id() == 2u);
+  BOOST_TEST(vx(last[2]) == 2.0);
+
+  BOOST_TEST(m.batches == 5u);
+  BOOST_TEST(m.transmissions == 2u);
+  BOOST_TEST(m.coalesced == 6u);
+  BOOST_TEST(m.maxDepth == 4u);
+  BOOST_TEST(m.latency.count() == 5u);
+  BOOST_TEST((m.latency.max() >= 50ms));
+}
+
+// キューが一杯なら新しい周期を捨て, デストラクタはキューに残った命令を送ってから戻る
+BOOST_AUTO_TEST_CASE(drop_and_flush, *boost::unit_test::timeout(30)) {
+  auto inner   = std::make_shared<recordingSender>();
+  inner->delay = 50ms;
+  {
+    ai::sender::async s{inner, 2};
+    s.sendCommands(commandsOf(1, 0.0));
+    std::this_thread::sleep_for(10ms);
+    for (auto i = 1; i <= 4; ++i) s.sendCommands(commandsOf(1, i));
+
+    const auto m = s.statistics();
+    BOOST_TEST(m.batches == 5u);
+    BOOST_TEST(m.dropped == 2u);
+    BOOST_TEST(m.depth == 2u);
+  }
+
+  // 捨てなかった最後の周期まで送られている
+  BOOST_TEST(inner->sent.size() == 2u);
+  BOOST_TEST(vx(inner->sent.back()[0]) == 2.0);
+}
+
+// ラップしたSenderの例外は送信するスレッドで数えられ, 呼び出し側には伝わらない
+BOOST_AUTO_TEST_CASE(error, *boost::unit_test::timeout(30)) {
+  auto inner  = std::make_shared<recordingSender>();
+  inner->fail = true;
+  ai::sender::async s{inner};
+  s.sendCommands(commandsOf(2, 1.0));
+  waitFor(s, 1);
+  s.sendCommands(commandsOf(2, 1.0));
+  waitFor(s, 2);
+
+  const auto m = s.statistics();
+  BOOST_TEST(m.errors == 2u);
+  BOOST_TEST(m.transmissions == 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
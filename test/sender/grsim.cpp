@@ -0,0 +1,74 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <array>
+#include <vector>
+#include <boost/asio.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/model/command.hpp"
+#include "ai/sender/grsim.hpp"
+#include "ssl-protos/grSim/packet.pb.h"
+
+namespace model = ai::model;
+using boost::asio::ip::udp;
+
+BOOST_AUTO_TEST_SUITE(grsim_sender)
+
+// 送られたデータグラムを1つ受け取り, パケットとして読む
+static ssl_protos::grsim::Packet receive(udp::socket& _socket) {
+  std::array<char, 4096> buf;
+  const auto size = _socket.receive(boost::asio::buffer(buf));
+  ssl_protos::grsim::Packet packet;
+  BOOST_TEST(packet.ParseFromArray(buf.data(), size));
+  return packet;
+}
+
+// sendCommands()は全てのロボットへの命令を1つのデータグラムで送る
+BOOST_AUTO_TEST_CASE(send_commands, *boost::unit_test::timeout(30)) {
+  boost::asio::io_service ioService;
+  udp::socket socket{ioService, udp::endpoint{boost::asio::ip::address_v4::loopback(), 0}};
+  ai::sender::grsim s{ioService, "127.0.0.1", socket.local_endpoint().port()};
+
+  std::vector<model::command> commands;
+  for (auto id = 0u; id < 11; ++id) {
+    model::command command{id};
+    command.vel({1000.0 * id, -500.0, 0.5});
+    commands.push_back(command);
+  }
+  commands[1].kick({model::command::kickType::Straight, 3.0});
+  commands[2].kick({model::command::kickType::Tip, 4.0});
+  s.sendCommands(commands);
+
+  {
+    const auto packet = receive(socket);
+    BOOST_TEST(socket.available() == 0u);
+    const auto& c = packet.commands();
+    BOOST_TEST(c.robot_commands_size() == 11);
+    for (auto i = 0; i < c.robot_commands_size(); ++i) {
+      BOOST_TEST(c.robot_commands(i).id() == static_cast<uint32_t>(i));
+      BOOST_TEST(c.robot_commands(i).veltangent() == 1.0f * i);
+      BOOST_TEST(c.robot_commands(i).velnormal() == -0.5f);
+    }
+    // キックの種類に応じて, 速度の向きが決まる
+    BOOST_TEST(c.robot_commands(0).kickspeedx() == 0.0f);
+    BOOST_TEST(c.robot_commands(0).kickspeedz() == 0.0f);
+    BOOST_TEST(c.robot_commands(1).kickspeedx() == 3.0f);
+    BOOST_TEST(c.robot_commands(1).kickspeedz() == 0.0f);
+    BOOST_TEST(c.robot_commands(2).kickspeedx() == 0.0f);
+    BOOST_TEST(c.robot_commands(2).kickspeedz() == 4.0f);
+  }
+
+  // パケットを使い回しても, 前に送った命令は残らない
+  s.sendCommand(commands[3]);
+  {
+    const auto packet = receive(socket);
+    BOOST_TEST(packet.commands().robot_commands_size() == 1);
+    BOOST_TEST(packet.commands().robot_commands(0).id() == 3u);
+  }
+
+  commands.erase(commands.begin() + 2, commands.end());
+  s.sendCommands(commands);
+  BOOST_TEST(receive(socket).commands().robot_commands_size() == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,266 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/asio.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "ai/model/command.hpp"
+#include "ai/sender/radio.hpp"
+#include "ai/util/math/crc16.hpp"
+
+namespace model = ai::model;
+using ai::sender::radio;
+using namespace std::chrono_literals;
+
+// 有効な間に行われた動的なメモリ確保の回数
+static std::atomic<bool> countAllocations{false};
+static std::atomic<int> allocations{0};
+
+void* operator new(std::size_t _size) {
+  if (countAllocations) ++allocations;
+  if (auto p = std::malloc(_size == 0 ? 1 : _size)) return p;
+  throw std::bad_alloc{};
+}
+
+// 置き換えたnewとの組み合わせを誤って警告されないよう, deleteはインライン展開させない
+__attribute__((noinline)) void operator delete(void* _p) noexcept {
+  std::free(_p);
+}
+
+__attribute__((noinline)) void operator delete(void* _p, std::size_t) noexcept {
+  std::free(_p);
+}
+
+BOOST_AUTO_TEST_SUITE(radio_sender)
+
+// 無線機の代わりに使う疑似端末
+struct pty {
+  int master;
+  std::string slave;
+
+  pty() : master(::posix_openpt(O_RDWR | O_NOCTTY)) {
+    BOOST_REQUIRE(master >= 0);
+    BOOST_REQUIRE(::grantpt(master) == 0);
+    BOOST_REQUIRE(::unlockpt(master) == 0);
+    slave = ::ptsname(master);
+  }
+
+  ~pty() {
+    ::close(master);
+  }
+
+  // 無線機に届いたデータをsizeバイト読む
+  std::vector<uint8_t> read(std::size_t _size) {
+    std::vector<uint8_t> buf(_size);
+    for (std::size_t n = 0; n < _size;) {
+      const auto r = ::read(master, buf.data() + n, _size - n);
+      BOOST_REQUIRE(r > 0);
+      n += r;
+    }
+    return buf;
+  }
+};
+
+// io_serviceを別のスレッドで動かす
+struct ioThread {
+  boost::asio::io_service ioService;
+  boost::asio::io_service::work work{ioService};
+  std::thread thread{[this] { ioService.run(); }};
+
+  ~ioThread() {
+    stop();
+  }
+
+  void stop() {
+    ioService.stop();
+    if (thread.joinable()) thread.join();
+  }
+};
+
+static int16_t int16At(const std::vector<uint8_t>& _frame, std::size_t _i) {
+  return static_cast<int16_t>(_frame[_i] | (_frame[_i + 1] << 8));
+}
+
+// フレームの大きさとCRCを確かめる
+static void checkFrame(const std::vector<uint8_t>& _frame) {
+  BOOST_TEST(_frame[0] == radio::startByte0);
+  BOOST_TEST(_frame[1] == radio::startByte1);
+  BOOST_TEST(_frame.size() ==
+             radio::headerSize + radio::robotSize * _frame[3] + radio::crcSize);
+  const auto crc = ai::util::math::crc16(_frame.data() + 2, _frame.size() - 4);
+  BOOST_TEST(_frame[_frame.size() - 2] == (crc >> 8));
+  BOOST_TEST(_frame[_frame.size() - 1] == (crc & 0xFF));
+}
+
+// 送信し終えたフレームがnum個になるまで待つ
+static void waitFor(const radio& _radio, uint64_t _num) {
+  while (_radio.statistics().frames < _num) std::this_thread::sleep_for(1ms);
+}
+
+static std::vector<model::command> commandsOf(unsigned int _num) {
+  std::vector<model::command> commands;
+  for (auto id = 0u; id < _num; ++id) {
+    model::command command{id};
+    command.vel({100.0 * id, -250.0, 1.5});
+    commands.push_back(command);
+  }
+  return commands;
+}
+
+// 命令をフレームに変換する
+BOOST_AUTO_TEST_CASE(encode) {
+  std::vector<model::command> commands;
+  {
+    model::command command{3};
+    command.vel({1234.4, -567.6, -2.5});
+    command.kick({model::command::kickType::Straight, 6.5});
+    command.dribble(5);
+    commands.push_back(command);
+  }
+  {
+    model::command command{11};
+    command.pos({-4500.0, 100000.0, 3.0});
+    command.kick({model::command::kickType::Tip, 100.0});
+    commands.push_back(command);
+  }
+
+  radio::FrameType buf;
+  const auto size = radio::encode(commands.data(), commands.data() + 2, 42, buf);
+  const std::vector<uint8_t> frame(buf.begin(), buf.begin() + size);
+  checkFrame(frame);
+  BOOST_TEST(frame[2] == 42);
+  BOOST_TEST(frame[3] == 2);
+
+  // 速度指令
+  BOOST_TEST(frame[4] == 3);
+  BOOST_TEST(frame[5] == 2);
+  BOOST_TEST(int16At(frame, 6) == 1234);
+  BOOST_TEST(int16At(frame, 8) == -568);
+  BOOST_TEST(int16At(frame, 10) == -2500);
+  BOOST_TEST(frame[12] == 65);
+  BOOST_TEST(frame[13] == 5);
+
+  // 位置指令 (範囲外の値は飽和させる)
+  BOOST_TEST(frame[14] == 11);
+  BOOST_TEST(frame[15] == 5);
+  BOOST_TEST(int16At(frame, 16) == -4500);
+  BOOST_TEST(int16At(frame, 18) == 32767);
+  BOOST_TEST(int16At(frame, 20) == 3000);
+  BOOST_TEST(frame[22] == 255);
+  BOOST_TEST(frame[23] == 0);
+
+  // 入りきらないロボットは送らない
+  const auto many = commandsOf(20);
+  BOOST_TEST(radio::encode(many.data(), many.data() + many.size(), 0, buf) ==
+             radio::maxFrameSize);
+  BOOST_TEST(buf[3] == radio::maxRobots);
+}
+
+// 疑似端末を通して, 1周期ごとに1つのフレームが届く
+BOOST_AUTO_TEST_CASE(loopback, *boost::unit_test::timeout(30)) {
+  pty p;
+  ioThread io;
+  radio r{io.ioService, p.slave};
+
+  const auto commands = commandsOf(11);
+  const auto size     = radio::headerSize + radio::robotSize * 11 + radio::crcSize;
+  for (auto i = 0; i < 5; ++i) {
+    r.sendCommands(commands);
+    const auto frame = p.read(size);
+    checkFrame(frame);
+    BOOST_TEST(frame[2] == i);
+    BOOST_TEST(frame[3] == 11);
+    for (auto id = 0u; id < 11; ++id) {
+      const auto offset = radio::headerSize + radio::robotSize * id;
+      BOOST_TEST(frame[offset] == id);
+      BOOST_TEST(int16At(frame, offset + 2) == 100 * id);
+      BOOST_TEST(int16At(frame, offset + 4) == -250);
+      BOOST_TEST(int16At(frame, offset + 6) == 1500);
+    }
+    waitFor(r, i + 1);
+  }
+
+  r.sendCommand(commands[7]);
+  const auto frame = p.read(radio::headerSize + radio::robotSize + radio::crcSize);
+  checkFrame(frame);
+  BOOST_TEST(frame[4] == 7);
+
+  waitFor(r, 6);
+  const auto m = r.statistics();
+  BOOST_TEST(m.errors == 0u);
+  BOOST_TEST(m.skipped == 0u);
+  BOOST_TEST(m.bytes == 5 * size + radio::headerSize + radio::robotSize + radio::crcSize);
+}
+
+// 慣らした後の送信では動的なメモリ確保を行わない
+BOOST_AUTO_TEST_CASE(no_allocation, *boost::unit_test::timeout(30)) {
+  pty p;
+  ioThread io;
+  radio r{io.ioService, p.slave};
+
+  const auto commands = commandsOf(11);
+  const auto size     = radio::headerSize + radio::robotSize * 11 + radio::crcSize;
+  std::vector<uint8_t> buf(size);
+  auto cycle = [&](uint64_t _i) {
+    r.sendCommands(commands);
+    for (std::size_t n = 0; n < size;) n += ::read(p.master, buf.data() + n, size - n);
+    waitFor(r, _i);
+  };
+
+  for (auto i = 1u; i <= 3; ++i) cycle(i);
+  countAllocations = true;
+  for (auto i = 4u; i <= 50; ++i) cycle(i);
+  countAllocations = false;
+  BOOST_TEST(allocations == 0);
+}
+
+// 無線機が受け取れないときは, 溜めずに最新のフレームだけを送る
+BOOST_AUTO_TEST_CASE(skip, *boost::unit_test::timeout(30)) {
+  pty p;
+  ioThread io;
+  radio::metrics m{};
+  {
+    radio r{io.ioService, p.slave};
+    // 疑似端末から読まないので, いずれ書き込めなくなる
+    const auto commands = commandsOf(16);
+    for (auto i = 0; i < 1000; ++i) r.sendCommands(commands);
+    m = r.statistics();
+    // 送信中のフレームは中止して破棄される
+  }
+  BOOST_TEST(m.skipped > 0u);
+  BOOST_TEST(m.frames + m.skipped <= 1000u);
+}
+
+// io_serviceを止めた後に破棄しても, 中止した書き込みのハンドラは破棄したradioに触れない
+BOOST_AUTO_TEST_CASE(destroy_stopped, *boost::unit_test::timeout(30)) {
+  pty p;
+  ioThread io;
+  std::aligned_storage_t<sizeof(radio), alignof(radio)> storage;
+  {
+    auto r = new (&storage) radio{io.ioService, p.slave};
+    // 疑似端末から読まないので, いずれ書き込みが終わらなくなる
+    const auto commands = commandsOf(16);
+    for (auto i = 0; i < 1000; ++i) r->sendCommands(commands);
+    BOOST_TEST(r->statistics().skipped > 0u);
+    io.stop();
+    r->~radio();
+  }
+  // 破棄したradioの領域を壊しておく
+  std::memset(&storage, 0xFF, sizeof(storage));
+
+  // 中止した書き込みのハンドラは残っていて, 呼び出しても問題ない
+  BOOST_TEST(io.ioService.stopped());
+  io.ioService.reset();
+  BOOST_TEST(io.ioService.poll() > 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,70 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/util/histogram.hpp"
+
+using namespace std::chrono_literals;
+using ai::util::histogram;
+
+BOOST_AUTO_TEST_SUITE(latency_histogram)
+
+// 記録がなければ全て0を返す
+BOOST_AUTO_TEST_CASE(empty) {
+  histogram h{};
+  BOOST_TEST(h.count() == 0u);
+  BOOST_TEST(h.min().count() == 0);
+  BOOST_TEST(h.max().count() == 0);
+  BOOST_TEST(h.mean().count() == 0);
+  BOOST_TEST(h.percentile(0.99).count() == 0);
+}
+
+// 最小値, 最大値, 平均値は正確に求まる
+BOOST_AUTO_TEST_CASE(summary) {
+  histogram h{};
+  h.record(3us);
+  h.record(1ms);
+  h.record(5us);
+  h.record(-1ns);
+  BOOST_TEST(h.count() == 4u);
+  BOOST_TEST(h.min().count() == 0);
+  BOOST_TEST(h.max().count() == 1000000);
+  BOOST_TEST(h.mean().count() == 252000);
+
+  h.clear();
+  BOOST_TEST(h.count() == 0u);
+  BOOST_TEST(h.max().count() == 0);
+}
+
+// 小さい値は正確に, 大きい値は12.5%以内の誤差で百分位数が求まる
+BOOST_AUTO_TEST_CASE(percentile) {
+  histogram h{};
+  for (auto i = 0; i < 8; ++i) h.record(std::chrono::nanoseconds{i});
+  BOOST_TEST(h.percentile(0.0).count() == 0);
+  BOOST_TEST(h.percentile(0.5).count() == 3);
+  BOOST_TEST(h.percentile(1.0).count() == 7);
+
+  std::mt19937 mt{0};
+  std::uniform_int_distribution<int64_t> dist(1000, 100000000);
+  std::vector<int64_t> values(10000);
+  h.clear();
+  for (auto& v : values) {
+    v = dist(mt);
+    h.record(std::chrono::nanoseconds{v});
+  }
+  std::sort(values.begin(), values.end());
+  for (auto p : {0.1, 0.5, 0.9, 0.99, 0.999}) {
+    const auto expected = static_cast<double>(values.at(std::ceil(p * values.size()) - 1));
+    const auto actual   = static_cast<double>(h.percentile(p).count());
+    BOOST_TEST(actual >= expected);
+    BOOST_TEST(actual <= expected * 1.125);
+  }
+  BOOST_TEST(h.percentile(1.0).count() == values.back());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
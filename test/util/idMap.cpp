@@ -0,0 +1,101 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/util/idMap.hpp"
+
+using namespace ai;
+
+BOOST_AUTO_TEST_SUITE(id_map)
+
+BOOST_AUTO_TEST_CASE(access) {
+  util::idMap<double, 16> m{};
+
+  BOOST_TEST(m.empty());
+  BOOST_TEST(m.size() == 0);
+  BOOST_TEST(m.capacity() == 16);
+  BOOST_TEST(m.count(0) == 0);
+  BOOST_CHECK_THROW(m.at(0), std::out_of_range);
+
+  // operator[]で要素が追加される
+  m[3] = 1.5;
+  BOOST_TEST(!m.empty());
+  BOOST_TEST(m.size() == 1);
+  BOOST_TEST(m.count(3) == 1);
+  BOOST_TEST(m.at(3) == 1.5);
+
+  // emplaceは既に要素があれば何もしない
+  BOOST_TEST(m.emplace(5, 2.5).second);
+  BOOST_TEST(!m.emplace(5, 3.5).second);
+  BOOST_TEST(m.at(5) == 2.5);
+  BOOST_TEST(m.find(5)->second == 2.5);
+  BOOST_TEST((m.find(6) == m.end()));
+
+  // 範囲外のID
+  BOOST_TEST(m.count(16) == 0);
+  BOOST_TEST(m.count(1000) == 0);
+  BOOST_CHECK_THROW(m.at(16), std::out_of_range);
+  BOOST_CHECK_THROW(m[16], std::out_of_range);
+
+  // 削除
+  BOOST_TEST(m.erase(3) == 1);
+  BOOST_TEST(m.erase(3) == 0);
+  BOOST_TEST(m.size() == 1);
+  BOOST_TEST(m.count(3) == 0);
+
+  // 削除された要素に再度アクセスすると値初期化されている
+  BOOST_TEST(m[3] == 0.0);
+
+  m.clear();
+  BOOST_TEST(m.empty());
+}
+
+BOOST_AUTO_TEST_CASE(iteration) {
+  util::idMap<int, 64> m{{63, 630}, {7, 70}, {0, 0}, {31, 310}, {32, 320}};
+  BOOST_TEST(m.size() == 5);
+
+  // IDの昇順で走査される
+  std::vector<uint32_t> ids{};
+  for (const auto& [id, v] : m) {
+    BOOST_TEST(v == static_cast<int>(id * 10));
+    ids.push_back(id);
+  }
+  BOOST_TEST(ids == (std::vector<uint32_t>{0, 7, 31, 32, 63}), boost::test_tools::per_element());
+
+  // 走査しながら削除できる
+  for (auto it = m.begin(); it != m.end();) {
+    if (it->first % 2) {
+      it = m.erase(it);
+    } else {
+      it->second = -1;
+      ++it;
+    }
+  }
+  BOOST_TEST(m.size() == 2);
+  BOOST_TEST(m.at(0) == -1);
+  BOOST_TEST(m.at(32) == -1);
+
+  // コピーは独立している
+  const auto copy = m;
+  m[1]            = 10;
+  BOOST_TEST(copy.size() == 2);
+  BOOST_TEST(copy.count(1) == 0);
+  BOOST_TEST(m.size() == 3);
+
+  // 代入しても各IDのスロットは変わらない
+  m = copy;
+  BOOST_TEST(m.size() == 2);
+  BOOST_TEST(m.count(1) == 0);
+  BOOST_TEST(m.find(32)->first == 32u);
+  BOOST_TEST(m[5] == 0);
+  BOOST_TEST(m.find(5)->first == 5u);
+
+  // イテレータ経由でIDは書き換えられない
+  static_assert(std::is_const_v<std::remove_reference_t<decltype(m.begin()->first)>>);
+  static_assert(std::is_const_v<std::remove_reference_t<decltype((*m.begin()).first)>>);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
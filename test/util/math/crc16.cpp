@@ -11,4 +11,26 @@ BOOST_AUTO_TEST_CASE(crc16_ibm) {
   BOOST_TEST(crc == 0xFF90);
 }
 
+BOOST_AUTO_TEST_CASE(crc16_pointer) {
+  std::vector<uint8_t> frame{0x55, 0x44, 0x01, 0xA5, 0x5A};
+  BOOST_TEST(ai::util::math::crc16(frame.data(), frame.size()) ==
+             ai::util::math::crc16(frame));
+  BOOST_TEST(ai::util::math::crc16(frame.data(), 2) == 0xFF90);
+}
+
+// 1bitずつ計算した結果と一致する
+BOOST_AUTO_TEST_CASE(crc16_bitwise) {
+  std::vector<uint8_t> frame;
+  for (int i = 0; i < 300; i++) frame.push_back(static_cast<uint8_t>(i * 37 + 11));
+
+  uint16_t expected = 0xFFFF;
+  for (auto buf : frame) {
+    expected ^= (buf << 8);
+    for (int i = 0; i < 8; i++) {
+      expected = (expected & 0x8000) ? (expected << 1) ^ 0x8005 : expected << 1;
+    }
+  }
+  BOOST_TEST(ai::util::math::crc16(frame) == expected);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,52 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/util/pool.hpp"
+
+using ai::util::pool;
+
+BOOST_AUTO_TEST_SUITE(object_pool)
+
+BOOST_AUTO_TEST_CASE(reuse) {
+  pool<std::vector<int>> p{2};
+  BOOST_TEST(p.size() == 2);
+
+  const auto* first = [&p] {
+    auto a = p.acquire();
+    a->assign({1, 2, 3});
+    return a.get();
+  }();
+
+  // 参照が破棄されたオブジェクトは再利用される
+  std::vector<std::shared_ptr<std::vector<int>>> held{};
+  for (auto i = 0; i < 2; ++i) held.push_back(p.acquire());
+  BOOST_TEST(p.size() == 2);
+  BOOST_TEST((held[0].get() == first || held[1].get() == first));
+  BOOST_TEST(held[0].get() != held[1].get());
+
+  // 再利用されたオブジェクトは前回の状態を保持している
+  const auto& reused = held[0].get() == first ? held[0] : held[1];
+  BOOST_TEST(reused->size() == 3);
+}
+
+BOOST_AUTO_TEST_CASE(grow) {
+  pool<int> p{1};
+
+  // 全てのオブジェクトが使われているときはプールが拡張される
+  auto a = p.acquire();
+  auto b = p.acquire();
+  BOOST_TEST(p.size() == 2);
+  BOOST_TEST(a.get() != b.get());
+
+  // 他のスレッドで参照が破棄されたものも再利用される
+  std::thread t([c = std::move(b)]() mutable { c.reset(); });
+  t.join();
+  auto d = p.acquire();
+  BOOST_TEST(p.size() == 2);
+  BOOST_TEST(d.get() != a.get());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
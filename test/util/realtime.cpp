@@ -0,0 +1,36 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <system_error>
+#include <thread>
+#include <pthread.h>
+#include <sched.h>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/util/realtime.hpp"
+
+namespace util = ai::util;
+
+BOOST_AUTO_TEST_SUITE(realtime_scheduling)
+
+// 指定したCPUだけで動くようになる
+BOOST_AUTO_TEST_CASE(cpu_affinity) {
+  std::thread t{[] {
+    BOOST_CHECK_NO_THROW(util::cpuAffinity(0));
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+    BOOST_TEST(CPU_COUNT(&set) == 1);
+    BOOST_TEST(CPU_ISSET(0, &set));
+  }};
+  t.join();
+
+  BOOST_CHECK_THROW(util::cpuAffinity(-1), std::system_error);
+}
+
+// SCHED_FIFOで使えない優先度は変更できない
+BOOST_AUTO_TEST_CASE(realtime_priority) {
+  BOOST_CHECK_THROW(util::realtimePriority(0), std::system_error);
+  BOOST_CHECK_THROW(util::realtimePriority(100), std::system_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
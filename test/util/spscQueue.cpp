@@ -0,0 +1,88 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <set>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/util/spscQueue.hpp"
+
+using ai::util::spscQueue;
+
+BOOST_AUTO_TEST_SUITE(spsc_queue)
+
+BOOST_AUTO_TEST_CASE(fifo) {
+  spscQueue<int> q{3};
+  BOOST_TEST(q.capacity() == 3u);
+  BOOST_TEST(q.empty());
+
+  int v = 0;
+  BOOST_TEST(!q.tryPop(v));
+
+  // 容量まで入れると, それ以上は入らない
+  BOOST_TEST(q.tryPush(1));
+  BOOST_TEST(q.tryPush(2));
+  BOOST_TEST(q.tryPush(3));
+  BOOST_TEST(!q.tryPush(4));
+  BOOST_TEST(q.size() == 3u);
+
+  // 入れた順に取り出せる
+  BOOST_TEST(q.tryPop(v));
+  BOOST_TEST(v == 1);
+  BOOST_TEST(q.tryPush(5));
+  for (auto expected : {2, 3, 5}) {
+    BOOST_TEST(q.tryPop(v));
+    BOOST_TEST(v == expected);
+  }
+  BOOST_TEST(q.empty());
+  BOOST_TEST(q.size() == 0u);
+}
+
+// 取り出しではswapするので, 要素の確保した領域は使い回される
+BOOST_AUTO_TEST_CASE(reuse) {
+  spscQueue<std::vector<int>> q{1};
+  const std::vector<int> in(100, 1);
+  std::vector<int> out{};
+
+  // キューの領域と取り出し先を合わせた数の領域だけが行き来する
+  std::set<const int*> buffers{};
+  for (auto i = 0; i < 10; ++i) {
+    BOOST_TEST(q.tryPush(in));
+    BOOST_TEST(q.tryPop(out));
+    BOOST_TEST(out.size() == 100u);
+    buffers.insert(out.data());
+  }
+  BOOST_TEST(buffers.size() <= 3u);
+}
+
+// 別々のスレッドから追加と取り出しをしても, 全ての要素が順番通りに届く
+BOOST_AUTO_TEST_CASE(threads, *boost::unit_test::timeout(30)) {
+  constexpr int num = 100000;
+  spscQueue<int> q{16};
+
+  std::thread producer{[&q] {
+    for (auto i = 0; i < num;) {
+      if (q.tryPush(i)) {
+        ++i;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }};
+
+  auto ok = true;
+  for (auto expected = 0; expected < num;) {
+    int v = -1;
+    if (q.tryPop(v)) {
+      ok = ok && v == expected;
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  BOOST_TEST(ok);
+  BOOST_TEST(q.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
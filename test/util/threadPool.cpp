@@ -0,0 +1,45 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/util/threadPool.hpp"
+
+using ai::util::threadPool;
+
+BOOST_AUTO_TEST_SUITE(thread_pool)
+
+BOOST_AUTO_TEST_CASE(size) {
+  BOOST_TEST(threadPool{3}.size() == 3);
+  // 0を指定しても1つはワーカーが作られる
+  BOOST_TEST(threadPool{0}.size() == 1);
+}
+
+// 追加した処理は全て, 呼び出し元とは別のスレッドで実行される
+BOOST_AUTO_TEST_CASE(run_all) {
+  std::atomic<int> count{0};
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  {
+    threadPool pool{4};
+    for (auto i = 0; i < 1000; ++i) {
+      pool.post([&] {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          threads.insert(std::this_thread::get_id());
+        }
+        ++count;
+      });
+    }
+    // デストラクタは残っている処理が終わるまで待つ
+  }
+  BOOST_TEST(count == 1000);
+  BOOST_TEST(threads.size() >= 1u);
+  BOOST_TEST(threads.size() <= 4u);
+  BOOST_TEST(threads.count(std::this_thread::get_id()) == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,53 @@
+#define BOOST_TEST_DYN_LINK
+
+#include <array>
+#include <boost/test/unit_test.hpp>
+
+#include "ai/util/xoshiro.hpp"
+
+using ai::util::xoshiro;
+
+BOOST_AUTO_TEST_SUITE(xoshiro_generator)
+
+// 参照実装と同じ系列になるか
+BOOST_AUTO_TEST_CASE(reference) {
+  xoshiro x{std::array<uint64_t, 4>{1, 2, 3, 4}};
+  BOOST_TEST(x() == 11520u);
+  BOOST_TEST(x() == 0u);
+  BOOST_TEST(x() == 1509978240u);
+  BOOST_TEST(x() == 1215971899390074240u);
+  BOOST_TEST(x() == 1216172134540287360u);
+  BOOST_TEST(x() == 607988272756665600u);
+}
+
+BOOST_AUTO_TEST_CASE(seed) {
+  xoshiro a{42};
+  xoshiro b{42};
+  xoshiro c{43};
+  bool differ = false;
+  for (auto i = 0; i < 100; ++i) {
+    const auto v = a();
+    BOOST_TEST(v == b());
+    differ |= v != c();
+  }
+  BOOST_TEST(differ);
+
+  // シードを設定し直すと最初から同じ系列になる
+  a.seed(42);
+  b.seed(42);
+  for (auto i = 0; i < 100; ++i) BOOST_TEST(a() == b());
+}
+
+BOOST_AUTO_TEST_CASE(uniform) {
+  xoshiro x{0};
+  double sum = 0;
+  for (auto i = 0; i < 100000; ++i) {
+    const auto v = x.uniform(-2.0, 3.0);
+    BOOST_TEST(v >= -2.0);
+    BOOST_TEST(v < 3.0);
+    sum += v;
+  }
+  BOOST_TEST(sum / 100000 == 0.5, boost::test_tools::tolerance(0.02));
+}
+
+BOOST_AUTO_TEST_SUITE_END()